@@ -72,6 +72,7 @@ tests = [
     ("Ice/invoke", ["core"]),
     ("Ice/plugin", ["core", "nomingw"]),
     ("Ice/hash", ["once"]),
+    ("Ice/internTable", ["once"]),
     ("Ice/admin", ["core", "noipv6"]),
     ("Ice/metrics", ["core", "nossl", "nows", "noipv6", "nocompress", "nomingw", "nosocks"]),
     ("Ice/enums", ["once"]),
@@ -82,6 +83,7 @@ tests = [
     ("IceBox/configuration", ["core", "noipv6", "novc100", "nomingw", "nomx"]),
     ("IceBox/admin", ["core", "noipv6", "novc100", "nomingw", "nomx"]),
     ("Freeze/dbmap", ["once", "novc100", "nomingw"]),
+    ("Freeze/bulk", ["once", "novc100", "nomingw"]),
     ("Freeze/complex", ["once", "novc100", "nomingw"]),
     ("Freeze/evictor", ["once", "novc100", "nomingw"]),
     ("Freeze/fileLock", ["once", "novc100", "nomingw"]),
@@ -89,6 +89,19 @@ private:
 };
 typedef IceUtil::Handle<MapIndexBase> MapIndexBasePtr;
 
+//
+// Receives the records read by MapHelper::scan. When the scan uses
+// several threads, record is called concurrently from these threads.
+//
+class FREEZE_API ScanCallbackBase
+{
+public:
+
+    virtual ~ScanCallbackBase();
+
+    virtual void record(const Key&, const Value&) = 0;
+};
+
 class FREEZE_API MapHelper
 {
 public:
@@ -162,6 +175,9 @@ public:
 
     virtual ConnectionPtr
     getConnection() const = 0;
+
+    virtual void
+    scan(ScanCallbackBase&, int) const = 0;
 };
 
 class FREEZE_API IteratorHelper
@@ -916,6 +932,39 @@ public:
     }
 };
 
+//
+// Decodes the records read by Map::scan and hands them to the
+// user-supplied callback.
+//
+template<typename key_type, typename mapped_type, typename KeyCodec, typename ValueCodec, typename Callback>
+class MapScanCallback : public ScanCallbackBase
+{
+public:
+
+    MapScanCallback(Callback& callback, const Ice::CommunicatorPtr& communicator,
+                    const Ice::EncodingVersion& encoding) :
+        _callback(callback),
+        _communicator(communicator),
+        _encoding(encoding)
+    {
+    }
+
+    virtual void record(const Key& k, const Value& v)
+    {
+        key_type key;
+        mapped_type value;
+        KeyCodec::read(key, k, _communicator, _encoding);
+        ValueCodec::read(value, v, _communicator, _encoding);
+        _callback(key, value);
+    }
+
+private:
+
+    Callback& _callback;
+    const Ice::CommunicatorPtr _communicator;
+    const Ice::EncodingVersion _encoding;
+};
+
 //
 // A sorted map, similar to a std::map, with one notable difference:
 // operator[] is not provided.
@@ -1235,6 +1284,20 @@ public:
         _helper->closeDb();
     }
 
+    //
+    // scan is not a standard function. It reads the entire database
+    // with bulk retrievals and calls callback(key, value) for each
+    // record. With threads > 1, the records are decoded and passed to
+    // the callback by that many threads, in no particular order, and
+    // the callback must be thread-safe. The first exception raised by
+    // the callback stops the scan and is rethrown by scan.
+    //
+    template<typename Callback> void scan(Callback& callback, int threads = 1) const
+    {
+        MapScanCallback<key_type, mapped_type, KeyCodec, ValueCodec, Callback> cb(callback, _communicator, _encoding);
+        _helper->scan(cb, threads);
+    }
+
     iterator find(const key_type& key)
     {
         KeyCodec k(key, _communicator, _encoding);
@@ -79,6 +79,10 @@ public:
     {
         _is.readEncaps(encaps, sz);
     }
+    ::IceInternal::BasicStream* __getIs()
+    {
+        return &_is;
+    }
     void __throwUserException();
 
     bool __wait();
@@ -917,7 +917,8 @@ private:
     protected:
 
         EncapsDecoder(BasicStream* stream, ReadEncaps* encaps, bool sliceObjects, const ObjectFactoryManagerPtr& f) :
-            _stream(stream), _encaps(encaps), _sliceObjects(sliceObjects), _servantFactoryManager(f), _typeIdIndex(0)
+            _stream(stream), _encaps(encaps), _sliceObjects(sliceObjects), _servantFactoryManager(f), _patchCount(0),
+            _unmarshalDepth(0)
         {
         }
 
@@ -927,8 +928,71 @@ private:
         void addPatchEntry(Ice::Int, PatchFunc, void*);
         void unmarshal(Ice::Int, const Ice::ObjectPtr&);
 
-        typedef std::map<Ice::Int, Ice::ObjectPtr> IndexToPtrMap;
-        typedef std::map<Ice::Int, std::string> TypeIdReadMap;
+        //
+        // Instance indexes are allocated sequentially by the encoder.
+        // The entries of an index table are stored in a vector indexed
+        // by index - 1, as long as the vector size stays proportional
+        // to the number of entries. The entries of larger indexes,
+        // which are only sent by a malformed or malicious peer, are
+        // stored in a map.
+        //
+        template<typename T> class IndexTable
+        {
+        public:
+
+            IndexTable() : _count(0)
+            {
+            }
+
+            //
+            // Returns the entry of the given index or 0 if there's
+            // none. The returned entry might be a default value.
+            //
+            T* find(Ice::Int index)
+            {
+                const size_t i = static_cast<size_t>(index - 1);
+                if(i < _dense.size())
+                {
+                    return &_dense[i];
+                }
+                typename std::map<Ice::Int, T>::iterator p = _sparse.find(index);
+                return p != _sparse.end() ? &p->second : 0;
+            }
+
+            //
+            // Returns the entry of the given index, the entry is
+            // created if there's none.
+            //
+            T& operator[](Ice::Int index)
+            {
+                T* v = find(index);
+                if(v)
+                {
+                    return *v;
+                }
+
+                ++_count;
+                const size_t i = static_cast<size_t>(index - 1);
+                if(i > 2 * _count + 16)
+                {
+                    return _sparse[index];
+                }
+
+                _dense.resize(i + 1);
+                while(!_sparse.empty() && static_cast<size_t>(_sparse.begin()->first) <= _dense.size())
+                {
+                    std::swap(_dense[_sparse.begin()->first - 1], _sparse.begin()->second);
+                    _sparse.erase(_sparse.begin());
+                }
+                return _dense[i];
+            }
+
+        private:
+
+            std::vector<T> _dense;
+            std::map<Ice::Int, T> _sparse;
+            size_t _count;
+        };
 
         struct PatchEntry
         {
@@ -936,7 +1000,14 @@ private:
             void* patchAddr;
         };
         typedef std::vector<PatchEntry> PatchList;
-        typedef std::map<Ice::Int, PatchList> PatchMap;
+        typedef IndexTable<PatchList> PatchMap;
+        typedef IndexTable<Ice::ObjectPtr> IndexToPtrMap;
+
+        //
+        // Type ID indexes are allocated sequentially by the decoder
+        // when reading a new type ID, the table is indexed by index - 1.
+        //
+        typedef std::vector<std::string> TypeIdReadMap;
 
         BasicStream* _stream;
         ReadEncaps* _encaps;
@@ -945,14 +1016,17 @@ private:
 
         // Encapsulation attributes for object un-marshalling
         PatchMap _patchMap;
+        size_t _patchCount; // The number of indexes with pending patch entries.
 
     private:
 
+        void checkIndex(Ice::Int) const;
+
         // Encapsulation attributes for object un-marshalling
         IndexToPtrMap _unmarshaledMap;
         TypeIdReadMap _typeIdMap;
-        Ice::Int _typeIdIndex;
         ObjectList _objectList;
+        int _unmarshalDepth;
     };
 
     class ICE_API EncapsDecoder10 : public EncapsDecoder
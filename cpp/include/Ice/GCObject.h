@@ -15,6 +15,8 @@
 #include <IceUtil/MutexPtrLock.h>
 #include <IceUtil/Mutex.h>
 
+#include <vector>
+
 namespace IceInternal
 {
 
@@ -52,6 +54,11 @@ public:
     virtual bool __gcVisit(GCVisitor&);
     virtual void ice_collectable(bool);
 
+    //
+    // Mark a graph of newly un-marshalled objects as collectable.
+    //
+    static void __gcMarkCollectable(const std::vector<Ice::ObjectPtr>&);
+
     //
     // This method is implemented by Slice classes to visit class
     // members.
@@ -36,6 +36,7 @@ public:
     void __endWriteParams(bool);
     void __writeEmptyParams();
     void __writeParamEncaps(const Ice::Byte*, Ice::Int, bool);
+    void __adoptParamEncaps(BasicStream&, const Ice::Byte*, Ice::Int, bool);
     void __writeUserException(const Ice::UserException&, Ice::FormatType);
 
 protected:
@@ -118,6 +119,16 @@ public:
         _current.encoding = _is->readEncaps(v, sz);
     }
 
+    //
+    // Exchange the request message with the given buffer, this allows
+    // to forward the parameter encapsulation without copying it. This
+    // is only possible for a single request message received from a
+    // connection (not for collocated or batch requests), once the
+    // encapsulation, which must end the message, was read and if the
+    // request can't be started over.
+    //
+    bool swapRequest(Buffer&);
+
 private:
 
     BasicStream* _is;
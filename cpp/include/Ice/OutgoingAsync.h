@@ -169,6 +169,7 @@ public:
             _os.writeEncaps(encaps, size);
         }
     }
+    void adoptParamEncaps(Buffer&, const ::Ice::Byte*, ::Ice::Int);
 
     virtual BasicStream* getIs()
     {
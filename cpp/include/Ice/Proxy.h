@@ -698,6 +698,13 @@ public:
         return begin_ice_invoke(operation, mode, inParams, &__ctx, __del, __cookie);
     }
 
+    ::Ice::AsyncResultPtr ___begin_ice_invoke(const ::std::string&,
+                                              ::Ice::OperationMode,
+                                              const ::std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&,
+                                              ::IceInternal::Buffer&,
+                                              const ::Ice::Context*,
+                                              const ::IceInternal::CallbackBasePtr&,
+                                              const ::Ice::LocalObjectPtr&);
     bool ___end_ice_invoke(::std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&, const ::Ice::AsyncResultPtr&);
 
     ::Ice::Identity ice_getIdentity() const;
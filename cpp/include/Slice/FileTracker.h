@@ -11,6 +11,7 @@
 #define FILE_TRACKER_H
 
 #include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
 #include <Slice/Parser.h>
 
 namespace Slice
@@ -38,7 +39,7 @@ private:
 class FileTracker;
 typedef IceUtil::Handle<FileTracker> FileTrackerPtr;
 
-class SLICE_API FileTracker : public ::IceUtil::SimpleShared
+class SLICE_API FileTracker : public ::IceUtil::SimpleShared, public ::IceUtil::Mutex
 {
 public:
 
@@ -17,6 +17,8 @@
 
 #include <IceUtil/Mutex.h>
 #include <IceUtil/MutexPtrLock.h>
+#include <IceUtil/UniquePtr.h>
+#include <Ice/HashUtil.h>
 
 #include <typeinfo>
 
@@ -91,8 +93,211 @@ private:
     BackgroundSaveEvictorI& _evictor;
 };
 
+size_t
+identityHash(const Identity& ident)
+{
+    Int h = 5381;
+    IceInternal::hashAdd(h, ident.name);
+    IceInternal::hashAdd(h, ident.category);
+    return static_cast<size_t>(static_cast<unsigned int>(h));
+}
+
 }
 
+//
+// Streams a partition of a save round on behalf of the saving thread
+//
+class Freeze::BackgroundSaveEvictorI::StreamThread : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    StreamThread(BackgroundSaveEvictorI& evictor) :
+        IceUtil::Thread("Freeze background save evictor stream thread"),
+        _evictor(evictor),
+        _elements(0),
+        _streamStart(0),
+        _destroyed(false)
+    {
+    }
+
+    void stream(const deque<BackgroundSaveEvictorElementPtr>& elements, Long streamStart)
+    {
+        Lock sync(*this);
+        assert(_elements == 0);
+        _elements = &elements;
+        _streamStart = streamStart;
+        notifyAll();
+    }
+
+    void waitForCompletion(deque<StreamedObjectPtr>& streamedObjects, deque<BackgroundSaveEvictorElementPtr>& deadObjects)
+    {
+        Lock sync(*this);
+        while(_elements != 0)
+        {
+            wait();
+        }
+
+        streamedObjects.insert(streamedObjects.end(), _streamedObjects.begin(), _streamedObjects.end());
+        _streamedObjects.clear();
+        deadObjects.insert(deadObjects.end(), _deadObjects.begin(), _deadObjects.end());
+        _deadObjects.clear();
+
+        if(_exception.get() != 0)
+        {
+            IceUtil::UniquePtr<IceUtil::Exception> ex(_exception.release());
+            ex->ice_throw();
+        }
+    }
+
+    void destroy()
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+    }
+
+    virtual void run()
+    {
+        for(;;)
+        {
+            const deque<BackgroundSaveEvictorElementPtr>* elements;
+            Long streamStart;
+            {
+                Lock sync(*this);
+                while(_elements == 0 && !_destroyed)
+                {
+                    wait();
+                }
+
+                if(_elements == 0)
+                {
+                    return;
+                }
+                elements = _elements;
+                streamStart = _streamStart;
+            }
+
+            deque<StreamedObjectPtr> streamedObjects;
+            deque<BackgroundSaveEvictorElementPtr> deadObjects;
+            IceUtil::Exception* ex = 0;
+            try
+            {
+                _evictor.streamObjects(*elements, streamStart, streamedObjects, deadObjects);
+            }
+            catch(const IceUtil::Exception& e)
+            {
+                ex = e.ice_clone();
+            }
+            catch(const std::exception& e)
+            {
+                ex = new DatabaseException(__FILE__, __LINE__, e.what());
+            }
+            catch(...)
+            {
+                ex = new DatabaseException(__FILE__, __LINE__, "unknown exception");
+            }
+
+            Lock sync(*this);
+            _streamedObjects.swap(streamedObjects);
+            _deadObjects.swap(deadObjects);
+            _exception.reset(ex);
+            _elements = 0;
+            notifyAll();
+        }
+    }
+
+private:
+
+    BackgroundSaveEvictorI& _evictor;
+    const deque<BackgroundSaveEvictorElementPtr>* _elements;
+    Long _streamStart;
+    bool _destroyed;
+    deque<StreamedObjectPtr> _streamedObjects;
+    deque<BackgroundSaveEvictorElementPtr> _deadObjects;
+    IceUtil::UniquePtr<IceUtil::Exception> _exception;
+};
+
+//
+// Writes the streamed objects of its partition of each save round,
+// in round order
+//
+class Freeze::BackgroundSaveEvictorI::SaveThread : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SaveThread(BackgroundSaveEvictorI& evictor) :
+        IceUtil::Thread("Freeze background save evictor save thread"),
+        _evictor(evictor),
+        _destroyed(false)
+    {
+    }
+
+    void queue(const SaveRoundPtr& round, deque<StreamedObjectPtr>& streamedObjects)
+    {
+        Lock sync(*this);
+        _queue.push_back(make_pair(round, deque<StreamedObjectPtr>()));
+        _queue.back().second.swap(streamedObjects);
+        notifyAll();
+    }
+
+    void destroy()
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+    }
+
+    virtual void run()
+    {
+        try
+        {
+            for(;;)
+            {
+                SaveRoundPtr round;
+                deque<StreamedObjectPtr> streamedObjects;
+                {
+                    Lock sync(*this);
+                    while(_queue.empty() && !_destroyed)
+                    {
+                        wait();
+                    }
+
+                    if(_queue.empty())
+                    {
+                        return;
+                    }
+                    round = _queue.front().first;
+                    streamedObjects.swap(_queue.front().second);
+                    _queue.pop_front();
+                }
+
+                _evictor.saveObjects(streamedObjects);
+                _evictor.saved(round);
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            Error out(_evictor.communicator()->getLogger());
+            out << "Save thread killed by exception: " << ex;
+            out.flush();
+            handleFatalError(&_evictor, _evictor.communicator());
+        }
+        catch(...)
+        {
+            Error out(_evictor.communicator()->getLogger());
+            out << "Save thread killed by unknown exception";
+            out.flush();
+            handleFatalError(&_evictor, _evictor.communicator());
+        }
+    }
+
+private:
+
+    BackgroundSaveEvictorI& _evictor;
+    bool _destroyed;
+    deque<pair<SaveRoundPtr, deque<StreamedObjectPtr> > > _queue;
+};
+
 //
 // createEvictor functions
 // 
@@ -143,7 +348,9 @@ Freeze::BackgroundSaveEvictorI::BackgroundSaveEvictorI(const ObjectAdapterPtr& a
     EvictorI<BackgroundSaveEvictorElement>(adapter, envName, dbEnv, filename, FacetTypeMap(), initializer, indices, createDb),
     IceUtil::Thread("Freeze background save evictor thread"),
     _currentEvictorSize(0),
-    _savingThreadDone(false)
+    _groupCommit(false),
+    _savingThreadDone(false),
+    _claimedSaveNowThreads(0)
 {
     string propertyPrefix = string("Freeze.Evictor.") + envName + '.' + _filename; 
     
@@ -182,6 +389,57 @@ Freeze::BackgroundSaveEvictorI::BackgroundSaveEvictorI(const ObjectAdapterPtr& a
         _timer = IceInternal::getInstanceTimer(_communicator);
     }
 
+    //
+    // By default, the saving thread streams and saves all the objects
+    //
+    Int streamThreads = _communicator->getProperties()->
+        getPropertyAsIntWithDefault(propertyPrefix + ".StreamThreads", 1);
+    Int saveThreads = _communicator->getProperties()->
+        getPropertyAsIntWithDefault(propertyPrefix + ".SaveThreads", 0);
+
+    //
+    // Unless the environment doesn't flush the log on commit, the save
+    // transactions of a round are committed without flushing the log,
+    // and the log is flushed once for the round.
+    //
+    u_int32_t envFlags = 0;
+    try
+    {
+        _dbEnv->getEnv()->get_flags(&envFlags);
+    }
+    catch(const DbException& dx)
+    {
+        DatabaseException ex(__FILE__, __LINE__);
+        ex.message = dx.what();
+        throw ex;
+    }
+    _groupCommit = (envFlags & (DB_TXN_NOSYNC | DB_TXN_WRITE_NOSYNC)) == 0;
+
+    if(_trace >= 1)
+    {
+        Trace out(_communicator->getLogger(), "Freeze.Evictor");
+        out << "saving \"" << _filename << "\" with " << (streamThreads > 1 ? streamThreads : 1)
+            << " stream thread(s) and " << (saveThreads > 0 ? saveThreads : 0) << " save thread(s)";
+        if(_groupCommit)
+        {
+            out << "; using group commit";
+        }
+    }
+
+    for(Int i = 1; i < streamThreads; ++i)
+    {
+        StreamThreadPtr thread = new StreamThread(*this);
+        thread->start();
+        _streamThreads.push_back(thread);
+    }
+
+    for(Int i = 0; i < saveThreads; ++i)
+    {
+        SaveThreadPtr thread = new SaveThread(*this);
+        thread->start();
+        _saveThreads.push_back(thread);
+    }
+
     //
     // Start saving thread
     //
@@ -837,16 +1095,13 @@ Freeze::BackgroundSaveEvictorI::run()
     {
         for(;;)
         {
-            deque<BackgroundSaveEvictorElementPtr> allObjects;
-            deque<BackgroundSaveEvictorElementPtr> deadObjects;
+            SaveRoundPtr round = new SaveRound;
 
-            size_t saveNowThreadsSize = 0;
-            
             {
                 Lock sync(*this);
 
                 while(!_savingThreadDone &&
-                      (_saveNowThreads.size() == 0) &&
+                      (_saveNowThreads.size() == _claimedSaveNowThreads) &&
                       (_saveSizeTrigger < 0 || static_cast<Int>(_modifiedQueue.size()) < _saveSizeTrigger))
                 {
                     if(_savePeriod == IceUtil::Time::milliSeconds(0))
@@ -861,78 +1116,304 @@ Freeze::BackgroundSaveEvictorI::run()
                         break; // while
                     }                           
                 }
-                
-                saveNowThreadsSize = _saveNowThreads.size();
-                
+
                 if(_savingThreadDone)
                 {
                     assert(_modifiedQueue.size() == 0);
-                    assert(saveNowThreadsSize == 0);
+                    assert(_saveNowThreads.size() == 0);
+                    assert(_saveRounds.size() == 0);
                     break; // for(;;)
                 }
-                
+
                 //
                 // Check first if there is something to do!
                 //
-                if(_modifiedQueue.size() == 0)
+                if(_modifiedQueue.size() == 0 && _saveNowThreads.size() == _claimedSaveNowThreads)
                 {
-                    if(saveNowThreadsSize > 0)
-                    {
-                        _saveNowThreads.clear();
-                        notifyAll();
-                    }
                     continue; // for(;;)
                 }
-                
-                _modifiedQueue.swap(allObjects);
+
+                //
+                // Don't stream more than one round ahead of the save threads
+                //
+                while(_saveRounds.size() > 1)
+                {
+                    wait();
+                }
+
+                round->saveNowThreads = _saveNowThreads.size() - _claimedSaveNowThreads;
+                _claimedSaveNowThreads = _saveNowThreads.size();
+                round->firstModified = _firstModified;
+                _modifiedQueue.swap(round->allObjects);
+                _saveRounds.push_back(round);
             }
-            
-            const size_t size = allObjects.size();
-            
-            deque<StreamedObjectPtr> streamedObjectQueue;
-            
+
+            deque<StreamedObjectPtr> streamedObjects;
+
             Long streamStart = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
+
+            streamRound(round, streamStart, streamedObjects);
+            round->streamed = streamedObjects.size();
+
+            if(_trace >= 1 && !round->allObjects.empty())
+            {
+                Long now = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
+                Trace out(_communicator->getLogger(), "Freeze.Evictor");
+                out << "streamed " << streamedObjects.size() << " objects in " 
+                    << static_cast<Int>(now - streamStart) << " ms";
+            }
+
+            if(_saveThreads.empty() || streamedObjects.empty())
+            {
+                round->pending = 1;
+                saveObjects(streamedObjects);
+                saved(round);
+            }
+            else
+            {
+                //
+                // Partition the objects by identity, so that the successive
+                // saves of an object are written in order by the same thread
+                //
+                vector<deque<StreamedObjectPtr> > partitions(_saveThreads.size());
+                for(deque<StreamedObjectPtr>::const_iterator p = streamedObjects.begin(); p != streamedObjects.end(); ++p)
+                {
+                    partitions[(*p)->hash % partitions.size()].push_back(*p);
+                }
+                streamedObjects.clear();
+
+                round->pending = static_cast<int>(_saveThreads.size());
+                for(size_t i = 0; i < _saveThreads.size(); ++i)
+                {
+                    _saveThreads[i]->queue(round, partitions[i]);
+                }
+            }
+        }
+
+        for(vector<SaveThreadPtr>::const_iterator p = _saveThreads.begin(); p != _saveThreads.end(); ++p)
+        {
+            (*p)->destroy();
+            (*p)->getThreadControl().join();
+        }
+        for(vector<StreamThreadPtr>::const_iterator p = _streamThreads.begin(); p != _streamThreads.end(); ++p)
+        {
+            (*p)->destroy();
+            (*p)->getThreadControl().join();
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        Error out(_communicator->getLogger());
+        out << "Saving thread killed by exception: " << ex;
+        out.flush();
+        handleFatalError(this, _communicator);
+    }
+    catch(...)
+    {
+        Error out(_communicator->getLogger());
+        out << "Saving thread killed by unknown exception";
+        out.flush();
+        handleFatalError(this, _communicator);
+    }
+}
+
+void
+Freeze::BackgroundSaveEvictorI::streamRound(const SaveRoundPtr& round, Long streamStart,
+                                            deque<StreamedObjectPtr>& streamedObjects)
+{
+    if(_streamThreads.empty())
+    {
+        streamObjects(round->allObjects, streamStart, streamedObjects, round->deadObjects);
+        return;
+    }
+
+    //
+    // Partition the objects by identity, so that the duplicates of an
+    // element are streamed in order by the same thread. This thread
+    // streams the first partition.
+    //
+    vector<deque<BackgroundSaveEvictorElementPtr> > partitions(_streamThreads.size() + 1);
+    for(deque<BackgroundSaveEvictorElementPtr>::const_iterator p = round->allObjects.begin();
+        p != round->allObjects.end(); ++p)
+    {
+        partitions[identityHash((*p)->cachePosition->first) % partitions.size()].push_back(*p);
+    }
+
+    for(size_t i = 0; i < _streamThreads.size(); ++i)
+    {
+        _streamThreads[i]->stream(partitions[i + 1], streamStart);
+    }
+
+    try
+    {
+        streamObjects(partitions[0], streamStart, streamedObjects, round->deadObjects);
+    }
+    catch(...)
+    {
+        //
+        // The stream threads use the partitions
+        //
+        for(size_t i = 0; i < _streamThreads.size(); ++i)
+        {
+            try
+            {
+                _streamThreads[i]->waitForCompletion(streamedObjects, round->deadObjects);
+            }
+            catch(...)
+            {
+            }
+        }
+        throw;
+    }
+
+    IceUtil::UniquePtr<IceUtil::Exception> ex;
+    for(size_t i = 0; i < _streamThreads.size(); ++i)
+    {
+        try
+        {
+            _streamThreads[i]->waitForCompletion(streamedObjects, round->deadObjects);
+        }
+        catch(const IceUtil::Exception& e)
+        {
+            if(ex.get() == 0)
+            {
+                ex.reset(e.ice_clone());
+            }
+        }
+    }
+    if(ex.get() != 0)
+    {
+        ex->ice_throw();
+    }
+}
+
+void
+Freeze::BackgroundSaveEvictorI::streamObjects(const deque<BackgroundSaveEvictorElementPtr>& elements, Long streamStart,
+                                              deque<StreamedObjectPtr>& streamedObjects,
+                                              deque<BackgroundSaveEvictorElementPtr>& deadObjects)
+{
+    //
+    // Stream each element
+    //
+    for(size_t i = 0; i < elements.size(); i++)
+    {
+        const BackgroundSaveEvictorElementPtr& element = elements[i];
+        
+        bool tryAgain;
+        do
+        {
+            tryAgain = false;
+            ObjectPtr servant = 0;
             
             //
-            // Stream each element
+            // These elements can't be stale as only elements with 
+            // usageCount == 0 can become stale, and the modifiedQueue
+            // (us now) owns one count.
             //
-            for(size_t i = 0; i < size; i++)
+
+            IceUtil::Mutex::Lock lockElement(element->mutex);
+            Byte status = element->status;
+            
+            switch(status)
             {
-                BackgroundSaveEvictorElementPtr& element = allObjects[i];
-                
-                bool tryAgain;
-                do
+                case created:
+                case modified:
+                {
+                    servant = element->rec.servant;
+                    break;
+                }   
+                case destroyed:
+                {
+                    size_t index = streamedObjects.size();
+                    streamedObjects.resize(index + 1);
+                    streamedObjects[index] = new StreamedObject;
+                    stream(element, streamStart, streamedObjects[index]);
+
+                    element->status = dead;
+                    deadObjects.push_back(element);
+
+                    break;
+                }   
+                case dead:
+                {
+                    deadObjects.push_back(element);
+                    break;
+                }
+                default:
                 {
-                    tryAgain = false;
-                    ObjectPtr servant = 0;
-                    
                     //
-                    // These elements can't be stale as only elements with 
-                    // usageCount == 0 can become stale, and the modifiedQueue
-                    // (us now) owns one count.
+                    // Nothing to do (could be a duplicate)
+                    //
+                    break;
+                }
+            }
+            if(servant == 0)
+            {
+                lockElement.release();
+            }
+            else
+            {
+                IceUtil::AbstractMutex* mutex = dynamic_cast<IceUtil::AbstractMutex*>(servant.get());
+                if(mutex != 0)
+                {
+                    //
+                    // Lock servant and then element so that user can safely lock
+                    // servant and call various Evictor operations
                     //
-
-                    IceUtil::Mutex::Lock lockElement(element->mutex);
-                    Byte status = element->status;
                     
+                    IceUtil::AbstractMutex::TryLock lockServant(*mutex);
+                    if(!lockServant.acquired())
+                    {
+                        lockElement.release();
+
+                        IceUtil::TimerTaskPtr watchDogTask;
+                        if(_timer)
+                        {
+                            watchDogTask = new WatchDogTask(*this);
+                            _timer->schedule(watchDogTask, IceUtil::Time::milliSeconds(_streamTimeout));
+                        }
+                        lockServant.acquire();
+                        if(watchDogTask)
+                        {
+                            _timer->cancel(watchDogTask);
+                            watchDogTask = 0;
+                        }
+
+                        lockElement.acquire();
+                        status = element->status;
+                    }
+  
                     switch(status)
                     {
                         case created:
                         case modified:
                         {
-                            servant = element->rec.servant;
+                            if(servant == element->rec.servant)
+                            {
+                                size_t index = streamedObjects.size();
+                                streamedObjects.resize(index + 1);
+                                streamedObjects[index] = new StreamedObject;
+                                stream(element, streamStart, streamedObjects[index]);
+
+                                element->status = clean;
+                            }
+                            else
+                            {
+                                tryAgain = true;
+                            }
                             break;
-                        }   
+                        }
                         case destroyed:
                         {
-                            size_t index = streamedObjectQueue.size();
-                            streamedObjectQueue.resize(index + 1);
-                            streamedObjectQueue[index] = new StreamedObject;
-                            stream(element, streamStart, streamedObjectQueue[index]);
+                            lockServant.release();
+                            
+                            size_t index = streamedObjects.size();
+                            streamedObjects.resize(index + 1);
+                            streamedObjects[index] = new StreamedObject;
+                            stream(element, streamStart, streamedObjects[index]);
 
                             element->status = dead;
                             deadObjects.push_back(element);
-
                             break;
                         }   
                         case dead:
@@ -948,276 +1429,215 @@ Freeze::BackgroundSaveEvictorI::run()
                             break;
                         }
                     }
-                    if(servant == 0)
-                    {
-                        lockElement.release();
-                    }
-                    else
-                    {
-                        IceUtil::AbstractMutex* mutex = dynamic_cast<IceUtil::AbstractMutex*>(servant.get());
-                        if(mutex != 0)
-                        {
-                            //
-                            // Lock servant and then element so that user can safely lock
-                            // servant and call various Evictor operations
-                            //
-                            
-                            IceUtil::AbstractMutex::TryLock lockServant(*mutex);
-                            if(!lockServant.acquired())
-                            {
-                                lockElement.release();
-
-                                IceUtil::TimerTaskPtr watchDogTask;
-                                if(_timer)
-                                {
-                                    watchDogTask = new WatchDogTask(*this);
-                                    _timer->schedule(watchDogTask, IceUtil::Time::milliSeconds(_streamTimeout));
-                                }
-                                lockServant.acquire();
-                                if(watchDogTask)
-                                {
-                                    _timer->cancel(watchDogTask);
-                                    watchDogTask = 0;
-                                }
-
-                                lockElement.acquire();
-                                status = element->status;
-                            }
-  
-                            switch(status)
-                            {
-                                case created:
-                                case modified:
-                                {
-                                    if(servant == element->rec.servant)
-                                    {
-                                        size_t index = streamedObjectQueue.size();
-                                        streamedObjectQueue.resize(index + 1);
-                                        streamedObjectQueue[index] = new StreamedObject;
-                                        stream(element, streamStart, streamedObjectQueue[index]);
-
-                                        element->status = clean;
-                                    }
-                                    else
-                                    {
-                                        tryAgain = true;
-                                    }
-                                    break;
-                                }
-                                case destroyed:
-                                {
-                                    lockServant.release();
-                                    
-                                    size_t index = streamedObjectQueue.size();
-                                    streamedObjectQueue.resize(index + 1);
-                                    streamedObjectQueue[index] = new StreamedObject;
-                                    stream(element, streamStart, streamedObjectQueue[index]);
-
-                                    element->status = dead;
-                                    deadObjects.push_back(element);
-                                    break;
-                                }   
-                                case dead:
-                                {
-                                    deadObjects.push_back(element);
-                                    break;
-                                }
-                                default:
-                                {
-                                    //
-                                    // Nothing to do (could be a duplicate)
-                                    //
-                                    break;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            DatabaseException ex(__FILE__, __LINE__);
-                            ex.message = string(typeid(*element->rec.servant).name()) 
-                                + " does not implement IceUtil::AbstractMutex";
-                            throw ex;
-                        }
-                    }
-                } while(tryAgain);
-            }
-            
-            if(_trace >= 1)
-            {
-                Long now = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
-                Trace out(_communicator->getLogger(), "Freeze.Evictor");
-                out << "streamed " << streamedObjectQueue.size() << " objects in " 
-                    << static_cast<Int>(now - streamStart) << " ms";
+                }
+                else
+                {
+                    DatabaseException ex(__FILE__, __LINE__);
+                    ex.message = string(typeid(*element->rec.servant).name()) 
+                        + " does not implement IceUtil::AbstractMutex";
+                    throw ex;
+                }
             }
-            
-            //
-            // Now let's save all these streamed objects to disk using a transaction
-            //
-            
-            //
-            // Each time we get a deadlock, we reduce the number of objects to save
-            // per transaction
-            //
-            size_t txSize = streamedObjectQueue.size();
-            if(txSize > static_cast<size_t>(_maxTxSize))
+        } while(tryAgain);
+    }
+}
+
+void
+Freeze::BackgroundSaveEvictorI::saveObjects(deque<StreamedObjectPtr>& streamedObjects)
+{
+    //
+    // Now let's save all these streamed objects to disk using a transaction
+    //
+    
+    //
+    // Each time we get a deadlock, we reduce the number of objects to save
+    // per transaction
+    //
+    size_t txSize = streamedObjects.size();
+    if(txSize > static_cast<size_t>(_maxTxSize))
+    {
+        txSize = static_cast<size_t>(_maxTxSize);
+    }
+    bool tryAgain;
+    
+    do
+    {
+        tryAgain = false;
+        
+        while(streamedObjects.size() > 0)
+        {
+            if(txSize > streamedObjects.size())
             {
-                txSize = static_cast<size_t>(_maxTxSize);
+                txSize = streamedObjects.size();
             }
-            bool tryAgain;
             
-            do
+            Long saveStart = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
+           
+            try
             {
-                tryAgain = false;
-                
-                while(streamedObjectQueue.size() > 0)
-                {
-                    if(txSize > streamedObjectQueue.size())
-                    {
-                        txSize = streamedObjectQueue.size();
-                    }
-                    
-                    Long saveStart = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
-                   
-                    try
-                    {
-                        DbTxn* tx = 0;
-                        _dbEnv->getEnv()->txn_begin(0, &tx, 0);
-
-                        long txnId = 0;
-                        if(_txTrace >= 1)
-                        {
-                            txnId = (tx->id() & 0x7FFFFFFF) + 0x80000000L;
-                            Trace out(_communicator->getLogger(), "Freeze.Evictor");
-                            out << "started transaction " << hex << txnId << dec << " in saving thread";
-                        }
+                DbTxn* tx = 0;
+                _dbEnv->getEnv()->txn_begin(0, &tx, 0);
 
-                        try
-                        {       
-                            for(size_t i = 0; i < txSize; i++)
-                            {
-                                StreamedObjectPtr obj = streamedObjectQueue[i];
-                                Dbt key, value;
-                                obj->key->getDbt(key);
-                                if(obj->value)
-                                {
-                                    obj->value->getDbt(value);
-                                }
-                                obj->store->save(key, value, obj->status, tx);
-                            }
-                        }
-                        catch(...)
-                        {
-                            tx->abort();
-                            if(_txTrace >= 1)
-                            {
-                                Trace out(_communicator->getLogger(), "Freeze.Evictor");
-                                out << "rolled back transaction " << hex << txnId << dec;
-                            }
-                            throw;
-                        }
-                        tx->commit(0);
-
-                        if(_txTrace >= 1)
-                        {
-                            Trace out(_communicator->getLogger(), "Freeze.Evictor");
-                            out << "committed transaction " << hex << txnId << dec;
-                        }
+                long txnId = 0;
+                if(_txTrace >= 1)
+                {
+                    txnId = (tx->id() & 0x7FFFFFFF) + 0x80000000L;
+                    Trace out(_communicator->getLogger(), "Freeze.Evictor");
+                    out << "started transaction " << hex << txnId << dec << " in saving thread";
+                }
 
-                        streamedObjectQueue.erase(streamedObjectQueue.begin(), streamedObjectQueue.begin() + txSize);
-                        
-                        if(_trace >= 1)
-                        {
-                            Long now = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
-                            Trace out(_communicator->getLogger(), "Freeze.Evictor");
-                            out << "saved " << txSize << " objects in " 
-                                << static_cast<Int>(now - saveStart) << " ms";
-                        }
-                    }
-                    catch(const DbDeadlockException&)
+                try
+                {       
+                    for(size_t i = 0; i < txSize; i++)
                     {
-                        if(_deadlockWarning)
+                        StreamedObjectPtr obj = streamedObjects[i];
+                        Dbt key, value;
+                        obj->key->getDbt(key);
+                        if(obj->value)
                         {
-                            Warning out(_communicator->getLogger());
-                            out << "Deadlock in Freeze::BackgroundSaveEvictorI::run while writing into Db \"" + _filename
-                                + "\"; retrying ...";
+                            obj->value->getDbt(value);
                         }
-                        
-                        tryAgain = true;
-                        txSize = (txSize + 1)/2;
+                        obj->store->save(key, value, obj->status, tx);
                     }
-                    catch(const DbException& dx)
+                }
+                catch(...)
+                {
+                    tx->abort();
+                    if(_txTrace >= 1)
                     {
-                        DatabaseException ex(__FILE__, __LINE__);
-                        ex.message = dx.what();
-                        throw ex;
+                        Trace out(_communicator->getLogger(), "Freeze.Evictor");
+                        out << "rolled back transaction " << hex << txnId << dec;
                     }
-                } 
-            }
-            while(tryAgain);
-            
-            {
-                Lock sync(*this);
-               
-                //
-                // Release usage count
-                //
-                for(deque<BackgroundSaveEvictorElementPtr>::iterator p = allObjects.begin();
-                    p != allObjects.end(); p++)
-                {
-                    BackgroundSaveEvictorElementPtr& element = *p;
-                    element->usageCount--;
+                    throw;
                 }
-                allObjects.clear();
+                tx->commit(_groupCommit ? DB_TXN_NOSYNC : 0);
 
-                for(deque<BackgroundSaveEvictorElementPtr>::iterator q = deadObjects.begin();
-                    q != deadObjects.end(); q++)
+                if(_txTrace >= 1)
                 {
-                    BackgroundSaveEvictorElementPtr& element = *q;
-                    if(!element->stale)
-                    {
-                        //
-                        // Can be stale when there are duplicate elements on the
-                        // deadObjecst queue
-                        //
-
-                        if(!element->stale && element->usageCount == 0 && element->keepCount == 0)
-                        {
-                            //
-                            // Get rid of unused dead elements
-                            //
-                            IceUtil::Mutex::Lock lockElement(element->mutex);
-                            if(element->status == dead)
-                            {
-                                evict(element);
-                            }
-                        }
-                    }
+                    Trace out(_communicator->getLogger(), "Freeze.Evictor");
+                    out << "committed transaction " << hex << txnId << dec;
                 }
-                deadObjects.clear();
-                evict();
+
+                streamedObjects.erase(streamedObjects.begin(), streamedObjects.begin() + txSize);
                 
-                if(saveNowThreadsSize > 0)
+                if(_trace >= 1)
+                {
+                    Long now = IceUtil::Time::now(IceUtil::Time::Monotonic).toMilliSeconds();
+                    Trace out(_communicator->getLogger(), "Freeze.Evictor");
+                    out << "saved " << txSize << " objects in " 
+                        << static_cast<Int>(now - saveStart) << " ms";
+                }
+            }
+            catch(const DbDeadlockException&)
+            {
+                if(_deadlockWarning)
                 {
-                    _saveNowThreads.erase(_saveNowThreads.begin(), _saveNowThreads.begin() + saveNowThreadsSize);
-                    notifyAll();
+                    Warning out(_communicator->getLogger());
+                    out << "Deadlock in Freeze::BackgroundSaveEvictorI::saveObjects while writing into Db \"" + _filename
+                        + "\"; retrying ...";
                 }
+                
+                tryAgain = true;
+                txSize = (txSize + 1)/2;
             }
+            catch(const DbException& dx)
+            {
+                DatabaseException ex(__FILE__, __LINE__);
+                ex.message = dx.what();
+                throw ex;
+            }
+        } 
+    }
+    while(tryAgain);
+}
+
+void
+Freeze::BackgroundSaveEvictorI::saved(const SaveRoundPtr& round)
+{
+    {
+        Lock sync(*this);
+        assert(round->pending > 0);
+        if(--round->pending > 0)
+        {
+            return;
         }
     }
-    catch(const std::exception& ex)
+
+    if(_groupCommit && round->streamed > 0)
     {
-        Error out(_communicator->getLogger());
-        out << "Saving thread killed by exception: " << ex;
-        out.flush();
-        handleFatalError(this, _communicator);
+        try
+        {
+            _dbEnv->getEnv()->log_flush(0);
+        }
+        catch(const DbException& dx)
+        {
+            DatabaseException ex(__FILE__, __LINE__);
+            ex.message = dx.what();
+            throw ex;
+        }
     }
-    catch(...)
+
+    Lock sync(*this);
+
+    //
+    // Complete the rounds in order
+    //
+    round->done = true;
+    while(!_saveRounds.empty() && _saveRounds.front()->done)
     {
-        Error out(_communicator->getLogger());
-        out << "Saving thread killed by unknown exception";
-        out.flush();
-        handleFatalError(this, _communicator);
+        SaveRoundPtr r = _saveRounds.front();
+        _saveRounds.pop_front();
+
+        //
+        // Release usage count
+        //
+        for(deque<BackgroundSaveEvictorElementPtr>::iterator p = r->allObjects.begin();
+            p != r->allObjects.end(); p++)
+        {
+            BackgroundSaveEvictorElementPtr& element = *p;
+            element->usageCount--;
+        }
+
+        for(deque<BackgroundSaveEvictorElementPtr>::iterator q = r->deadObjects.begin();
+            q != r->deadObjects.end(); q++)
+        {
+            BackgroundSaveEvictorElementPtr& element = *q;
+
+            //
+            // Can be stale when there are duplicate elements on the
+            // deadObjects queue
+            //
+            if(!element->stale && element->usageCount == 0 && element->keepCount == 0)
+            {
+                //
+                // Get rid of unused dead elements
+                //
+                IceUtil::Mutex::Lock lockElement(element->mutex);
+                if(element->status == dead)
+                {
+                    evict(element);
+                }
+            }
+        }
+
+        if(_trace >= 1 && r->streamed > 0)
+        {
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            Trace out(_communicator->getLogger(), "Freeze.Evictor");
+            out << "completed save of " << r->streamed << " objects; save latency "
+                << static_cast<Int>((now - r->firstModified).toMilliSeconds()) << " ms; "
+                << _modifiedQueue.size() << " objects in the modified queue; "
+                << _saveRounds.size() << " rounds in progress";
+        }
+
+        if(r->saveNowThreads > 0)
+        {
+            _saveNowThreads.erase(_saveNowThreads.begin(), _saveNowThreads.begin() + r->saveNowThreads);
+            _claimedSaveNowThreads -= r->saveNowThreads;
+        }
     }
+    evict();
+    notifyAll();
 }
 
 Freeze::TransactionIPtr
@@ -1343,6 +1763,11 @@ Freeze::BackgroundSaveEvictorI::evict(const BackgroundSaveEvictorElementPtr& ele
 void
 Freeze::BackgroundSaveEvictorI::addToModifiedQueue(const BackgroundSaveEvictorElementPtr& element)
 {
+    if(_modifiedQueue.empty())
+    {
+        _firstModified = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+
     element->usageCount++;
     _modifiedQueue.push_back(element);
     
@@ -1364,6 +1789,7 @@ Freeze::BackgroundSaveEvictorI::stream(const BackgroundSaveEvictorElementPtr& el
 
     const Identity& ident = element->cachePosition->first;
     obj->key = new ObjectStoreBase::KeyMarshaler(ident, _communicator, _encoding);
+    obj->hash = identityHash(ident);
 
     if(element->status != destroyed)
     {
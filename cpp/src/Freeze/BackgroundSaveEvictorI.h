@@ -147,6 +147,7 @@ public:
         ObjectStoreBase::ValueMarshaler* value;
         Ice::Byte status;
         ObjectStore<BackgroundSaveEvictorElement>* store;
+        size_t hash;
 
     private:
 
@@ -165,6 +166,34 @@ protected:
 
 private:
 
+    //
+    // The objects taken from the modified queue in one go. Rounds are
+    // streamed in order, can be written concurrently by the save
+    // threads, and are completed in order.
+    //
+    struct SaveRound : public IceUtil::Shared
+    {
+        SaveRound() :
+            saveNowThreads(0), pending(0), streamed(0), done(false)
+        {
+        }
+
+        std::deque<BackgroundSaveEvictorElementPtr> allObjects;
+        std::deque<BackgroundSaveEvictorElementPtr> deadObjects;
+        size_t saveNowThreads;
+        IceUtil::Time firstModified;
+        int pending;
+        size_t streamed;
+        bool done;
+    };
+    typedef IceUtil::Handle<SaveRound> SaveRoundPtr;
+
+    class StreamThread;
+    typedef IceUtil::Handle<StreamThread> StreamThreadPtr;
+
+    class SaveThread;
+    typedef IceUtil::Handle<SaveThread> SaveThreadPtr;
+
     void saveNow();
 
     void evict(const BackgroundSaveEvictorElementPtr&);
@@ -172,6 +201,12 @@ private:
     void fixEvictPosition(const BackgroundSaveEvictorElementPtr&);
 
     void stream(const BackgroundSaveEvictorElementPtr&, Ice::Long, const StreamedObjectPtr&);
+
+    void streamRound(const SaveRoundPtr&, Ice::Long, std::deque<StreamedObjectPtr>&);
+    void streamObjects(const std::deque<BackgroundSaveEvictorElementPtr>&, Ice::Long,
+                       std::deque<StreamedObjectPtr>&, std::deque<BackgroundSaveEvictorElementPtr>&);
+    void saveObjects(std::deque<StreamedObjectPtr>&);
+    void saved(const SaveRoundPtr&);
   
     //
     // The _evictorList contains a list of all objects we keep,
@@ -187,6 +222,31 @@ private:
     //
     std::deque<BackgroundSaveEvictorElementPtr> _modifiedQueue;
 
+    //
+    // When the oldest object of the modified queue was queued
+    //
+    IceUtil::Time _firstModified;
+
+    //
+    // The rounds being streamed or saved, oldest first
+    //
+    std::deque<SaveRoundPtr> _saveRounds;
+
+    //
+    // Helper threads of the saving thread: the saving thread and the
+    // stream threads marshal the objects of a round in parallel, and
+    // the save threads write them, partitioned by identity. Without
+    // save threads, the saving thread writes the objects itself.
+    //
+    std::vector<StreamThreadPtr> _streamThreads;
+    std::vector<SaveThreadPtr> _saveThreads;
+
+    //
+    // Commit without synchronous log flush and flush the log once per
+    // round
+    //
+    bool _groupCommit;
+
     bool _savingThreadDone;
     long _streamTimeout;
     IceUtil::TimerPtr _timer;
@@ -196,6 +256,7 @@ private:
     // its completion
     //
     std::deque<IceUtil::ThreadControl> _saveNowThreads;
+    size_t _claimedSaveNowThreads;
 
     Ice::Int _saveSizeTrigger;
     Ice::Int _maxTxSize;
@@ -20,6 +20,7 @@ using namespace Ice;
 Freeze::EvictorIteratorI::EvictorIteratorI(ObjectStoreBase* store, const TransactionIPtr& tx, Int batchSize) :
     _store(store),
     _batchSize(static_cast<size_t>(batchSize)),
+    _bulkSize(store != 0 ? store->bulkReadSize() : 0),
     _key(1024),
     _more(store != 0),
     _initialized(false),
@@ -88,6 +89,13 @@ Freeze::EvictorIteratorI::nextBatch()
 
             Dbt dbValue;
             dbValue.set_flags(DB_DBT_USERMEM | DB_DBT_PARTIAL);
+
+            //
+            // Bulk retrievals return the keys in the bulk buffer
+            //
+            Dbt dbBulkKey;
+            dbBulkKey.set_flags(DB_DBT_USERMEM | DB_DBT_PARTIAL);
+            Dbt dbBulk;
            
             Dbc* dbc = 0;
             try
@@ -118,8 +126,49 @@ Freeze::EvictorIteratorI::nextBatch()
                 {
                     for(;;)
                     {
+                        bool bulk = _bulkSize > 0 && flags == DB_NEXT;
                         try
                         {
+                            if(bulk)
+                            {
+                                //
+                                // Read the following records in bulk; the first
+                                // record past the batch is kept in _key
+                                //
+                                if(_bulk.size() < _bulkSize)
+                                {
+                                    _bulk.resize(_bulkSize);
+                                }
+                                initializeBulkDbt(_bulk, dbBulk);
+
+                                _more = (dbc->get(&dbBulkKey, &dbBulk, DB_NEXT | DB_MULTIPLE_KEY) == 0);
+                                if(_more)
+                                {
+                                    _initialized = true;
+
+                                    DbMultipleKeyDataIterator p(dbBulk);
+                                    Dbt k;
+                                    Dbt v;
+                                    while(!done && p.next(k, v))
+                                    {
+                                        const Ice::Byte* data = static_cast<const Ice::Byte*>(k.get_data());
+                                        _key.assign(data, data + k.get_size());
+
+                                        if(_batch.size() < _batchSize)
+                                        {
+                                            Ice::Identity ident;
+                                            ObjectStoreBase::unmarshal(ident, _key, communicator, encoding);
+                                            _batch.push_back(ident);
+                                        }
+                                        else
+                                        {
+                                            done = true;
+                                        }
+                                    }
+                                }
+                                break;
+                            }
+
                             //
                             // It is critical to set key size to key capacity before the
                             // get, as a resize that increases the size inserts 0
@@ -156,7 +205,14 @@ Freeze::EvictorIteratorI::nextBatch()
                         }
                         catch(const DbException& dx)
                         {
-                            handleDbException(dx, _key, dbKey, __FILE__, __LINE__);
+                            if(bulk)
+                            {
+                                handleBulkDbException(dx, _bulk, dbBulk, __FILE__, __LINE__);
+                            }
+                            else
+                            {
+                                handleDbException(dx, _key, dbKey, __FILE__, __LINE__);
+                            }
                         }
                     }
                 }
@@ -39,9 +39,11 @@ private:
 
     ObjectStoreBase* _store;
     size_t _batchSize;
+    size_t _bulkSize;
     std::vector<Ice::Identity>::const_iterator _batchIterator;
 
     Key _key;
+    std::vector<Ice::Byte> _bulk;
     std::vector<Ice::Identity> _batch;
     bool _more;
     bool _initialized;
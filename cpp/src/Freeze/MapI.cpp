@@ -16,12 +16,206 @@
 #include <Freeze/CatalogIndexList.h>
 #include <IceUtil/UUID.h>
 #include <IceUtil/StringConverter.h>
+#include <IceUtil/Thread.h>
 #include <stdlib.h>
+#include <deque>
 
 using namespace std;
 using namespace Ice;
 using namespace Freeze;
 
+namespace
+{
+
+//
+// Default size in kilobytes of the bulk buffers used by scan when
+// Freeze.Map.name.BulkReadSize isn't set.
+//
+const Ice::Int defaultScanBulkReadSize = 64;
+
+void
+processBulk(ScanCallbackBase& callback, vector<Byte>& buffer, Key& key, Value& value)
+{
+    Dbt dbBulk;
+    initializeBulkDbt(buffer, dbBulk);
+    DbMultipleKeyDataIterator p(dbBulk);
+
+    Dbt dbKey;
+    Dbt dbValue;
+    while(p.next(dbKey, dbValue))
+    {
+        const Byte* k = static_cast<const Byte*>(dbKey.get_data());
+        key.assign(k, k + dbKey.get_size());
+        const Byte* v = static_cast<const Byte*>(dbValue.get_data());
+        value.assign(v, v + dbValue.get_size());
+        callback.record(key, value);
+    }
+}
+
+//
+// The queue shared by the thread reading the database and the scan
+// threads. Full bulk buffers are swapped into the queue and the
+// processed buffers are given back to the reader for the following
+// bulk retrievals.
+//
+class ScanQueue : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    ScanQueue(ScanCallbackBase& callback, size_t capacity) :
+        _callback(callback),
+        _capacity(capacity),
+        _done(false)
+    {
+    }
+
+    //
+    // Queues the given buffer and replaces it with a free buffer.
+    // Returns false if the scan failed and must stop.
+    //
+    bool
+    push(vector<Byte>& buffer)
+    {
+        Lock sync(*this);
+        while(_queue.size() >= _capacity && _exception.get() == 0)
+        {
+            wait();
+        }
+
+        if(_exception.get() != 0)
+        {
+            return false;
+        }
+
+        _queue.push_back(vector<Byte>());
+        _queue.back().swap(buffer);
+        if(!_free.empty())
+        {
+            buffer.swap(_free.back());
+            _free.pop_back();
+        }
+        notifyAll();
+        return true;
+    }
+
+    void
+    finish()
+    {
+        Lock sync(*this);
+        _done = true;
+        notifyAll();
+    }
+
+    void
+    run()
+    {
+        vector<Byte> buffer;
+        Key key;
+        Value value;
+        for(;;)
+        {
+            {
+                Lock sync(*this);
+                if(!buffer.empty())
+                {
+                    _free.push_back(vector<Byte>());
+                    _free.back().swap(buffer);
+                }
+
+                while(_queue.empty() && !_done && _exception.get() == 0)
+                {
+                    wait();
+                }
+
+                if(_queue.empty() || _exception.get() != 0)
+                {
+                    return;
+                }
+
+                buffer.swap(_queue.front());
+                _queue.pop_front();
+                notifyAll();
+            }
+
+            try
+            {
+                processBulk(_callback, buffer, key, value);
+            }
+            catch(const IceUtil::Exception& ex)
+            {
+                failed(ex.ice_clone());
+            }
+            catch(const std::exception& ex)
+            {
+                failed(new UnknownException(__FILE__, __LINE__, ex.what()));
+            }
+            catch(...)
+            {
+                failed(new UnknownException(__FILE__, __LINE__, "unknown c++ exception"));
+            }
+        }
+    }
+
+    //
+    // Called once the scan threads are joined.
+    //
+    void
+    rethrow() const
+    {
+        if(_exception.get() != 0)
+        {
+            _exception->ice_throw();
+        }
+    }
+
+private:
+
+    void
+    failed(IceUtil::Exception* ex)
+    {
+        Lock sync(*this);
+        if(_exception.get() == 0)
+        {
+            _exception.reset(ex);
+        }
+        else
+        {
+            delete ex;
+        }
+        notifyAll();
+    }
+
+    ScanCallbackBase& _callback;
+    const size_t _capacity;
+    bool _done;
+    deque<vector<Byte> > _queue;
+    vector<vector<Byte> > _free;
+    IceUtil::UniquePtr<IceUtil::Exception> _exception;
+};
+
+class ScanThread : public IceUtil::Thread
+{
+public:
+
+    ScanThread(ScanQueue& queue) :
+        IceUtil::Thread("Freeze map scan thread"),
+        _queue(queue)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _queue.run();
+    }
+
+private:
+
+    ScanQueue& _queue;
+};
+
+}
+
 //
 // MapIndexBase (from Map.h)
 //
@@ -311,6 +505,14 @@ Freeze::MapHelper::~MapHelper()
 {
 }
 
+//
+// ScanCallbackBase (from Map.h)
+//
+
+Freeze::ScanCallbackBase::~ScanCallbackBase()
+{
+}
+
 //
 // IteratorHelper (from Map.h)
 //
@@ -367,7 +569,9 @@ Freeze::IteratorHelperI::IteratorHelperI(const MapHelperI& m, bool readOnly,
     _dbc(0),
     _indexed(index != 0),
     _onlyDups(onlyDups),
-    _tx(0)
+    _tx(0),
+    _bulkSize(readOnly && index == 0 ? m._bulkReadSize : 0),
+    _bulkCurrent(false)
 {
     if(_map._trace >= 2)
     {
@@ -420,7 +624,9 @@ Freeze::IteratorHelperI::IteratorHelperI(const IteratorHelperI& it) :
     _dbc(0),
     _indexed(it._indexed),
     _onlyDups(it._onlyDups),
-    _tx(0)
+    _tx(0),
+    _bulkSize(it._bulkSize),
+    _bulkCurrent(false)
 {
     if(_map._trace >= 2)
     {
@@ -462,6 +668,8 @@ Freeze::IteratorHelperI::find(const Dbt& key) const
     assert((key.get_flags() & DB_DBT_USERMEM) != 0);
     Dbt dbKey(key);
 
+    resetBulk();
+
 #if (DB_VERSION_MAJOR <= 4) || (DB_VERSION_MAJOR == 5 && DB_VERSION_MINOR <= 1)
     //
     // When we have a custom-comparison function, Berkeley DB returns
@@ -513,6 +721,8 @@ Freeze::IteratorHelperI::find(const Dbt& key) const
 bool
 Freeze::IteratorHelperI::lowerBound(const Key& key) const
 {
+    resetBulk();
+
     //
     // We retrieve the actual key for upperBound
     //
@@ -591,7 +801,16 @@ Freeze::IteratorHelperI::upperBound(const Key& key) const
 Freeze::IteratorHelper*
 Freeze::IteratorHelperI::clone() const
 {
-    return new IteratorHelperI(*this);
+    IceUtil::UniquePtr<IteratorHelperI> r(new IteratorHelperI(*this));
+    if(_bulkCurrent)
+    {
+        //
+        // The cursor of a bulk iterator is positioned on the last
+        // record of its buffer, not on the current record.
+        //
+        r->find(_key);
+    }
+    return r.release();
 }
 
 void
@@ -600,6 +819,17 @@ Freeze::IteratorHelperI::get(const Key*& key, const Value*& value) const
     key = &_key;
     value = &_value;
 
+    if(_bulkCurrent)
+    {
+        if(_bulkValue.get_data() != 0)
+        {
+            const Byte* v = static_cast<const Byte*>(_bulkValue.get_data());
+            _value.assign(v, v + _bulkValue.get_size());
+            _bulkValue.set_data(0);
+        }
+        return;
+    }
+
     size_t keySize = _key.size();
     if(keySize < 1024)
     {
@@ -680,6 +910,11 @@ Freeze::IteratorHelperI::get(const Key*& key, const Value*& value) const
 const Freeze::Key*
 Freeze::IteratorHelperI::get() const
 {
+    if(_bulkCurrent)
+    {
+        return &_key;
+    }
+
     size_t keySize = _key.size();
     if(keySize < 1024)
     {
@@ -856,6 +1091,15 @@ Freeze::IteratorHelperI::next() const
 bool
 Freeze::IteratorHelperI::next(bool skipDups) const
 {
+    if(_bulkSize > 0)
+    {
+        //
+        // Bulk iterators are never indexed, so there are no
+        // duplicates to skip.
+        //
+        return nextBulk();
+    }
+
     //
     // Keep 0 length since we're not interested in the data
     //
@@ -904,6 +1148,82 @@ Freeze::IteratorHelperI::next(bool skipDups) const
     }
 }
 
+bool
+Freeze::IteratorHelperI::nextBulk() const
+{
+    Dbt dbKey;
+    if(_bulkIterator.get() == 0 || !_bulkIterator->next(dbKey, _bulkValue))
+    {
+        resetBulk();
+        if(!fetchBulk(_bulk, _bulkSize))
+        {
+            return false;
+        }
+
+        Dbt dbBulk;
+        initializeBulkDbt(_bulk, dbBulk);
+        _bulkIterator.reset(new DbMultipleKeyDataIterator(dbBulk));
+        if(!_bulkIterator->next(dbKey, _bulkValue))
+        {
+            resetBulk();
+            return false;
+        }
+    }
+
+    const Byte* k = static_cast<const Byte*>(dbKey.get_data());
+    _key.assign(k, k + dbKey.get_size());
+    _bulkCurrent = true;
+    return true;
+}
+
+bool
+Freeze::IteratorHelperI::fetchBulk(vector<Byte>& buffer, size_t size) const
+{
+    if(buffer.size() < size)
+    {
+        buffer.resize(size);
+    }
+
+    //
+    // Keep 0 length since the keys are returned in the bulk buffer
+    //
+    Dbt dbKey;
+    dbKey.set_flags(DB_DBT_USERMEM | DB_DBT_PARTIAL);
+    Dbt dbBulk;
+    initializeBulkDbt(buffer, dbBulk);
+
+    for(;;)
+    {
+        try
+        {
+            return _dbc->get(&dbKey, &dbBulk, DB_NEXT | DB_MULTIPLE_KEY) == 0;
+        }
+        catch(const ::DbDeadlockException& dx)
+        {
+            if(_tx != 0)
+            {
+                _tx->dead();
+            }
+
+            DeadlockException ex(__FILE__, __LINE__);
+            ex.message = dx.what();
+            throw ex;
+        }
+        catch(const ::DbException& dx)
+        {
+            handleBulkDbException(dx, buffer, dbBulk, __FILE__, __LINE__);
+        }
+    }
+}
+
+void
+Freeze::IteratorHelperI::resetBulk() const
+{
+    _bulkIterator.reset();
+    _bulkValue.set_data(0);
+    _bulkCurrent = false;
+}
+
 void
 Freeze::IteratorHelperI::close()
 {
@@ -1044,7 +1364,8 @@ Freeze::MapHelperI::MapHelperI(const ConnectionIPtr& connection,
     _connection(connection),
     _db(connection->dbEnv()->getSharedMapDb(dbName, key, value, keyCompare, indices, createDb)),
     _dbName(dbName),
-    _trace(connection->trace())
+    _trace(connection->trace()),
+    _bulkReadSize(0)
 {
     for(vector<MapIndexBasePtr>::const_iterator p = indices.begin();
         p != indices.end(); ++p)
@@ -1064,6 +1385,18 @@ Freeze::MapHelperI::MapHelperI(const ConnectionIPtr& connection,
         indexBase->_map = this;
     }
 
+    Ice::Int bulkReadSize = _connection->communicator()->getProperties()->getPropertyAsInt(
+        "Freeze.Map." + _dbName + ".BulkReadSize");
+    if(bulkReadSize > 0)
+    {
+        _bulkReadSize = getBulkBufferSize(_db, bulkReadSize);
+        if(_trace >= 1)
+        {
+            Trace out(_connection->communicator()->getLogger(), "Freeze.Map");
+            out << "Using " << _bulkReadSize << " bytes bulk reads for read-only iterators on \"" << _dbName << "\"";
+        }
+    }
+
     _connection->registerMap(this);
 }
 
@@ -1715,6 +2048,68 @@ Freeze::MapHelperI::getConnection() const
     return _connection;
 }
 
+void
+Freeze::MapHelperI::scan(ScanCallbackBase& callback, int threads) const
+{
+    size_t bulkSize = _bulkReadSize > 0 ? _bulkReadSize : getBulkBufferSize(_db, defaultScanBulkReadSize);
+
+    if(_trace >= 1)
+    {
+        Trace out(_connection->communicator()->getLogger(), "Freeze.Map");
+        out << "scanning Db \"" << _dbName << "\" with " << (threads > 1 ? threads : 1) << " thread(s)";
+    }
+
+    IteratorHelperI it(*this, true, 0, false);
+    vector<Byte> buffer;
+
+    if(threads <= 1)
+    {
+        Key key;
+        Value value;
+        while(it.fetchBulk(buffer, bulkSize))
+        {
+            processBulk(callback, buffer, key, value);
+        }
+        return;
+    }
+
+    //
+    // This thread reads the bulk buffers and the scan threads decode
+    // them. Each scan thread can have one buffer in progress and one
+    // buffer queued.
+    //
+    ScanQueue queue(callback, static_cast<size_t>(threads));
+    vector<IceUtil::ThreadControl> scanThreads;
+    try
+    {
+        for(int i = 0; i < threads; ++i)
+        {
+            IceUtil::ThreadPtr thread = new ScanThread(queue);
+            scanThreads.push_back(thread->start());
+        }
+
+        while(it.fetchBulk(buffer, bulkSize) && queue.push(buffer))
+        {
+        }
+    }
+    catch(...)
+    {
+        queue.finish();
+        for(vector<IceUtil::ThreadControl>::iterator p = scanThreads.begin(); p != scanThreads.end(); ++p)
+        {
+            p->join();
+        }
+        throw;
+    }
+
+    queue.finish();
+    for(vector<IceUtil::ThreadControl>::iterator p = scanThreads.begin(); p != scanThreads.end(); ++p)
+    {
+        p->join();
+    }
+    queue.rethrow();
+}
+
 void
 Freeze::MapHelperI::close()
 {
@@ -67,6 +67,9 @@ public:
 
     bool next(bool) const;
 
+    bool
+    fetchBulk(std::vector<Ice::Byte>&, size_t) const;
+
     void
     close();
 
@@ -107,6 +110,12 @@ private:
     void
     cleanup();
 
+    bool
+    nextBulk() const;
+
+    void
+    resetBulk() const;
+
     const MapHelperI& _map;
     Dbc* _dbc;
     const bool _indexed;
@@ -115,6 +124,18 @@ private:
 
     mutable Key _key;
     mutable Value _value;
+
+    //
+    // Read-only iterators on the main database fetch the records in
+    // bulk when Freeze.Map.name.BulkReadSize is set. The cursor is then
+    // positioned on the last record of _bulk, and _key/_value hold the
+    // current record when _bulkCurrent is true.
+    //
+    const size_t _bulkSize;
+    mutable std::vector<Ice::Byte> _bulk;
+    mutable IceUtil::UniquePtr<DbMultipleKeyDataIterator> _bulkIterator;
+    mutable Dbt _bulkValue;
+    mutable bool _bulkCurrent;
 };
 
 class MapHelperI : public MapHelper
@@ -177,6 +198,9 @@ public:
     virtual ConnectionPtr
     getConnection() const;
 
+    virtual void
+    scan(ScanCallbackBase&, int) const;
+
     void
     close();
 
@@ -202,6 +226,7 @@ private:
     IndexMap _indices;
 
     Ice::Int _trace;
+    size_t _bulkReadSize;
 };
 
 inline const IteratorHelperI::TxPtr&
@@ -30,7 +30,8 @@ Freeze::ObjectStoreBase::ObjectStoreBase(const string& facet, const string& face
     _indices(indices),
     _communicator(evictor->communicator()),
     _encoding(evictor->encoding()),
-    _keepStats(false)
+    _keepStats(false),
+    _bulkReadSize(0)
 {
     if(facet == "")
     {
@@ -142,6 +143,18 @@ Freeze::ObjectStoreBase::ObjectStoreBase(const string& facet, const string& face
                   IceUtil::nativeToUTF8(evictor->filename(), IceUtil::getProcessStringConverter()).c_str(),
                   _dbName.c_str(), DB_BTREE, flags, FREEZE_DB_MODE);
 
+        int bulkReadSize = properties->getPropertyAsInt(propPrefix + "BulkReadSize");
+        if(bulkReadSize > 0)
+        {
+            _bulkReadSize = getBulkBufferSize(_db.get(), bulkReadSize);
+            if(evictor->trace() >= 1)
+            {
+                Trace out(evictor->communicator()->getLogger(), "Freeze.Evictor");
+                out << "Using " << _bulkReadSize << " bytes bulk reads for iterators on \""
+                    << evictor->filename() + "." + _dbName << "\"";
+            }
+        }
+
         for(size_t i = 0; i < _indices.size(); ++i)
         {
             _indices[i]->_impl->associate(this, txn, createDb, populateEmptyIndices);
@@ -95,6 +95,7 @@ public:
     const Ice::EncodingVersion& encoding() const;
     const std::string& facet() const;
     bool keepStats() const;
+    size_t bulkReadSize() const;
     
 protected:
 
@@ -111,6 +112,7 @@ private:
     Ice::EncodingVersion _encoding;
     Ice::ObjectPtr _sampleServant;
     bool _keepStats;
+    size_t _bulkReadSize;
 };
 
 
@@ -194,6 +196,12 @@ ObjectStoreBase::keepStats() const
     return _keepStats;
 }
 
+inline size_t
+ObjectStoreBase::bulkReadSize() const
+{
+    return _bulkReadSize;
+}
+
 inline const Ice::ObjectPtr&
 ObjectStoreBase::sampleServant() const
 {
@@ -88,3 +88,47 @@ Freeze::handleDbException(const DbException& dx,
         handleDbException(dx, file, line);
     }
 }
+
+void
+Freeze::handleBulkDbException(const DbException& dx,
+                              vector<Ice::Byte>& buffer, Dbt& dbBulk,
+                              const char* file, int line)
+{
+    bool bufferSmallException =
+#if (DB_VERSION_MAJOR == 4) && (DB_VERSION_MINOR == 2)
+        (dx.get_errno() == ENOMEM);
+#else
+        (dx.get_errno() == DB_BUFFER_SMALL || dx.get_errno() == ENOMEM);
+#endif
+
+    if(bufferSmallException && (dbBulk.get_size() > dbBulk.get_ulen()))
+    {
+        buffer.resize(((dbBulk.get_size() + 1023) / 1024) * 1024);
+        initializeBulkDbt(buffer, dbBulk);
+    }
+    else
+    {
+        handleDbException(dx, file, line);
+    }
+}
+
+size_t
+Freeze::getBulkBufferSize(Db* db, Ice::Int size)
+{
+    u_int32_t pageSize = 0;
+    try
+    {
+        db->get_pagesize(&pageSize);
+    }
+    catch(const DbException& dx)
+    {
+        handleDbException(dx, __FILE__, __LINE__);
+    }
+
+    size_t bulkSize = static_cast<size_t>(size) * 1024;
+    if(bulkSize < pageSize)
+    {
+        bulkSize = pageSize;
+    }
+    return ((bulkSize + 1023) / 1024) * 1024;
+}
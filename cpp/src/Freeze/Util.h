@@ -70,6 +70,31 @@ initializeOutDbt(IceInternal::BasicStream& s, Dbt& dbt)
     dbt.set_flags(DB_DBT_USERMEM);
 }
 
+//
+// Initializes a Dbt for a DB_MULTIPLE_KEY bulk retrieval into v.
+// The same initialization is used to walk the records of a filled
+// buffer with a DbMultipleKeyDataIterator.
+//
+inline void
+initializeBulkDbt(std::vector<Ice::Byte>& v, Dbt& dbt)
+{
+    dbt.set_data(&v[0]);
+    dbt.set_size(0);
+    dbt.set_ulen(static_cast<u_int32_t>(v.size()));
+    dbt.set_dlen(0);
+    dbt.set_doff(0);
+    dbt.set_flags(DB_DBT_USERMEM);
+}
+
+//
+// Returns the size in bytes of the bulk retrieval buffer for the
+// given database and BulkReadSize setting (in kilobytes). Berkeley
+// DB requires this buffer to be at least as large as a page and a
+// multiple of 1024.
+//
+size_t
+getBulkBufferSize(Db*, Ice::Int);
+
 
 //
 // Handles a Berkeley DB DbException by resizing the
@@ -89,6 +114,14 @@ void
 handleDbException(const DbException&, Key&, Dbt&, Value&, Dbt&,
                   const char*, int);
 
+//
+// Same as above for a bulk retrieval buffer; the buffer is grown when
+// it's too small to hold a single record.
+//
+void
+handleBulkDbException(const DbException&, std::vector<Ice::Byte>&, Dbt&,
+                      const char*, int);
+
 }
 
 
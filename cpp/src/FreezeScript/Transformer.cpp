@@ -19,8 +19,12 @@
 #include <Freeze/Initialize.h>
 #include <IceXML/Parser.h>
 #include <IceUtil/InputUtil.h>
+#include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/UniquePtr.h>
 #include <db_cxx.h>
 #include <climits>
+#include <deque>
 
 using namespace std;
 
@@ -75,6 +79,8 @@ struct TransformInfoI : public TransformInfo
 
     string facet;
     bool purge;
+    bool pipeline;
+    bool progress;
     ErrorReporterPtr errorReporter;
     TransformDataFactoryPtr factory;
     SymbolTablePtr symbolTable;
@@ -403,6 +409,11 @@ public:
 
 private:
 
+    class Progress;
+
+    void transformSequential(Progress&);
+    void transformPipelined(Progress&);
+    bool processRecord(const Ice::ByteSeq&, const Ice::ByteSeq&, Ice::ByteSeq&, Ice::ByteSeq&, Progress&);
     void transformRecord(const Ice::ByteSeq&, const Ice::ByteSeq&, Ice::ByteSeq&, Ice::ByteSeq&);
 
     Slice::UnitPtr _old;
@@ -1873,6 +1884,355 @@ FreezeScript::InitDescriptor::typeName() const
     return typeToString(_type);
 }
 
+//
+// Record pipeline
+//
+namespace
+{
+
+typedef pair<Ice::ByteSeq, Ice::ByteSeq> Record;
+typedef vector<Record> RecordBatch;
+
+//
+// Initial size of the buffer used to read the old database in bulk,
+// the number of batches queued between the pipeline threads, and how
+// often progress is reported.
+//
+const size_t pipelineBulkSize = 1024 * 1024;
+const size_t pipelineQueueSize = 4;
+const Ice::Long progressRecords = 1000;
+const int progressSeconds = 5;
+
+class RecordQueue : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    RecordQueue(size_t size) :
+        _size(size),
+        _finished(false),
+        _aborted(false)
+    {
+    }
+
+    //
+    // Queue the given batch, swapping it with an empty one. Returns
+    // false if the queue was aborted.
+    //
+    bool put(RecordBatch& batch)
+    {
+        Lock sync(*this);
+        while(_batches.size() >= _size && !_aborted)
+        {
+            wait();
+        }
+        if(_aborted)
+        {
+            return false;
+        }
+        _batches.push_back(RecordBatch());
+        _batches.back().swap(batch);
+        notifyAll();
+        return true;
+    }
+
+    //
+    // Returns false once the queue is finished and empty, or aborted.
+    //
+    bool get(RecordBatch& batch)
+    {
+        Lock sync(*this);
+        while(_batches.empty() && !_finished && !_aborted)
+        {
+            wait();
+        }
+        if(_batches.empty() || _aborted)
+        {
+            return false;
+        }
+        batch.clear();
+        batch.swap(_batches.front());
+        _batches.pop_front();
+        notifyAll();
+        return true;
+    }
+
+    void finish()
+    {
+        Lock sync(*this);
+        _finished = true;
+        notifyAll();
+    }
+
+    void abort()
+    {
+        Lock sync(*this);
+        _aborted = true;
+        _batches.clear();
+        notifyAll();
+    }
+
+private:
+
+    const size_t _size;
+    bool _finished;
+    bool _aborted;
+    deque<RecordBatch> _batches;
+};
+
+class RecordReader : public IceUtil::Thread
+{
+public:
+
+    RecordReader(Db* db, RecordQueue& queue) :
+        IceUtil::Thread("FreezeScript record reader"),
+        _db(db),
+        _queue(queue)
+    {
+    }
+
+    virtual void run()
+    {
+        Dbc* dbc = 0;
+        try
+        {
+            _db->cursor(0, &dbc, 0);
+
+            //
+            // DB_MULTIPLE_KEY buffers must be a multiple of 1024 and
+            // of the page size (a power of 2).
+            //
+            u_int32_t pageSize = 0;
+            _db->get_pagesize(&pageSize);
+            const size_t alignment = max(static_cast<size_t>(pageSize), static_cast<size_t>(1024));
+
+            vector<Ice::Byte> buffer(pipelineBulkSize);
+            Dbt dbKey;
+            Dbt dbBulk;
+            dbBulk.set_flags(DB_DBT_USERMEM);
+
+            for(;;)
+            {
+                dbBulk.set_data(&buffer[0]);
+                dbBulk.set_ulen(static_cast<u_int32_t>(buffer.size()));
+
+                try
+                {
+                    if(dbc->get(&dbKey, &dbBulk, DB_NEXT | DB_MULTIPLE_KEY) != 0)
+                    {
+                        break;
+                    }
+                }
+                catch(const DbMemoryException&)
+                {
+                    //
+                    // A single record doesn't fit in the buffer.
+                    //
+                    size_t size = max(buffer.size() * 2, static_cast<size_t>(dbBulk.get_size()));
+                    buffer.resize(((size + alignment - 1) / alignment) * alignment);
+                    continue;
+                }
+
+                RecordBatch batch;
+                DbMultipleKeyDataIterator p(dbBulk);
+                Dbt key, value;
+                while(p.next(key, value))
+                {
+                    const Ice::Byte* k = static_cast<const Ice::Byte*>(key.get_data());
+                    const Ice::Byte* v = static_cast<const Ice::Byte*>(value.get_data());
+                    batch.push_back(Record(Ice::ByteSeq(k, k + key.get_size()),
+                                           Ice::ByteSeq(v, v + value.get_size())));
+                }
+
+                if(!_queue.put(batch))
+                {
+                    break;
+                }
+            }
+            _queue.finish();
+        }
+        catch(const DbException& ex)
+        {
+            _error.reset(new DbException(ex));
+            _queue.abort();
+        }
+
+        if(dbc)
+        {
+            try
+            {
+                dbc->close();
+            }
+            catch(const DbException&)
+            {
+            }
+        }
+    }
+
+    //
+    // Must be called once the thread is joined.
+    //
+    void checkError() const
+    {
+        if(_error.get())
+        {
+            throw *_error;
+        }
+    }
+
+private:
+
+    Db* _db;
+    RecordQueue& _queue;
+    IceUtil::UniquePtr<DbException> _error;
+};
+typedef IceUtil::Handle<RecordReader> RecordReaderPtr;
+
+class RecordWriter : public IceUtil::Thread
+{
+public:
+
+    RecordWriter(Db* db, DbTxn* txn, RecordQueue& queue) :
+        IceUtil::Thread("FreezeScript record writer"),
+        _db(db),
+        _txn(txn),
+        _queue(queue),
+        _duplicate(false)
+    {
+    }
+
+    virtual void run()
+    {
+        try
+        {
+            RecordBatch batch;
+            while(_queue.get(batch))
+            {
+                for(RecordBatch::iterator p = batch.begin(); p != batch.end(); ++p)
+                {
+                    Dbt dbKey(&p->first[0], static_cast<unsigned>(p->first.size())),
+                        dbValue(&p->second[0], static_cast<unsigned>(p->second.size()));
+                    if(_db->put(_txn, &dbKey, &dbValue, DB_NOOVERWRITE) == DB_KEYEXIST)
+                    {
+                        _duplicate = true;
+                        _queue.abort();
+                        return;
+                    }
+                }
+            }
+        }
+        catch(const DbException& ex)
+        {
+            _error.reset(new DbException(ex));
+            _queue.abort();
+        }
+    }
+
+    //
+    // Must be called once the thread is joined.
+    //
+    void checkError() const
+    {
+        if(_error.get())
+        {
+            throw *_error;
+        }
+    }
+
+    bool duplicate() const
+    {
+        return _duplicate;
+    }
+
+private:
+
+    Db* _db;
+    DbTxn* _txn;
+    RecordQueue& _queue;
+    bool _duplicate;
+    IceUtil::UniquePtr<DbException> _error;
+};
+typedef IceUtil::Handle<RecordWriter> RecordWriterPtr;
+
+}
+
+//
+// Counts the transformed records and, if requested, periodically
+// reports the progress and throughput of the transformation.
+//
+class FreezeScript::RecordDescriptor::Progress
+{
+public:
+
+    Progress(const TransformInfoIPtr& info) :
+        _info(info),
+        _start(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+        _last(_start),
+        _records(0),
+        _deleted(0),
+        _bytes(0)
+    {
+    }
+
+    void read(size_t bytes)
+    {
+        ++_records;
+        _bytes += static_cast<Ice::Long>(bytes);
+        if(_info->progress && _records % progressRecords == 0)
+        {
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(now - _last >= IceUtil::Time::seconds(progressSeconds))
+            {
+                _last = now;
+                report(now, false);
+            }
+        }
+    }
+
+    void deleted()
+    {
+        ++_deleted;
+    }
+
+    void finished()
+    {
+        if(_info->progress)
+        {
+            report(IceUtil::Time::now(IceUtil::Time::Monotonic), true);
+        }
+    }
+
+private:
+
+    void report(const IceUtil::Time& now, bool final)
+    {
+        double seconds = (now - _start).toSecondsDouble();
+        ostream& out = _info->errorReporter->stream();
+        out << "database `" << _info->newDbName << "'";
+        if(!_info->facet.empty())
+        {
+            out << " facet `" << _info->facet << "'";
+        }
+        out << ": " << _records << " records transformed";
+        if(final)
+        {
+            out << " (" << _deleted << " deleted) in " << seconds << "s";
+        }
+        if(seconds > 0)
+        {
+            out << ", " << static_cast<Ice::Long>(_records / seconds) << " records/s, "
+                << static_cast<Ice::Long>(_bytes / seconds / 1024) << " KB/s";
+        }
+        out << endl;
+    }
+
+    const TransformInfoIPtr _info;
+    const IceUtil::Time _start;
+    IceUtil::Time _last;
+    Ice::Long _records;
+    Ice::Long _deleted;
+    Ice::Long _bytes;
+};
+
 //
 // RecordDescriptor
 //
@@ -1885,11 +2245,37 @@ FreezeScript::RecordDescriptor::RecordDescriptor(const DescriptorPtr& parent, in
 void
 FreezeScript::RecordDescriptor::execute(const SymbolTablePtr& /*sym*/)
 {
+    Progress progress(_info);
+
     //
     // Temporarily add an object factory.
     //
     _info->objectFactory->activate(_info->factory, _info->oldUnit);
 
+    try
+    {
+        if(_info->pipeline)
+        {
+            transformPipelined(progress);
+        }
+        else
+        {
+            transformSequential(progress);
+        }
+    }
+    catch(...)
+    {
+        _info->objectFactory->deactivate();
+        throw;
+    }
+
+    _info->objectFactory->deactivate();
+    progress.finished();
+}
+
+void
+FreezeScript::RecordDescriptor::transformSequential(Progress& progress)
+{
     //
     // Iterate over the database.
     //
@@ -1908,10 +2294,9 @@ FreezeScript::RecordDescriptor::execute(const SymbolTablePtr& /*sym*/)
             inValueBytes.resize(dbValue.get_size());
             memcpy(&inValueBytes[0], dbValue.get_data(), dbValue.get_size());
 
-            try
+            Ice::ByteSeq outKeyBytes, outValueBytes;
+            if(processRecord(inKeyBytes, inValueBytes, outKeyBytes, outValueBytes, progress))
             {
-                Ice::ByteSeq outKeyBytes, outValueBytes;
-                transformRecord(inKeyBytes, inValueBytes, outKeyBytes, outValueBytes);
                 Dbt dbNewKey(&outKeyBytes[0], static_cast<unsigned>(outKeyBytes.size())),
                              dbNewValue(&outValueBytes[0], static_cast<unsigned>(outValueBytes.size()));
                 if(_info->newDb->put(_info->newDbTxn, &dbNewKey, &dbNewValue, DB_NOOVERWRITE) == DB_KEYEXIST)
@@ -1919,22 +2304,6 @@ FreezeScript::RecordDescriptor::execute(const SymbolTablePtr& /*sym*/)
                     _info->errorReporter->error("duplicate key encountered");
                 }
             }
-            catch(const DeleteRecordException&)
-            {
-                // The record is deleted simply by not adding it to the new database.
-            }
-            catch(const ClassNotFoundException& ex)
-            {
-                if(!_info->purge)
-                {
-                    _info->errorReporter->error("class " + ex.id + " not found in new Slice definitions");
-                }
-                else
-                {
-                    // The record is deleted simply by not adding it to the new database.
-                    _info->errorReporter->warning("purging database record due to missing class type " + ex.id);
-                }
-            }
         }
     }
     catch(...)
@@ -1943,7 +2312,6 @@ FreezeScript::RecordDescriptor::execute(const SymbolTablePtr& /*sym*/)
         {
             dbc->close();
         }
-        _info->objectFactory->deactivate();
         throw;
     }
 
@@ -1951,7 +2319,114 @@ FreezeScript::RecordDescriptor::execute(const SymbolTablePtr& /*sym*/)
     {
         dbc->close();
     }
-    _info->objectFactory->deactivate();
+}
+
+void
+FreezeScript::RecordDescriptor::transformPipelined(Progress& progress)
+{
+    //
+    // The old database is read in bulk by a reader thread and the
+    // transformed records are stored by a writer thread, while this
+    // thread transforms the records in their original order. The
+    // transformation itself can't be spread over several threads: the
+    // Slice syntax tree, the Data objects and the descriptors are not
+    // thread-safe, and the object factory is installed once for the
+    // whole communicator.
+    //
+    RecordQueue readQueue(pipelineQueueSize);
+    RecordQueue writeQueue(pipelineQueueSize);
+
+    RecordReaderPtr reader = new RecordReader(_info->oldDb, readQueue);
+    RecordWriterPtr writer = new RecordWriter(_info->newDb, _info->newDbTxn, writeQueue);
+    IceUtil::ThreadControl readerControl = reader->start();
+    IceUtil::ThreadControl writerControl;
+    try
+    {
+        writerControl = writer->start();
+    }
+    catch(...)
+    {
+        readQueue.abort();
+        readerControl.join();
+        throw;
+    }
+
+    try
+    {
+        RecordBatch in;
+        while(readQueue.get(in))
+        {
+            RecordBatch out;
+            out.reserve(in.size());
+            for(RecordBatch::iterator p = in.begin(); p != in.end(); ++p)
+            {
+                out.push_back(Record());
+                if(!processRecord(p->first, p->second, out.back().first, out.back().second, progress))
+                {
+                    out.pop_back();
+                }
+            }
+
+            if(!out.empty() && !writeQueue.put(out))
+            {
+                //
+                // The writer failed, its error is reported below.
+                //
+                break;
+            }
+        }
+    }
+    catch(...)
+    {
+        readQueue.abort();
+        writeQueue.abort();
+        readerControl.join();
+        writerControl.join();
+        throw;
+    }
+
+    readQueue.abort();
+    writeQueue.finish();
+    readerControl.join();
+    writerControl.join();
+
+    reader->checkError();
+    writer->checkError();
+    if(writer->duplicate())
+    {
+        _info->errorReporter->error("duplicate key encountered");
+    }
+}
+
+bool
+FreezeScript::RecordDescriptor::processRecord(const Ice::ByteSeq& inKeyBytes, const Ice::ByteSeq& inValueBytes,
+                                              Ice::ByteSeq& outKeyBytes, Ice::ByteSeq& outValueBytes,
+                                              Progress& progress)
+{
+    progress.read(inKeyBytes.size() + inValueBytes.size());
+    try
+    {
+        transformRecord(inKeyBytes, inValueBytes, outKeyBytes, outValueBytes);
+        return true;
+    }
+    catch(const DeleteRecordException&)
+    {
+        // The record is deleted simply by not adding it to the new database.
+    }
+    catch(const ClassNotFoundException& ex)
+    {
+        if(!_info->purge)
+        {
+            _info->errorReporter->error("class " + ex.id + " not found in new Slice definitions");
+        }
+        else
+        {
+            // The record is deleted simply by not adding it to the new database.
+            _info->errorReporter->warning("purging database record due to missing class type " + ex.id);
+        }
+    }
+    progress.deleted();
+    return false;
 }
 
 void
@@ -3010,7 +3485,7 @@ FreezeScript::transformDatabase(const Ice::CommunicatorPtr& communicator,
                                 const Slice::UnitPtr& oldUnit, const Slice::UnitPtr& newUnit,
                                 Db* oldDb, Db* newDb, DbTxn* newDbTxn, const Freeze::ConnectionPtr& connection,
                                 const string& newDbName, const string& facetName, bool purgeObjects, ostream& errors,
-                                bool suppress, istream& is)
+                                bool suppress, bool pipeline, bool progress, istream& is)
 {
 
     TransformInfoIPtr info = new TransformInfoI;
@@ -3025,6 +3500,8 @@ FreezeScript::transformDatabase(const Ice::CommunicatorPtr& communicator,
     info->newDbName = newDbName;
     info->facet = facetName;
     info->purge = purgeObjects;
+    info->pipeline = pipeline;
+    info->progress = progress;
     info->errorReporter = new ErrorReporter(errors, suppress);
     info->factory = new TransformDataFactory(communicator, newUnit, info->errorReporter);
     info->symbolTable = new SymbolTableI(info);
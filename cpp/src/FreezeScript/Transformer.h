@@ -26,7 +26,7 @@ transformDatabase(const Ice::CommunicatorPtr&,
                   const FreezeScript::ObjectFactoryPtr& objectFactory,
                   const Slice::UnitPtr&, const Slice::UnitPtr&,
                   Db*, Db*, DbTxn*, const Freeze::ConnectionPtr&, const std::string&, const std::string&, bool,
-                  std::ostream&, bool, std::istream&);
+                  std::ostream&, bool, bool, bool, std::istream&);
 
 } // End of namespace FreezeScript
 
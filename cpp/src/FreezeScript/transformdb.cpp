@@ -84,6 +84,9 @@ usage(const std::string& n)
         "-c                    Use catastrophic recovery on the old database environment.\n"
         "-w                    Suppress duplicate warnings during migration.\n"
         "-f FILE               Execute the transformation descriptors in the file FILE.\n"
+        "--pipeline            Read and write the records in separate threads while\n"
+        "                      they are transformed.\n"
+        "--progress            Report the progress and throughput of the migration.\n"
         ;
 }
 
@@ -121,7 +124,7 @@ transformDb(bool evictor,  const Ice::CommunicatorPtr& communicator,
             DbEnv& dbEnv, DbEnv& dbEnvNew, const string& dbName,
             const Freeze::ConnectionPtr& connectionNew, vector<Db*>& dbs,
             const Slice::UnitPtr& oldUnit, const Slice::UnitPtr& newUnit,
-            DbTxn* txnNew, bool purgeObjects, bool suppress, string descriptors)
+            DbTxn* txnNew, bool purgeObjects, bool suppress, bool pipeline, bool progress, string descriptors)
 {
     if(evictor)
     {
@@ -178,7 +181,7 @@ transformDb(bool evictor,  const Ice::CommunicatorPtr& communicator,
             istringstream istr(descriptors);
             string facet = (name == "$default" ? string("") : name);
             FreezeScript::transformDatabase(communicator, objectFactory, oldUnit, newUnit, &db, dbNew, txnNew, 0,
-                                            dbName, facet, purgeObjects, cerr, suppress, istr);
+                                            dbName, facet, purgeObjects, cerr, suppress, pipeline, progress, istr);
 
             db.close(0);
         }
@@ -204,7 +207,8 @@ transformDb(bool evictor,  const Ice::CommunicatorPtr& communicator,
         //
         istringstream istr(descriptors);
         FreezeScript::transformDatabase(communicator, objectFactory, oldUnit, newUnit, &db, dbNew, txnNew,
-                                        connectionNew, dbName, "", purgeObjects, cerr, suppress, istr);
+                                        connectionNew, dbName, "", purgeObjects, cerr, suppress, pipeline, progress,
+                                        istr);
 
         db.close(0);
     }
@@ -224,6 +228,8 @@ run(const Ice::StringSeq& originalArgs, const Ice::CommunicatorPtr& communicator
     bool purgeObjects;
     bool catastrophicRecover;
     bool suppress;
+    bool pipeline;
+    bool progress;
     string inputFile;
     vector<string> oldSlice;
     vector<string> newSlice;
@@ -246,6 +252,8 @@ run(const Ice::StringSeq& originalArgs, const Ice::CommunicatorPtr& communicator
     opts.addOpt("c");
     opts.addOpt("w");
     opts.addOpt("f", "", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "pipeline");
+    opts.addOpt("", "progress");
     opts.addOpt("", "include-old", IceUtilInternal::Options::NeedArg, "", IceUtilInternal::Options::Repeat);
     opts.addOpt("", "include-new", IceUtilInternal::Options::NeedArg, "", IceUtilInternal::Options::Repeat);
     opts.addOpt("", "old", IceUtilInternal::Options::NeedArg, "", IceUtilInternal::Options::Repeat);
@@ -308,6 +316,8 @@ run(const Ice::StringSeq& originalArgs, const Ice::CommunicatorPtr& communicator
     purgeObjects = opts.isSet("p");
     catastrophicRecover = opts.isSet("c");
     suppress = opts.isSet("w");
+    pipeline = opts.isSet("pipeline");
+    progress = opts.isSet("progress");
 
     if(opts.isSet("f"))
     {
@@ -834,13 +844,14 @@ run(const Ice::StringSeq& originalArgs, const Ice::CommunicatorPtr& communicator
             for(FreezeScript::CatalogDataMap::iterator p = catalog.begin(); p != catalog.end(); ++p)
             {
                 transformDb(p->second.evictor, communicator, objectFactory, dbEnv, dbEnvNew, p->first, connectionNew,
-                            dbs, oldUnit, newUnit, txnNew, purgeObjects, suppress, descriptors);
+                            dbs, oldUnit, newUnit, txnNew, purgeObjects, suppress, pipeline,
+                            progress, descriptors);
             }
         }
         else
         {
             transformDb(evictor, communicator, objectFactory, dbEnv, dbEnvNew, dbName, connectionNew, dbs,
-                        oldUnit, newUnit, txnNew, purgeObjects, suppress, descriptors);
+                        oldUnit, newUnit, txnNew, purgeObjects, suppress, pipeline, progress, descriptors);
         }
     }
     catch(const DbException& ex)
@@ -78,11 +78,60 @@ Glacier2::Blobject::updateObserver(const Glacier2::Instrumentation::SessionObser
     }
 }
 
+Ice::DispatchStatus
+Glacier2::Blobject::__dispatch(IceInternal::Incoming& in, const Current& current)
+{
+    //
+    // Same as Ice::BlobjectArrayAsync::__dispatch except that the AMD
+    // callback takes over the request message to forward it.
+    //
+    pair<const Byte*, const Byte*> inEncaps;
+    Int sz;
+    in.readParamEncaps(inEncaps.first, sz);
+    inEncaps.second = inEncaps.first + sz;
+    AMD_Object_ice_invokePtr cb = new RelayCallback(in);
+    try
+    {
+        ice_invoke_async(cb, inEncaps, current);
+    }
+    catch(const ::std::exception& ex)
+    {
+        cb->ice_exception(ex);
+    }
+    catch(...)
+    {
+        cb->ice_exception();
+    }
+    return DispatchAsync;
+}
+
 void
-Glacier2::Blobject::invokeResponse(bool ok, const pair<const Byte*, const Byte*>& outParams,
-                                   const AMD_Object_ice_invokePtr& amdCB)
+Glacier2::Blobject::invokeCompleted(const AsyncResultPtr& result)
 {
-    amdCB->ice_response(ok, outParams);
+    AMD_Object_ice_invokePtr amdCB = AMD_Object_ice_invokePtr::dynamicCast(result->getCookie());
+    assert(amdCB);
+
+    pair<const Byte*, const Byte*> outParams;
+    bool ok;
+    try
+    {
+        ok = result->getProxy()->___end_ice_invoke(outParams, result);
+    }
+    catch(const Exception& ex)
+    {
+        invokeException(ex, amdCB);
+        return;
+    }
+
+    RelayCallback* relayCB = dynamic_cast<RelayCallback*>(amdCB.get());
+    if(relayCB)
+    {
+        relayCB->ice_response(ok, outParams, *result->__getIs());
+    }
+    else
+    {
+        amdCB->ice_response(ok, outParams);
+    }
 }
 
 void
@@ -342,40 +391,44 @@ Glacier2::Blobject::invoke(ObjectPrx& proxy, const AMD_Object_ice_invokePtr& amd
 
         try
         {
-            Callback_Object_ice_invokePtr amiCB;
+            IceInternal::CallbackBasePtr amiCB;
             if(proxy->ice_isTwoway())
             {
-                amiCB = newCallback_Object_ice_invoke(this, &Blobject::invokeResponse, &Blobject::invokeException);
+                amiCB = newCallback(this, &Blobject::invokeCompleted);
             }
             else
             {
                 amiCB = newCallback_Object_ice_invoke(this, &Blobject::invokeException, &Blobject::invokeSent);
             }
 
+            Context ctx;
+            const Context* context = 0;
             if(_forwardContext)
             {
                 if(_context.size() > 0)
                 {
-                    Context ctx = current.ctx;
+                    ctx = current.ctx;
                     ctx.insert(_context.begin(), _context.end());
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, ctx, amiCB, amdCB);
+                    context = &ctx;
                 }
                 else
                 {
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, current.ctx, amiCB, amdCB);
+                    context = &current.ctx;
                 }
             }
-            else
+            else if(_context.size() > 0)
             {
-                if(_context.size() > 0)
-                {
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, _context, amiCB, amdCB);
-                }
-                else
-                {
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, amiCB, amdCB);
-                }
+                context = &_context;
             }
+
+            //
+            // Forward the request message held by the AMD callback,
+            // only its header is re-marshaled.
+            //
+            RelayCallback* relayCB = dynamic_cast<RelayCallback*>(amdCB.get());
+            IceInternal::Buffer message;
+            proxy->___begin_ice_invoke(current.operation, current.mode, inParams,
+                                       relayCB ? relayCB->request() : message, context, amiCB, amdCB);
         }
         catch(const LocalException& ex)
         {
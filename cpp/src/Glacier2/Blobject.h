@@ -27,9 +27,10 @@ public:
     void destroy();
     
     virtual void updateObserver(const Glacier2::Instrumentation::SessionObserverPtr&);
+
+    virtual Ice::DispatchStatus __dispatch(IceInternal::Incoming&, const Ice::Current&);
     
-    void invokeResponse(bool, const std::pair<const Ice::Byte*, const Ice::Byte*>&, 
-                        const Ice::AMD_Object_ice_invokePtr&);
+    void invokeCompleted(const Ice::AsyncResultPtr&);
     void invokeSent(bool, const Ice::AMD_Object_ice_invokePtr&);
     void invokeException(const Ice::Exception&, const Ice::AMD_Object_ice_invokePtr&);
 
@@ -22,6 +22,8 @@ const string serverSleepTime = "Glacier2.Server.SleepTime";
 const string clientSleepTime = "Glacier2.Client.SleepTime";
 const string serverBuffered = "Glacier2.Server.Buffered";
 const string clientBuffered = "Glacier2.Client.Buffered";
+const string clientCoalesce = "Glacier2.Client.Coalesce";
+const string clientCoalesceSize = "Glacier2.Client.CoalesceSize";
 
 }
 
@@ -51,7 +53,23 @@ Glacier2::Instance::Instance(const Ice::CommunicatorPtr& communicator, const Ice
     if(_properties->getPropertyAsIntWithDefault(clientBuffered, 1) > 0)
     {
         IceUtil::Time sleepTime = IceUtil::Time::milliSeconds(_properties->getPropertyAsInt(clientSleepTime));
-        const_cast<RequestQueueThreadPtr&>(_clientRequestQueueThread) = new RequestQueueThread(sleepTime);
+
+        //
+        // Oneway requests forwarded to the same back-end connection are
+        // coalesced into batches if enabled, a batch is sent once it
+        // reaches the coalesce size or after each flush of the queues.
+        //
+        Ice::Int coalesceSize = 0;
+        if(_properties->getPropertyAsInt(clientCoalesce) > 0)
+        {
+            coalesceSize = _properties->getPropertyAsIntWithDefault(clientCoalesceSize, 64 * 1024);
+            if(coalesceSize <= 0)
+            {
+                coalesceSize = 64 * 1024;
+            }
+        }
+        const_cast<RequestQueueThreadPtr&>(_clientRequestQueueThread) =
+            new RequestQueueThread(sleepTime, coalesceSize);
         try
         {
             _clientRequestQueueThread->start();
@@ -16,16 +16,60 @@ using namespace std;
 using namespace Ice;
 using namespace Glacier2;
 
+Glacier2::RelayCallback::RelayCallback(IceInternal::Incoming& in) :
+    IceAsync::Ice::AMD_Object_ice_invoke(in)
+{
+    in.swapRequest(_request);
+}
+
+void
+Glacier2::RelayCallback::ice_response(bool ok, const pair<const Byte*, const Byte*>& outEncaps,
+                                      IceInternal::BasicStream& reply)
+{
+    if(__validateResponse(ok))
+    {
+        try
+        {
+            __adoptParamEncaps(reply, outEncaps.first, static_cast<Int>(outEncaps.second - outEncaps.first), ok);
+        }
+        catch(const LocalException& ex)
+        {
+            __exception(ex);
+            return;
+        }
+        __response();
+    }
+}
+
 Glacier2::Request::Request(const ObjectPrx& proxy, const std::pair<const Byte*, const Byte*>& inParams,
                            const Current& current, bool forwardContext, const Ice::Context& sslContext,
                            const AMD_Object_ice_invokePtr& amdCB) :
     _proxy(proxy),
-    _inParams(inParams.first, inParams.second),
+    _inParams(inParams),
     _current(current),
     _forwardContext(forwardContext),
     _sslContext(sslContext),
-    _amdCB(amdCB)
+    _amdCB(amdCB),
+    _relayCB(RelayCallbackPtr::dynamicCast(amdCB))
 {
+    //
+    // The parameters are only kept by reference if the AMD callback
+    // holds the request message.
+    //
+    if(!_relayCB || _relayCB->request().b.empty())
+    {
+        _inParamsCopy.assign(inParams.first, inParams.second);
+        if(_inParamsCopy.empty())
+        {
+            _inParams.first = _inParams.second = 0;
+        }
+        else
+        {
+            _inParams.first = &_inParamsCopy[0];
+            _inParams.second = _inParams.first + _inParamsCopy.size();
+        }
+    }
+
     Context::const_iterator p = current.ctx.find("_ovrd");
     if(p != current.ctx.end())
     {
@@ -35,77 +79,103 @@ Glacier2::Request::Request(const ObjectPrx& proxy, const std::pair<const Byte*,
 
 
 Ice::AsyncResultPtr
-Glacier2::Request::invoke(const Callback_Object_ice_invokePtr& cb)
+Glacier2::Request::invoke(const Ice::CallbackPtr& cb)
 {
-    pair<const Byte*, const Byte*> inPair;
-    if(_inParams.size() == 0)
+    if(_proxy->ice_isBatchOneway() || _proxy->ice_isBatchDatagram())
     {
-        inPair.first = inPair.second = 0;
+        invokeBatch(_proxy);
+        return 0;
     }
     else
     {
-        inPair.first = &_inParams[0];
-        inPair.second = inPair.first + _inParams.size();
-    }
-
-    if(_proxy->ice_isBatchOneway() || _proxy->ice_isBatchDatagram())
-    {
-        ByteSeq outParams;
+        Ice::Context ctx;
+        const Ice::Context* context = 0;
         if(_forwardContext)
         { 
             if(_sslContext.size() > 0)
             {
-                Ice::Context ctx = _current.ctx;
+                ctx = _current.ctx;
                 ctx.insert(_sslContext.begin(), _sslContext.end());
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams, ctx);
+                context = &ctx;
             }
             else
             {
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams, _current.ctx);
+                context = &_current.ctx;
             }
         }
-        else
+        else if(_sslContext.size() > 0)
         {
-            if(_sslContext.size() > 0)
-            {
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams, _sslContext);
-            }
-            else
-            {
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams);
-            }
+            context = &_sslContext;
         }
+
+        //
+        // Forward the request message held by the AMD callback, only
+        // its header is re-marshaled.
+        //
+        IceInternal::Buffer message;
+        return _proxy->___begin_ice_invoke(_current.operation, _current.mode, _inParams,
+                                           _relayCB ? _relayCB->request() : message, context, cb, this);
+    }
+}
+
+Ice::ConnectionPtr
+Glacier2::Request::coalesce()
+{
+    assert(_proxy->ice_isOneway());
+
+    //
+    // The request is queued as a batch request on the back-end
+    // connection of its proxy, using a fixed proxy bound to this
+    // connection. If the proxy isn't connected yet, the request must
+    // be sent with a regular invocation to establish the connection.
+    //
+    Ice::ConnectionPtr connection = _proxy->ice_getCachedConnection();
+    if(!connection)
+    {
         return 0;
     }
+
+    Ice::ObjectPrx proxy = connection->createProxy(_proxy->ice_getIdentity());
+    proxy = proxy->ice_facet(_proxy->ice_getFacet());
+    proxy = proxy->ice_context(_proxy->ice_getContext());
+    proxy = proxy->ice_encodingVersion(_proxy->ice_getEncodingVersion());
+    invokeBatch(proxy->ice_batchOneway());
+    return connection;
+}
+
+Ice::Int
+Glacier2::Request::size() const
+{
+    return static_cast<Ice::Int>(_current.operation.size() + (_inParams.second - _inParams.first));
+}
+
+void
+Glacier2::Request::invokeBatch(const Ice::ObjectPrx& proxy)
+{
+    ByteSeq outParams;
+    if(_forwardContext)
+    { 
+        if(_sslContext.size() > 0)
+        {
+            Ice::Context ctx = _current.ctx;
+            ctx.insert(_sslContext.begin(), _sslContext.end());
+            proxy->ice_invoke(_current.operation, _current.mode, _inParams, outParams, ctx);
+        }
+        else
+        {
+            proxy->ice_invoke(_current.operation, _current.mode, _inParams, outParams, _current.ctx);
+        }
+    }
     else
     {
-        Ice::AsyncResultPtr result;
-        if(_forwardContext)
-        { 
-            if(_sslContext.size() > 0)
-            {
-                Ice::Context ctx = _current.ctx;
-                ctx.insert(_sslContext.begin(), _sslContext.end());
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, ctx, cb, this);
-            }
-            else
-            {
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, _current.ctx, cb, this);
-            }
+        if(_sslContext.size() > 0)
+        {
+            proxy->ice_invoke(_current.operation, _current.mode, _inParams, outParams, _sslContext);
         }
         else
         {
-            if(_sslContext.size() > 0)
-            {
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, _sslContext, cb, this);
-            }
-            else
-            {
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, cb, this);
-            }
+            proxy->ice_invoke(_current.operation, _current.mode, _inParams, outParams);
         }
-
-        return result;
     }
 }
 
@@ -144,10 +214,18 @@ Glacier2::Request::override(const RequestPtr& other) const
 }
 
 void
-Glacier2::Request::response(bool ok, const pair<const Ice::Byte*, const Ice::Byte*>& outParams)
+Glacier2::Request::response(bool ok, const pair<const Ice::Byte*, const Ice::Byte*>& outParams,
+                            IceInternal::BasicStream& reply)
 {
     assert(_proxy->ice_isTwoway());
-    _amdCB->ice_response(ok, outParams);
+    if(_relayCB)
+    {
+        _relayCB->ice_response(ok, outParams, reply);
+    }
+    else
+    {
+        _amdCB->ice_response(ok, outParams);
+    }
 }
 
 void
@@ -183,8 +261,7 @@ Glacier2::RequestQueue::RequestQueue(const RequestQueueThreadPtr& requestQueueTh
     _requestQueueThread(requestQueueThread),
     _instance(instance),
     _connection(connection),
-    _callback(newCallback_Object_ice_invoke(this, &RequestQueue::response, &RequestQueue::exception,
-                                            &RequestQueue::sent)),
+    _callback(newCallback(this, &RequestQueue::invokeCompleted, &RequestQueue::invokeSent)),
     _flushCallback(newCallback_Connection_flushBatchRequests(this, &RequestQueue::exception, &RequestQueue::sent)),
     _pendingSend(false),
     _destroyed(false)
@@ -237,7 +314,7 @@ Glacier2::RequestQueue::addRequest(const RequestPtr& request)
 }
 
 void
-Glacier2::RequestQueue::flushRequests(set<Ice::ObjectPrx>& batchProxies)
+Glacier2::RequestQueue::flushRequests(set<Ice::ObjectPrx>& batchProxies, BatchConnectionMap& batchConnections)
 {
     IceUtil::Mutex::Lock lock(*this);
     if(_connection)
@@ -250,7 +327,7 @@ Glacier2::RequestQueue::flushRequests(set<Ice::ObjectPrx>& batchProxies)
     }
     else
     {
-        flush(batchProxies);
+        flush(batchProxies, batchConnections);
     }
 }
 
@@ -288,7 +365,7 @@ Glacier2::RequestQueue::destroyInternal()
     //
     // Remove cyclic references.
     //
-    const_cast<Ice::Callback_Object_ice_invokePtr&>(_callback) = 0;
+    const_cast<Ice::CallbackPtr&>(_callback) = 0;
     const_cast<Ice::Callback_Connection_flushBatchRequestsPtr&>(_flushCallback) = 0;
 }
 
@@ -354,10 +431,11 @@ Glacier2::RequestQueue::flush()
 }
 
 void
-Glacier2::RequestQueue::flush(set<Ice::ObjectPrx>& batchProxies)
+Glacier2::RequestQueue::flush(set<Ice::ObjectPrx>& batchProxies, BatchConnectionMap& batchConnections)
 {
     assert(!_connection);
 
+    const Ice::Int coalesceSize = _requestQueueThread->coalesceSize();
     for(deque<RequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
     {
         try
@@ -366,6 +444,40 @@ Glacier2::RequestQueue::flush(set<Ice::ObjectPrx>& batchProxies)
             {
                 _observer->forwarded(!_connection);
             }
+
+            const Ice::ObjectPrx& proxy = (*p)->getProxy();
+            if(coalesceSize > 0 && proxy->ice_isOneway())
+            {
+                Ice::ConnectionPtr connection = (*p)->coalesce();
+                if(connection)
+                {
+                    Ice::Int& size = batchConnections[connection];
+                    size += (*p)->size();
+                    if(size >= coalesceSize)
+                    {
+                        batchConnections.erase(connection);
+                        connection->begin_flushBatchRequests();
+                    }
+                    continue;
+                }
+            }
+
+            if(!batchConnections.empty() && !proxy->ice_isBatchOneway() && !proxy->ice_isBatchDatagram())
+            {
+                //
+                // Flush the requests coalesced on the connection of
+                // this request first to preserve the ordering of the
+                // requests sent to the back-end server.
+                //
+                BatchConnectionMap::iterator q = batchConnections.find(proxy->ice_getCachedConnection());
+                if(q != batchConnections.end())
+                {
+                    Ice::ConnectionPtr connection = q->first;
+                    batchConnections.erase(q);
+                    connection->begin_flushBatchRequests();
+                }
+            }
+
             assert(_callback);
             Ice::AsyncResultPtr result = (*p)->invoke(_callback);
             if(!result)
@@ -387,10 +499,29 @@ Glacier2::RequestQueue::flush(set<Ice::ObjectPrx>& batchProxies)
 }
 
 void
-Glacier2::RequestQueue::response(bool ok, const pair<const Byte*, const Byte*>& outParams, const RequestPtr& request)
+Glacier2::RequestQueue::invokeCompleted(const Ice::AsyncResultPtr& result)
 {
+    RequestPtr request = RequestPtr::dynamicCast(result->getCookie());
     assert(request);
-    request->response(ok, outParams);
+
+    pair<const Byte*, const Byte*> outParams;
+    bool ok;
+    try
+    {
+        ok = result->getProxy()->___end_ice_invoke(outParams, result);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        exception(ex, request);
+        return;
+    }
+    request->response(ok, outParams, *result->__getIs());
+}
+
+void
+Glacier2::RequestQueue::invokeSent(const Ice::AsyncResultPtr& result)
+{
+    sent(result->sentSynchronously(), RequestPtr::dynamicCast(result->getCookie()));
 }
 
 void
@@ -440,9 +571,10 @@ Glacier2::RequestQueue::sent(bool sentSynchronously, const RequestPtr& request)
     }
 }
 
-Glacier2::RequestQueueThread::RequestQueueThread(const IceUtil::Time& sleepTime) :
+Glacier2::RequestQueueThread::RequestQueueThread(const IceUtil::Time& sleepTime, Ice::Int coalesceSize) :
     IceUtil::Thread("Glacier2 request queue thread"),
     _sleepTime(sleepTime),
+    _coalesceSize(coalesceSize),
     _destroy(false),
     _sleep(false)
 {
@@ -554,15 +686,21 @@ Glacier2::RequestQueueThread::run()
         }
         
         set<Ice::ObjectPrx> flushProxySet;
+        BatchConnectionMap flushConnectionMap;
         for(vector<RequestQueuePtr>::const_iterator p = queues.begin(); p != queues.end(); ++p)
         {
-            (*p)->flushRequests(flushProxySet);
+            (*p)->flushRequests(flushProxySet, flushConnectionMap);
         }
 
         for(set<Ice::ObjectPrx>::const_iterator q = flushProxySet.begin(); q != flushProxySet.end(); ++q)
         {
             (*q)->begin_ice_flushBatchRequests();
         }
+
+        for(BatchConnectionMap::const_iterator q = flushConnectionMap.begin(); q != flushConnectionMap.end(); ++q)
+        {
+            q->first->begin_flushBatchRequests();
+        }
     }
 }
 
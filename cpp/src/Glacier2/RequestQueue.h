@@ -17,6 +17,7 @@
 #include <Glacier2/Instrumentation.h>
 
 #include <deque>
+#include <map>
 
 namespace Glacier2
 {
@@ -30,6 +31,34 @@ typedef IceUtil::Handle<Request> RequestPtr;
 class RequestQueueThread;
 typedef IceUtil::Handle<RequestQueueThread> RequestQueueThreadPtr;
 
+//
+// The back-end connections with coalesced batch requests and the
+// size of the batch requests queued on each connection.
+//
+typedef std::map<Ice::ConnectionPtr, Ice::Int> BatchConnectionMap;
+
+//
+// The AMD callback of a routed request. It holds the received request
+// message, which allows to forward the request and its reply without
+// copying their encapsulation.
+//
+class RelayCallback : public IceAsync::Ice::AMD_Object_ice_invoke
+{
+public:
+
+    RelayCallback(IceInternal::Incoming&);
+
+    using IceAsync::Ice::AMD_Object_ice_invoke::ice_response;
+    void ice_response(bool, const std::pair<const Ice::Byte*, const Ice::Byte*>&, IceInternal::BasicStream&);
+
+    IceInternal::Buffer& request() { return _request; }
+
+private:
+
+    IceInternal::Buffer _request;
+};
+typedef IceUtil::Handle<RelayCallback> RelayCallbackPtr;
+
 class Request : public Ice::LocalObject
 {
 public:
@@ -37,25 +66,30 @@ public:
     Request(const Ice::ObjectPrx&, const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&, bool,
             const Ice::Context&, const Ice::AMD_Object_ice_invokePtr&);
     
-    Ice::AsyncResultPtr invoke(const Ice::Callback_Object_ice_invokePtr& callback);
+    Ice::AsyncResultPtr invoke(const Ice::CallbackPtr& callback);
+    Ice::ConnectionPtr coalesce();
     bool override(const RequestPtr&) const;
     const Ice::ObjectPrx& getProxy() const { return _proxy; }
     bool hasOverride() const { return !_override.empty(); }
+    Ice::Int size() const;
 
 private:
 
     friend class RequestQueue;
-    void response(bool, const std::pair<const Ice::Byte*, const Ice::Byte*>&);
+    void invokeBatch(const Ice::ObjectPrx&);
+    void response(bool, const std::pair<const Ice::Byte*, const Ice::Byte*>&, IceInternal::BasicStream&);
     void exception(const Ice::Exception&);
     void queued();
 
     const Ice::ObjectPrx _proxy;
-    const Ice::ByteSeq _inParams;
+    Ice::ByteSeq _inParamsCopy;
+    std::pair<const Ice::Byte*, const Ice::Byte*> _inParams;
     const Ice::Current _current;
     const bool _forwardContext;
     const Ice::Context _sslContext;
     const std::string _override;
     const Ice::AMD_Object_ice_invokePtr _amdCB;
+    const RelayCallbackPtr _relayCB;
 };
 
 class RequestQueue : public IceUtil::Mutex, public IceUtil::Shared
@@ -65,7 +99,7 @@ public:
     RequestQueue(const RequestQueueThreadPtr&, const InstancePtr&, const Ice::ConnectionPtr&);
 
     bool addRequest(const RequestPtr&);
-    void flushRequests(std::set<Ice::ObjectPrx>&);
+    void flushRequests(std::set<Ice::ObjectPrx>&, BatchConnectionMap&);
 
     void destroy();
 
@@ -76,16 +110,17 @@ private:
     void destroyInternal();
 
     void flush();
-    void flush(std::set<Ice::ObjectPrx>&);
+    void flush(std::set<Ice::ObjectPrx>&, BatchConnectionMap&);
 
-    void response(bool, const std::pair<const Ice::Byte*, const Ice::Byte*>&, const RequestPtr&);
+    void invokeCompleted(const Ice::AsyncResultPtr&);
+    void invokeSent(const Ice::AsyncResultPtr&);
     void exception(const Ice::Exception&, const RequestPtr&);
     void sent(bool, const RequestPtr&);
     
     const RequestQueueThreadPtr _requestQueueThread;
     const InstancePtr _instance;
     const Ice::ConnectionPtr _connection;
-    const Ice::Callback_Object_ice_invokePtr _callback;
+    const Ice::CallbackPtr _callback;
     const Ice::Callback_Connection_flushBatchRequestsPtr _flushCallback;
 
     std::deque<RequestPtr> _requests;
@@ -101,17 +136,24 @@ class RequestQueueThread : public IceUtil::Thread, public IceUtil::Monitor<IceUt
 {
 public:
 
-    RequestQueueThread(const IceUtil::Time&);
+    RequestQueueThread(const IceUtil::Time&, Ice::Int = 0);
     virtual ~RequestQueueThread();
 
     void flushRequestQueue(const RequestQueuePtr&);
     void destroy();
 
+    //
+    // Oneway requests are coalesced into batches of up to this size
+    // on their back-end connection if non-zero.
+    //
+    Ice::Int coalesceSize() const { return _coalesceSize; }
+
     virtual void run();
 
 private:
 
     const IceUtil::Time _sleepTime;
+    const Ice::Int _coalesceSize;
     bool _destroy;
     bool _sleep;
     IceUtil::Time _sleepDuration;
@@ -227,14 +227,14 @@ Glacier2::RouterI::getSession() const
 IceUtil::Time
 Glacier2::RouterI::getTimestamp() const
 {
-    // Can only be called with the SessionRouterI mutex locked
+    // Can only be called with the SessionTable shard mutex locked
     return _timestamp;
 }
 
 void
 Glacier2::RouterI::updateTimestamp() const
 {
-    // Can only be called with the SessionRouterI mutex locked
+    // Can only be called with the SessionTable shard mutex locked
     _timestamp = IceUtil::Time::now(IceUtil::Time::Monotonic);
 }
 
@@ -9,17 +9,49 @@
 
 #include <Glacier2/RoutingTable.h>
 #include <Glacier2/Instrumentation.h>
+#include <Ice/HashUtil.h>
+#include <IceUtil/UniquePtr.h>
+
+#include <algorithm>
 
 using namespace std;
 using namespace Ice;
 using namespace Glacier2;
 
+namespace
+{
+
+size_t
+hashIdentity(const Identity& ident)
+{
+    Int h = 5381;
+    IceInternal::hashAdd(h, ident.name);
+    IceInternal::hashAdd(h, ident.category);
+    return static_cast<size_t>(static_cast<unsigned int>(h));
+}
+
+}
+
 Glacier2::RoutingTable::RoutingTable(const CommunicatorPtr& communicator, const ProxyVerifierPtr& verifier) :
     _communicator(communicator),
     _traceLevel(_communicator->getProperties()->getPropertyAsInt("Glacier2.Trace.RoutingTable")),
     _maxSize(_communicator->getProperties()->getPropertyAsIntWithDefault("Glacier2.RoutingTable.MaxSize", 1000)),
-    _verifier(verifier)
+    _verifier(verifier),
+    _size(0),
+    _oldest(0),
+    _newest(0)
+{
+}
+
+Glacier2::RoutingTable::~RoutingTable()
 {
+    EvictorEntry* entry = _oldest;
+    while(entry)
+    {
+        EvictorEntry* next = entry->newer;
+        delete entry;
+        entry = next;
+    }
 }
 
 void
@@ -28,7 +60,7 @@ Glacier2::RoutingTable::destroy()
     IceUtil::Mutex::Lock sync(*this);
     if(_observer)
     {
-        _observer->routingTableSize(-static_cast<Ice::Int>(_map.size()));
+        _observer->routingTableSize(-static_cast<Ice::Int>(_size));
     }
     _observer.detach();
 }
@@ -39,7 +71,7 @@ Glacier2::RoutingTable::updateObserver(const Glacier2::Instrumentation::RouterOb
                                        const Ice::ConnectionPtr& connection)
 {
     IceUtil::Mutex::Lock sync(*this);
-    _observer.attach(obsv->getSessionObserver(userId, connection, static_cast<Ice::Int>(_map.size()), _observer.get()));
+    _observer.attach(obsv->getSessionObserver(userId, connection, static_cast<Ice::Int>(_size), _observer.get()));
     return _observer.get();
 }
 
@@ -48,37 +80,42 @@ Glacier2::RoutingTable::add(const ObjectProxySeq& unfiltered, const Current& cur
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    size_t sz = _map.size();
+    size_t sz = _size;
 
     //
     // We 'pre-scan' the list, applying our validation rules. The
     // ensures that our state is not modified if this operation results
     // in a rejection.
     //
-    ObjectProxySeq proxies; 
     for(ObjectProxySeq::const_iterator prx = unfiltered.begin(); prx != unfiltered.end(); ++prx)
     {
-        if(!*prx) // We ignore null proxies.
-        {
-            continue;
-        }
-
-        if(!_verifier->verify(*prx))
+        if(*prx && !_verifier->verify(*prx)) // We ignore null proxies.
         {
             current.con->close(true);
             throw ObjectNotExistException(__FILE__, __LINE__);
         }
-        ObjectPrx proxy = (*prx)->ice_twoway()->ice_secure(false)->ice_facet(""); // We add proxies in default form.
-        proxies.push_back(proxy);
     }
 
+    //
+    // Make sure the hash table is resized at most once for the whole
+    // sequence.
+    //
+    reserve(min(_size + unfiltered.size(), static_cast<size_t>(max(_maxSize, 0)) + 1));
+
     ObjectProxySeq evictedProxies;
-    for(ObjectProxySeq::const_iterator prx = proxies.begin(); prx != proxies.end(); ++prx)
+    for(ObjectProxySeq::const_iterator prx = unfiltered.begin(); prx != unfiltered.end(); ++prx)
     {
-        ObjectPrx proxy = *prx;
-        EvictorMap::iterator p = _map.find(proxy->ice_getIdentity());
+        if(!*prx)
+        {
+            continue;
+        }
+
+        ObjectPrx proxy = (*prx)->ice_twoway()->ice_secure(false)->ice_facet(""); // We add proxies in default form.
+        Identity ident = proxy->ice_getIdentity();
+        size_t hash = hashIdentity(ident);
+        EvictorEntry* entry = find(ident, hash);
         
-        if(p == _map.end())
+        if(!entry)
         {
             if(_traceLevel == 1 || _traceLevel >= 3)
             {
@@ -86,11 +123,17 @@ Glacier2::RoutingTable::add(const ObjectProxySeq& unfiltered, const Current& cur
                 out << "adding proxy to routing table:\n" << _communicator->proxyToString(proxy);
             }
             
-            EvictorEntryPtr entry = new EvictorEntry;
-            p = _map.insert(_map.begin(), pair<const Identity, EvictorEntryPtr>(proxy->ice_getIdentity(), entry));
-            EvictorQueue::iterator q = _queue.insert(_queue.end(), p);
-            entry->proxy = proxy;
-            entry->pos = q;
+            //
+            // Resize the hash table before creating the entry, the
+            // entry is only owned by the table once inserted.
+            //
+            reserve(_size + 1);
+            IceUtil::UniquePtr<EvictorEntry> newEntry(new EvictorEntry);
+            newEntry->identity = ident;
+            newEntry->proxy = proxy;
+            newEntry->hash = hash;
+            insert(newEntry.get());
+            newEntry.release();
         }
         else
         {
@@ -99,33 +142,29 @@ Glacier2::RoutingTable::add(const ObjectProxySeq& unfiltered, const Current& cur
                 Trace out(_communicator->getLogger(), "Glacier2");
                 out << "proxy already in routing table:\n" << _communicator->proxyToString(proxy);
             }
-            
-            EvictorEntryPtr entry = p->second;
-            _queue.erase(entry->pos);
-            EvictorQueue::iterator q = _queue.insert(_queue.end(), p);
-            entry->pos = q;
+            touch(entry);
         }
-        
-        while(static_cast<int>(_map.size()) > _maxSize)
+
+        while(static_cast<int>(_size) > _maxSize)
         {
-            p = _queue.front();
+            entry = _oldest;
             
             if(_traceLevel >= 2)
             {
                 Trace out(_communicator->getLogger(), "Glacier2");
-                out << "evicting proxy from routing table:\n" << _communicator->proxyToString(p->second->proxy);
+                out << "evicting proxy from routing table:\n" << _communicator->proxyToString(entry->proxy);
             }
             
-            evictedProxies.push_back(p->second->proxy);
+            evictedProxies.push_back(entry->proxy);
 
-            _map.erase(p);
-            _queue.pop_front();
+            remove(entry);
+            delete entry;
         }
     }
 
     if(_observer)
     {
-        _observer->routingTableSize(static_cast<Ice::Int>(_map.size()) - static_cast<Ice::Int>(sz));
+        _observer->routingTableSize(static_cast<Ice::Int>(_size) - static_cast<Ice::Int>(sz));
     }
 
     return evictedProxies;
@@ -139,21 +178,144 @@ Glacier2::RoutingTable::get(const Identity& ident)
         return 0;
     }
 
+    size_t hash = hashIdentity(ident);
+
     IceUtil::Mutex::Lock sync(*this);
 
-    EvictorMap::iterator p = _map.find(ident);
+    EvictorEntry* entry = find(ident, hash);
+    if(!entry)
+    {
+        return 0;
+    }
 
-    if(p == _map.end())
+    touch(entry);
+    return entry->proxy;
+}
+
+Glacier2::RoutingTable::EvictorEntry*
+Glacier2::RoutingTable::find(const Identity& ident, size_t hash) const
+{
+    if(_buckets.empty())
     {
         return 0;
     }
+
+    for(EvictorEntry* entry = _buckets[hash & (_buckets.size() - 1)]; entry; entry = entry->next)
+    {
+        if(entry->hash == hash && entry->identity == ident)
+        {
+            return entry;
+        }
+    }
+    return 0;
+}
+
+void
+Glacier2::RoutingTable::insert(EvictorEntry* entry)
+{
+    assert(_size < _buckets.size()); // The table must be reserved, inserting doesn't throw.
+
+    EvictorEntry*& bucket = _buckets[entry->hash & (_buckets.size() - 1)];
+    entry->next = bucket;
+    bucket = entry;
+
+    entry->older = _newest;
+    entry->newer = 0;
+    if(_newest)
+    {
+        _newest->newer = entry;
+    }
+    else
+    {
+        _oldest = entry;
+    }
+    _newest = entry;
+
+    ++_size;
+}
+
+void
+Glacier2::RoutingTable::remove(EvictorEntry* entry)
+{
+    EvictorEntry** p = &_buckets[entry->hash & (_buckets.size() - 1)];
+    while(*p != entry)
+    {
+        assert(*p);
+        p = &(*p)->next;
+    }
+    *p = entry->next;
+
+    if(entry->older)
+    {
+        entry->older->newer = entry->newer;
+    }
+    else
+    {
+        _oldest = entry->newer;
+    }
+    if(entry->newer)
+    {
+        entry->newer->older = entry->older;
+    }
+    else
+    {
+        _newest = entry->older;
+    }
+
+    --_size;
+}
+
+void
+Glacier2::RoutingTable::touch(EvictorEntry* entry)
+{
+    if(entry == _newest)
+    {
+        return;
+    }
+
+    //
+    // Move the entry to the most recently used end of the queue.
+    //
+    if(entry->older)
+    {
+        entry->older->newer = entry->newer;
+    }
     else
     {
-        EvictorEntryPtr entry = p->second;
-        _queue.erase(entry->pos);
-        EvictorQueue::iterator q = _queue.insert(_queue.end(), p);
-        entry->pos = q;
+        _oldest = entry->newer;
+    }
+    entry->newer->older = entry->older;
+
+    entry->older = _newest;
+    entry->newer = 0;
+    _newest->newer = entry;
+    _newest = entry;
+}
+
+void
+Glacier2::RoutingTable::reserve(size_t size)
+{
+    //
+    // The number of buckets is a power of two, the table is resized
+    // when there are more entries than buckets.
+    //
+    if(size <= _buckets.size())
+    {
+        return;
+    }
+
+    size_t count = _buckets.empty() ? 16 : _buckets.size();
+    while(count < size)
+    {
+        count *= 2;
+    }
 
-        return entry->proxy;
+    vector<EvictorEntry*> buckets(count, static_cast<EvictorEntry*>(0));
+    for(EvictorEntry* entry = _oldest; entry; entry = entry->newer)
+    {
+        EvictorEntry*& bucket = buckets[entry->hash & (count - 1)];
+        entry->next = bucket;
+        bucket = entry;
     }
+    _buckets.swap(buckets);
 }
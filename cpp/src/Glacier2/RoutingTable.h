@@ -17,7 +17,7 @@
 #include <Glacier2/ProxyVerifier.h>
 #include <Glacier2/Instrumentation.h>
 
-#include <list>
+#include <vector>
 
 namespace Glacier2
 {
@@ -30,6 +30,7 @@ class RoutingTable : public IceUtil::Shared, public IceUtil::Mutex
 public:
 
     RoutingTable(const Ice::CommunicatorPtr&, const ProxyVerifierPtr&);
+    virtual ~RoutingTable();
 
     void destroy();
 
@@ -47,21 +48,33 @@ private:
     const int _maxSize;
     const ProxyVerifierPtr _verifier; 
 
-    struct EvictorEntry;
-    typedef IceUtil::Handle<EvictorEntry> EvictorEntryPtr;
-
-    typedef std::map<Ice::Identity, EvictorEntryPtr> EvictorMap;
-    typedef std::list<EvictorMap::iterator> EvictorQueue;
-
-    friend struct EvictorEntry;
-    struct EvictorEntry : public IceUtil::Shared
+    //
+    // Each entry is linked both in the chain of its hash bucket and
+    // in the eviction queue, which is ordered from the least recently
+    // used to the most recently used entry. Looking up, touching and
+    // evicting an entry are constant time operations and adding a
+    // proxy only requires the allocation of its entry.
+    //
+    struct EvictorEntry
     {
+        Ice::Identity identity;
         Ice::ObjectPrx proxy;
-        EvictorQueue::iterator pos;
+        size_t hash;
+        EvictorEntry* next;
+        EvictorEntry* older;
+        EvictorEntry* newer;
     };
 
-    EvictorMap _map;
-    EvictorQueue _queue;
+    EvictorEntry* find(const Ice::Identity&, size_t) const;
+    void insert(EvictorEntry*);
+    void remove(EvictorEntry*);
+    void touch(EvictorEntry*);
+    void reserve(size_t);
+
+    std::vector<EvictorEntry*> _buckets;
+    size_t _size;
+    EvictorEntry* _oldest;
+    EvictorEntry* _newest;
 
     IceInternal::ObserverHelperT<Glacier2::Instrumentation::SessionObserver> _observer;
 };
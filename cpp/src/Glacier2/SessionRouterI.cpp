@@ -642,8 +642,6 @@ SessionRouterI::SessionRouterI(const InstancePtr& instance,
     _sessionTimeout(IceUtil::Time::seconds(_instance->properties()->getPropertyAsInt("Glacier2.SessionTimeout"))),
     _connectionCallback(new ConnectionCallbackI(this)),
     _sessionThread(_sessionTimeout > IceUtil::Time() ? new SessionThread(this, _sessionTimeout) : 0),
-    _routersByConnectionHint(_routersByConnection.end()),
-    _routersByCategoryHint(_routersByCategory.end()),
     _sessionDestroyCallback(newCallback_Session_destroy(this, &SessionRouterI::sessionDestroyException)),
     _destroy(false)
 {
@@ -704,7 +702,7 @@ SessionRouterI::~SessionRouterI()
 void
 SessionRouterI::destroy()
 {
-    map<ConnectionPtr, RouterIPtr> routers;
+    vector<RouterIPtr> routers;
     SessionThreadPtr sessionThread;
     Callback_Session_destroyPtr destroyCallback;
     {
@@ -714,11 +712,9 @@ SessionRouterI::destroy()
         _destroy = true;
         notify();
         
-        _routersByConnection.swap(routers);
-        _routersByConnectionHint = _routersByConnection.end();
-        
+        _routersByConnection.values(routers);
+        _routersByConnection.clear();
         _routersByCategory.clear();
-        _routersByCategoryHint = _routersByCategory.end();
         
         sessionThread = _sessionThread;
         _sessionThread = 0;
@@ -732,9 +728,9 @@ SessionRouterI::destroy()
     // We destroy the routers outside the thread synchronization, to
     // avoid deadlocks.
     //
-    for(map<ConnectionPtr, RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
+    for(vector<RouterIPtr>::const_iterator p = routers.begin(); p != routers.end(); ++p)
     {
-        p->second->destroy(destroyCallback);
+        (*p)->destroy(destroyCallback);
     }
 
     if(sessionThread)
@@ -852,15 +848,11 @@ SessionRouterI::destroySession(const Current& current)
 void
 SessionRouterI::refreshSession_async(const AMD_Router_refreshSessionPtr& callback, const Ice::Current& current)
 {
-    RouterIPtr router;
+    RouterIPtr router = getRouterImpl(current.con, current.id, false); // getRouter updates the session timestamp.
+    if(!router)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        router = getRouterImpl(current.con, current.id, false); // getRouter updates the session timestamp.
-        if(!router)
-        {
-            callback->ice_exception(SessionNotExistException());
-            return;
-        }
+        callback->ice_exception(SessionNotExistException());
+        return;
     }
 
     SessionPrx session = router->getSession();
@@ -881,19 +873,15 @@ SessionRouterI::refreshSession_async(const AMD_Router_refreshSessionPtr& callbac
 void
 SessionRouterI::refreshSession(const Ice::ConnectionPtr& con)
 {
-    RouterIPtr router;
+    RouterIPtr router = getRouterImpl(con, Ice::Identity(), false); // getRouter updates the session timestamp.
+    if(!router)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        router = getRouterImpl(con, Ice::Identity(), false); // getRouter updates the session timestamp.
-        if(!router)
-        {
-            //
-            // Close the connection otherwise the peer has no way to know that the
-            // session has gone.
-            //
-            con->close(false);
-            throw SessionNotExistException();
-        }
+        //
+        // Close the connection otherwise the peer has no way to know that the
+        // session has gone.
+        //
+        con->close(false);
+        throw SessionNotExistException();
     }
 
     SessionPrx session = router->getSession();
@@ -919,33 +907,17 @@ SessionRouterI::destroySession(const ConnectionPtr& connection)
             throw ObjectNotExistException(__FILE__, __LINE__);
         }
         
-        map<ConnectionPtr, RouterIPtr>::iterator p;    
-        
-        if(_routersByConnectionHint != _routersByConnection.end() && _routersByConnectionHint->first == connection)
-        {
-            p = _routersByConnectionHint;
-        }
-        else
-        {
-            p = _routersByConnection.find(connection);
-        }
-        
-        if(p == _routersByConnection.end())
+        router = _routersByConnection.erase(connection);
+        if(!router)
         {
             throw SessionNotExistException();
         }
-        
-        router = p->second;
 
-        _routersByConnection.erase(p++);
-        _routersByConnectionHint = p;
-        
         if(_instance->serverObjectAdapter())
         {
             string category = router->getServerProxy(Current())->ice_getIdentity().category;
             assert(!category.empty());
             _routersByCategory.erase(category);
-            _routersByCategoryHint = _routersByCategory.end();
         }
     }
 
@@ -981,54 +953,39 @@ SessionRouterI::updateSessionObservers()
     Glacier2::Instrumentation::RouterObserverPtr observer = _instance->getObserver();
     assert(observer);
 
-    for(map<ConnectionPtr, RouterIPtr>::iterator p = _routersByConnection.begin(); p != _routersByConnection.end(); ++p)
+    vector<RouterIPtr> routers;
+    _routersByConnection.values(routers);
+    for(vector<RouterIPtr>::const_iterator p = routers.begin(); p != routers.end(); ++p)
     {
-        p->second->updateObserver(observer);
-    }   
+        (*p)->updateObserver(observer);
+    }
 }
 
 RouterIPtr
 SessionRouterI::getRouter(const ConnectionPtr& connection, const Ice::Identity& id, bool close) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
     return getRouterImpl(connection, id, close);
 }
 
 Ice::ObjectPtr
 SessionRouterI::getClientBlobject(const ConnectionPtr& connection, const Ice::Identity& id) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
     return getRouterImpl(connection, id, true)->getClientBlobject();
 }
 
 Ice::ObjectPtr
 SessionRouterI::getServerBlobject(const string& category) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-
-    if(_destroy)
-    {
-        throw ObjectNotExistException(__FILE__, __LINE__);
-    }
-
-    map<string, RouterIPtr>& routers = const_cast<map<string, RouterIPtr>&>(_routersByCategory);
-
-    if(_routersByCategoryHint != routers.end() && _routersByCategoryHint->first == category)
-    {
-        return _routersByCategoryHint->second->getServerBlobject();
-    }
-    
-    map<string, RouterIPtr>::iterator p = routers.find(category);
-
-    if(p != routers.end())
-    {
-        _routersByCategoryHint = p;
-        return p->second->getServerBlobject();
-    }
-    else
+    //
+    // The category table is emptied when the router is destroyed so
+    // there's no need to check for destruction here.
+    //
+    RouterIPtr router = _routersByCategory.find(category);
+    if(!router)
     {
         throw ObjectNotExistException(__FILE__, __LINE__);
     }
+    return router->getServerBlobject();
 }
 
 void
@@ -1047,29 +1004,15 @@ SessionRouterI::expireSessions()
         assert(_sessionTimeout > IceUtil::Time());
         IceUtil::Time minTimestamp = IceUtil::Time::now(IceUtil::Time::Monotonic) - _sessionTimeout;
         
-        map<ConnectionPtr, RouterIPtr>::iterator p = _routersByConnection.begin();
-        
-        while(p != _routersByConnection.end())
+        _routersByConnection.expire(minTimestamp, routers);
+
+        if(_instance->serverObjectAdapter())
         {
-            if(p->second->getTimestamp() < minTimestamp)
-            {
-                RouterIPtr router = p->second;
-                routers.push_back(router);
-                
-                _routersByConnection.erase(p++);
-                _routersByConnectionHint = p;
-                
-                if(_instance->serverObjectAdapter())
-                {
-                    string category = router->getServerProxy(Current())->ice_getIdentity().category;
-                    assert(!category.empty());
-                    _routersByCategory.erase(category);
-                    _routersByCategoryHint = _routersByCategory.end();
-                }
-            }
-            else
+            for(vector<RouterIPtr>::const_iterator p = routers.begin(); p != routers.end(); ++p)
             {
-                ++p;
+                string category = (*p)->getServerProxy(Current())->ice_getIdentity().category;
+                assert(!category.empty());
+                _routersByCategory.erase(category);
             }
         }
     }
@@ -1092,28 +1035,25 @@ SessionRouterI::expireSessions()
 RouterIPtr
 SessionRouterI::getRouterImpl(const ConnectionPtr& connection, const Ice::Identity& id, bool close) const
 {
-    if(_destroy)
+    RouterIPtr router = _routersByConnection.find(connection, true);
+    if(router)
     {
-        throw ObjectNotExistException(__FILE__, __LINE__);
+        return router;
     }
 
-    map<ConnectionPtr, RouterIPtr>& routers = const_cast<map<ConnectionPtr, RouterIPtr>&>(_routersByConnection);
-
-    if(_routersByConnectionHint != routers.end() && _routersByConnectionHint->first == connection)
+    //
+    // The connection table is emptied when the router is destroyed,
+    // only check for destruction if the lookup failed.
+    //
     {
-        _routersByConnectionHint->second->updateTimestamp();
-        return _routersByConnectionHint->second;
+        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+        if(_destroy)
+        {
+            throw ObjectNotExistException(__FILE__, __LINE__);
+        }
     }
-    
-    map<ConnectionPtr, RouterIPtr>::iterator p = routers.find(connection);
 
-    if(p != routers.end())
-    {
-        _routersByConnectionHint = p;
-        p->second->updateTimestamp();
-        return p->second;
-    }
-    else if(close)
+    if(close)
     {
         if(_rejectTraceLevel >= 1)
         {
@@ -1152,24 +1092,11 @@ SessionRouterI::startCreateSession(const CreateSessionPtr& cb, const ConnectionP
     //
     // Check whether a session already exists for the connection.
     //
+    if(_routersByConnection.find(connection))
     {
-        map<ConnectionPtr, RouterIPtr>::iterator p;    
-        if(_routersByConnectionHint != _routersByConnection.end() &&
-           _routersByConnectionHint->first == connection)
-        {
-            p = _routersByConnectionHint;
-        }
-        else
-        {
-            p = _routersByConnection.find(connection);
-        }
-            
-        if(p != _routersByConnection.end())
-        {
-            CannotCreateSessionException exc;
-            exc.reason = "session exists";
-            throw exc;
-        }
+        CannotCreateSessionException exc;
+        exc.reason = "session exists";
+        throw exc;
     }
 
     map<ConnectionPtr, CreateSessionPtr>::iterator p = _pending.find(connection);
@@ -1220,17 +1147,17 @@ SessionRouterI::finishCreateSession(const ConnectionPtr& connection, const Route
         throw exc;
     }
     
-    _routersByConnectionHint = _routersByConnection.insert(
-        _routersByConnectionHint, pair<const ConnectionPtr, RouterIPtr>(connection, router));
+    _routersByConnection.insert(connection, router);
     
     if(_instance->serverObjectAdapter())
     {
         string category = router->getServerProxy()->ice_getIdentity().category;
         assert(!category.empty());
-        pair<map<string, RouterIPtr>::iterator, bool> rc = 
-            _routersByCategory.insert(pair<const string, RouterIPtr>(category, router));
-        assert(rc.second);
-        _routersByCategoryHint = rc.first;
+#ifndef NDEBUG
+        bool inserted =
+#endif
+            _routersByCategory.insert(category, router);
+        assert(inserted);
     }
 
     connection->setCallback(_connectionCallback);
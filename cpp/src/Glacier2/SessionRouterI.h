@@ -19,6 +19,7 @@
 #include <Glacier2/PermissionsVerifierF.h>
 #include <Glacier2/Router.h>
 #include <Glacier2/Instrumentation.h>
+#include <Glacier2/SessionTable.h>
 
 #include <set>
 
@@ -169,11 +170,14 @@ private:
     typedef IceUtil::Handle<SessionThread> SessionThreadPtr;
     SessionThreadPtr _sessionThread;
 
-    std::map<Ice::ConnectionPtr, RouterIPtr> _routersByConnection;
-    mutable std::map<Ice::ConnectionPtr, RouterIPtr>::iterator _routersByConnectionHint;
-
-    std::map<std::string, RouterIPtr> _routersByCategory;
-    mutable std::map<std::string, RouterIPtr>::iterator _routersByCategoryHint;
+    //
+    // The router tables have their own synchronization, lookups on
+    // the request forwarding path don't lock the session router.
+    // Insertions and removals are still performed with the session
+    // router locked to keep both tables consistent.
+    //
+    RoutersByConnection _routersByConnection;
+    RoutersByCategory _routersByCategory;
 
     std::map<Ice::ConnectionPtr, CreateSessionPtr> _pending;
     
@@ -0,0 +1,249 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef GLACIER2_SESSION_TABLE_H
+#define GLACIER2_SESSION_TABLE_H
+
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+
+#include <Ice/Ice.h>
+#include <Ice/HashUtil.h>
+
+#include <map>
+#include <vector>
+
+namespace Glacier2
+{
+
+class RouterI;
+typedef IceUtil::Handle<RouterI> RouterIPtr;
+
+//
+// Hash functions used to pick the shard of a session table entry.
+//
+struct ConnectionHash
+{
+    size_t operator()(const Ice::ConnectionPtr& connection) const
+    {
+        //
+        // Connections are heap allocated so the low bits of the
+        // address carry no information, fold the upper bits in.
+        //
+        size_t h = reinterpret_cast<size_t>(connection.get());
+        return h ^ (h >> 6) ^ (h >> 12);
+    }
+};
+
+struct CategoryHash
+{
+    size_t operator()(const std::string& category) const
+    {
+        Ice::Int h = 5381;
+        IceInternal::hashAdd(h, category);
+        return static_cast<size_t>(static_cast<unsigned int>(h));
+    }
+};
+
+//
+// A table of routers split into independently locked shards. The
+// session router looks up the router of every forwarded request in
+// these tables, sharding them ensures that concurrent lookups and
+// session creation or destruction don't all contend on a single
+// mutex.
+//
+template<typename K, typename H>
+class SessionTable : private IceUtil::noncopyable
+{
+public:
+
+    //
+    // Returns the router associated with the given key or 0 if
+    // there's none. If touch is true, the router's timestamp is
+    // updated while the shard is locked.
+    //
+    RouterIPtr
+    find(const K& key, bool touch = false) const
+    {
+        const Shard& shard = getShard(key);
+        IceUtil::Mutex::Lock sync(shard.mutex);
+
+        Map& routers = const_cast<Map&>(shard.routers);
+        typename Map::iterator p;
+        if(shard.hint != routers.end() && shard.hint->first == key)
+        {
+            p = shard.hint;
+        }
+        else
+        {
+            p = routers.find(key);
+            if(p == routers.end())
+            {
+                return 0;
+            }
+            shard.hint = p;
+        }
+
+        if(touch)
+        {
+            p->second->updateTimestamp();
+        }
+        return p->second;
+    }
+
+    bool
+    insert(const K& key, const RouterIPtr& router)
+    {
+        Shard& shard = getShard(key);
+        IceUtil::Mutex::Lock sync(shard.mutex);
+        std::pair<typename Map::iterator, bool> rc = shard.routers.insert(std::make_pair(key, router));
+        if(rc.second)
+        {
+            shard.hint = rc.first;
+        }
+        return rc.second;
+    }
+
+    //
+    // Removes and returns the router associated with the given key,
+    // returns 0 if there's none.
+    //
+    RouterIPtr
+    erase(const K& key)
+    {
+        Shard& shard = getShard(key);
+        IceUtil::Mutex::Lock sync(shard.mutex);
+
+        typename Map::iterator p;
+        if(shard.hint != shard.routers.end() && shard.hint->first == key)
+        {
+            p = shard.hint;
+        }
+        else
+        {
+            p = shard.routers.find(key);
+            if(p == shard.routers.end())
+            {
+                return 0;
+            }
+        }
+
+        RouterIPtr router = p->second;
+        shard.routers.erase(p++);
+        shard.hint = p;
+        return router;
+    }
+
+    //
+    // Removes the routers whose timestamp is older than the given
+    // time and adds them to the expired sequence.
+    //
+    void
+    expire(const IceUtil::Time& minTimestamp, std::vector<RouterIPtr>& expired)
+    {
+        for(size_t i = 0; i < ShardCount; ++i)
+        {
+            Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+
+            typename Map::iterator p = shard.routers.begin();
+            while(p != shard.routers.end())
+            {
+                if(p->second->getTimestamp() < minTimestamp)
+                {
+                    expired.push_back(p->second);
+                    shard.routers.erase(p++);
+                }
+                else
+                {
+                    ++p;
+                }
+            }
+            shard.hint = shard.routers.end();
+        }
+    }
+
+    void
+    values(std::vector<RouterIPtr>& routers) const
+    {
+        for(size_t i = 0; i < ShardCount; ++i)
+        {
+            const Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+            for(typename Map::const_iterator p = shard.routers.begin(); p != shard.routers.end(); ++p)
+            {
+                routers.push_back(p->second);
+            }
+        }
+    }
+
+    void
+    clear()
+    {
+        for(size_t i = 0; i < ShardCount; ++i)
+        {
+            Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+            shard.routers.clear();
+            shard.hint = shard.routers.end();
+        }
+    }
+
+    bool
+    empty() const
+    {
+        for(size_t i = 0; i < ShardCount; ++i)
+        {
+            IceUtil::Mutex::Lock sync(_shards[i].mutex);
+            if(!_shards[i].routers.empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    typedef std::map<K, RouterIPtr> Map;
+
+    static const size_t ShardCount = 64;
+
+    struct Shard
+    {
+        Shard() : hint(routers.end())
+        {
+        }
+
+        IceUtil::Mutex mutex;
+        Map routers;
+        mutable typename Map::iterator hint;
+    };
+
+    Shard&
+    getShard(const K& key)
+    {
+        return _shards[H()(key) % ShardCount];
+    }
+
+    const Shard&
+    getShard(const K& key) const
+    {
+        return _shards[H()(key) % ShardCount];
+    }
+
+    Shard _shards[ShardCount];
+};
+
+typedef SessionTable<Ice::ConnectionPtr, ConnectionHash> RoutersByConnection;
+typedef SessionTable<std::string, CategoryHash> RoutersByCategory;
+
+}
+
+#endif
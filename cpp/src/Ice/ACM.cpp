@@ -69,7 +69,7 @@ IceInternal::ACMConfig::ACMConfig(const Ice::PropertiesPtr& p,
 }
 
 IceInternal::FactoryACMMonitor::FactoryACMMonitor(const InstancePtr& instance, const ACMConfig& config) :
-    _instance(instance), _config(config)
+    _instance(instance), _config(config), _scheduled(false)
 {
 }
 
@@ -77,7 +77,7 @@ IceInternal::FactoryACMMonitor::~FactoryACMMonitor()
 {
     assert(!_instance);
     assert(_connections.empty());
-    assert(_changes.empty());
+    assert(_deadlines.empty());
     assert(_reapedConnections.empty());
 }
 
@@ -92,7 +92,7 @@ IceInternal::FactoryACMMonitor::destroy()
 
     _instance = 0;
     _connections.clear();
-    _changes.clear();
+    _deadlines.clear();
 }
 
 void
@@ -104,15 +104,7 @@ IceInternal::FactoryACMMonitor::add(const ConnectionIPtr& connection)
     }
 
     Lock sync(*this);
-    if(_connections.empty())
-    {
-        _connections.insert(connection);
-        _instance->timer()->scheduleRepeated(this, _config.timeout / 2);
-    }
-    else
-    {
-        _changes.push_back(make_pair(connection, true));
-    }
+    schedule(connection, IceUtil::Time::now(IceUtil::Time::Monotonic) + _config.timeout / 2);
 }
 
 void
@@ -125,7 +117,7 @@ IceInternal::FactoryACMMonitor::remove(const ConnectionIPtr& connection)
 
     Lock sync(*this);
     assert(_instance);
-    _changes.push_back(make_pair(connection, false));
+    _connections.erase(connection);
 }
 
 void
@@ -135,6 +127,26 @@ IceInternal::FactoryACMMonitor::reap(const ConnectionIPtr& connection)
     _reapedConnections.push_back(connection);
 }
 
+void
+IceInternal::FactoryACMMonitor::activity(const ConnectionIPtr& connection)
+{
+    Lock sync(*this);
+    if(!_instance)
+    {
+        return;
+    }
+
+    //
+    // The connection is used again after being idle, check it once
+    // again in (timeout / 2) unless it's already scheduled.
+    //
+    map<ConnectionIPtr, IceUtil::Time>::const_iterator p = _connections.find(connection);
+    if(p != _connections.end() && p->second == IceUtil::Time())
+    {
+        schedule(connection, IceUtil::Time::now(IceUtil::Time::Monotonic) + _config.timeout / 2);
+    }
+}
+
 ACMMonitorPtr
 IceInternal::FactoryACMMonitor::acm(const IceUtil::Optional<int>& timeout, 
                                     const IceUtil::Optional<Ice::ACMClose>& close, 
@@ -179,54 +191,106 @@ IceInternal::FactoryACMMonitor::swapReapedConnections(vector<ConnectionIPtr>& co
 void
 IceInternal::FactoryACMMonitor::runTimerTask()
 {
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    vector<ConnectionIPtr> connections;
     {
         Lock sync(*this);
+        _scheduled = false;
         if(!_instance)
         {
             return;
         }
 
-        for(vector<pair<ConnectionIPtr, bool> >::const_iterator p = _changes.begin(); p != _changes.end(); ++p)
+        //
+        // Only the connections whose deadline is reached are checked,
+        // their deadline is reset while they are being monitored.
+        //
+        while(!_deadlines.empty() && _deadlines.front().first <= now)
         {
-            if(p->second)
+            map<ConnectionIPtr, IceUtil::Time>::iterator p = _connections.find(_deadlines.front().second);
+            if(p != _connections.end() && p->second == _deadlines.front().first)
             {
-                _connections.insert(p->first);
-            }
-            else
-            {
-                _connections.erase(p->first);
+                p->second = IceUtil::Time();
+                connections.push_back(p->first);
             }
-        }
-        _changes.clear();
-
-        if(_connections.empty())
-        {
-            _instance->timer()->cancel(this);
-            return;
+            _deadlines.pop_front();
         }
     }
 
-        
     //
     // Monitor connections outside the thread synchronization, so
     // that connections can be added or removed during monitoring.
     //
-    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-    for(set<ConnectionIPtr>::const_iterator p = _connections.begin(); p != _connections.end(); ++p)
+    vector<IceUtil::Time> deadlines;
+    deadlines.reserve(connections.size());
+    for(vector<ConnectionIPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
     {
         try
-        {          
-            (*p)->monitor(now, _config);
+        {
+            deadlines.push_back((*p)->monitor(now, _config));
         }
         catch(const exception& ex)
-        {   
+        {
             handleException(ex);
+            deadlines.push_back(now + _config.timeout / 2);
         }
         catch(...)
         {
             handleException();
+            deadlines.push_back(now + _config.timeout / 2);
+        }
+    }
+
+    //
+    // The deadlines returned by the connections are relative to the
+    // time the monitoring started. Monitoring many connections takes
+    // time, the deadlines are pushed back by the monitoring duration
+    // to keep the deadlines queue in time order with the connections
+    // scheduled meanwhile.
+    //
+    IceUtil::Time monitored = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+    Lock sync(*this);
+    if(!_instance)
+    {
+        return;
+    }
+
+    //
+    // Schedule the next check of the connections which weren't
+    // removed or scheduled again while being monitored. A connection
+    // without deadline notifies the monitor when it's used again.
+    //
+    for(vector<ConnectionIPtr>::size_type i = 0; i < connections.size(); ++i)
+    {
+        if(deadlines[i] != IceUtil::Time())
+        {
+            map<ConnectionIPtr, IceUtil::Time>::const_iterator p = _connections.find(connections[i]);
+            if(p != _connections.end() && p->second == IceUtil::Time())
+            {
+                schedule(connections[i], deadlines[i] + (monitored - now));
+            }
         }
     }
+
+    if(!_scheduled && !_deadlines.empty())
+    {
+        _instance->timer()->schedule(this, max(_deadlines.front().first - monitored, IceUtil::Time()));
+        _scheduled = true;
+    }
+}
+
+void
+IceInternal::FactoryACMMonitor::schedule(const ConnectionIPtr& connection, const IceUtil::Time& deadline)
+{
+    _connections[connection] = deadline;
+    _deadlines.push_back(make_pair(deadline, connection));
+    if(!_scheduled)
+    {
+        _instance->timer()->schedule(this, max(deadline - IceUtil::Time::now(IceUtil::Time::Monotonic),
+                                               IceUtil::Time()));
+        _scheduled = true;
+    }
 }
 
 void
@@ -297,6 +361,14 @@ IceInternal::ConnectionACMMonitor::reap(const ConnectionIPtr& connection)
     _parent->reap(connection);
 }
 
+void
+IceInternal::ConnectionACMMonitor::activity(const ConnectionIPtr&)
+{
+    //
+    // Nothing to do, the connection is checked every (timeout / 2).
+    //
+}
+
 ACMMonitorPtr
 IceInternal::ConnectionACMMonitor::acm(const IceUtil::Optional<int>& timeout, 
                                        const IceUtil::Optional<Ice::ACMClose>& close, 
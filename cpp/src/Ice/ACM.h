@@ -19,7 +19,8 @@
 #include <Ice/InstanceF.h>
 #include <Ice/PropertiesF.h>
 #include <Ice/LoggerF.h>
-#include <set>
+#include <deque>
+#include <map>
 
 namespace IceInternal
 {
@@ -43,6 +44,7 @@ public:
     virtual void add(const Ice::ConnectionIPtr&) = 0;
     virtual void remove(const Ice::ConnectionIPtr&) = 0;
     virtual void reap(const Ice::ConnectionIPtr&) = 0;
+    virtual void activity(const Ice::ConnectionIPtr&) = 0;
 
     virtual ACMMonitorPtr acm(const IceUtil::Optional<int>&, 
                               const IceUtil::Optional<Ice::ACMClose>&, 
@@ -60,6 +62,7 @@ public:
     virtual void add(const Ice::ConnectionIPtr&);
     virtual void remove(const Ice::ConnectionIPtr&);
     virtual void reap(const Ice::ConnectionIPtr&);
+    virtual void activity(const Ice::ConnectionIPtr&);
 
     virtual ACMMonitorPtr acm(const IceUtil::Optional<int>&, 
                               const IceUtil::Optional<Ice::ACMClose>&, 
@@ -77,11 +80,22 @@ private:
 
     virtual void runTimerTask();
 
+    void schedule(const Ice::ConnectionIPtr&, const IceUtil::Time&);
+
     InstancePtr _instance;
     const ACMConfig _config;
 
-    std::vector<std::pair<Ice::ConnectionIPtr, bool> > _changes;
-    std::set<Ice::ConnectionIPtr> _connections;
+    //
+    // The connections are associated with the time of their next
+    // check or with a null time if the connection doesn't need to be
+    // checked until it's used again. A connection is always checked
+    // again (timeout / 2) after it was last checked or used so the
+    // deadlines queue is kept in time order without sorting, its
+    // stale entries are skipped.
+    //
+    std::map<Ice::ConnectionIPtr, IceUtil::Time> _connections;
+    std::deque<std::pair<IceUtil::Time, Ice::ConnectionIPtr> > _deadlines;
+    bool _scheduled;
     std::vector<Ice::ConnectionIPtr> _reapedConnections;
 };
 
@@ -95,6 +109,7 @@ public:
     virtual void add(const Ice::ConnectionIPtr&);
     virtual void remove(const Ice::ConnectionIPtr&);
     virtual void reap(const Ice::ConnectionIPtr&);
+    virtual void activity(const Ice::ConnectionIPtr&);
 
     virtual ACMMonitorPtr acm(const IceUtil::Optional<int>&, 
                               const IceUtil::Optional<Ice::ACMClose>&, 
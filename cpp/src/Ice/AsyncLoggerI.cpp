@@ -0,0 +1,285 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceUtil/Time.h>
+#include <Ice/AsyncLoggerI.h>
+#include <Ice/LocalException.h>
+
+#include <sstream>
+#include <time.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceInternal::LogWriter::LogWriter(const string& file, size_t queueSizeMax, bool drop, Ice::Long sizeMax) :
+    IceUtil::Thread("Ice.LogWriter"),
+    _file(file),
+    _queueSizeMax(queueSizeMax > 0 ? queueSizeMax : 1),
+    _drop(drop),
+    _sizeMax(sizeMax),
+    _size(0),
+    _dropped(0),
+    _destroyed(false),
+    _finished(false)
+{
+    _out.open(file, fstream::out | fstream::app);
+    if(!_out.is_open())
+    {
+        throw InitializationException(__FILE__, __LINE__, "FileLogger: cannot open " + _file);
+    }
+
+    IceUtilInternal::structstat buf;
+    if(IceUtilInternal::stat(_file, &buf) == 0)
+    {
+        _size = static_cast<Ice::Long>(buf.st_size);
+    }
+}
+
+void
+IceInternal::LogWriter::write(string& message)
+{
+    Lock sync(*this);
+
+    if(!_finished && _queue.size() >= _queueSizeMax)
+    {
+        if(_drop)
+        {
+            ++_dropped;
+            return;
+        }
+
+        while(!_finished && _queue.size() >= _queueSizeMax)
+        {
+            wait();
+        }
+    }
+
+    if(_finished)
+    {
+        //
+        // The writer thread is gone, write the message directly.
+        //
+        vector<string> messages(1);
+        messages.back().swap(message);
+        writeMessages(messages, 0);
+        return;
+    }
+
+    if(_queue.empty())
+    {
+        notifyAll();
+    }
+    _queue.push_back(string());
+    _queue.back().swap(message);
+}
+
+void
+IceInternal::LogWriter::destroy()
+{
+    {
+        Lock sync(*this);
+        if(_destroyed)
+        {
+            return;
+        }
+        _destroyed = true;
+        notifyAll();
+    }
+
+    getThreadControl().join();
+}
+
+void
+IceInternal::LogWriter::run()
+{
+    vector<string> messages;
+    while(true)
+    {
+        size_t dropped;
+        {
+            Lock sync(*this);
+            while(_queue.empty() && !_destroyed)
+            {
+                wait();
+            }
+
+            if(_queue.empty())
+            {
+                _finished = true;
+                notifyAll();
+                return;
+            }
+
+            messages.swap(_queue);
+            dropped = _dropped;
+            _dropped = 0;
+            notifyAll(); // Wake up the loggers waiting for room in the queue.
+        }
+
+        writeMessages(messages, dropped);
+        messages.clear();
+    }
+}
+
+void
+IceInternal::LogWriter::writeMessages(const vector<string>& messages, size_t dropped)
+{
+    for(vector<string>::const_iterator p = messages.begin(); p != messages.end(); ++p)
+    {
+        writeMessage(*p);
+    }
+
+    //
+    // The messages are only dropped once the queue is full so the
+    // dropped messages were logged after the queued ones.
+    //
+    if(dropped > 0)
+    {
+        ostringstream os;
+        os << "-! " << IceUtil::Time::now().toDateTime() << " warning: " << dropped
+           << " log messages were dropped because the log queue was full";
+        writeMessage(os.str());
+    }
+    _out.flush();
+}
+
+void
+IceInternal::LogWriter::writeMessage(const string& message)
+{
+    Ice::Long size = static_cast<Ice::Long>(message.size() + 1);
+    if(_sizeMax > 0 && _size > 0 && _size + size > _sizeMax)
+    {
+        rotate();
+    }
+    _out << message << '\n';
+    _size += size;
+}
+
+void
+IceInternal::LogWriter::rotate()
+{
+    _out.close();
+
+    //
+    // Rename the log file to <basename>-<date>[-<id>]<extension>.
+    //
+    time_t now = static_cast<time_t>(IceUtil::Time::now().toSeconds());
+    struct tm* t;
+#ifdef _WIN32
+    t = localtime(&now);
+#else
+    struct tm tr;
+    localtime_r(&now, &tr);
+    t = &tr;
+#endif
+    char date[32];
+    strftime(date, sizeof(date), "%Y%m%d-%H%M%S", t);
+
+    string basename = _file;
+    string extension;
+    string::size_type dot = _file.rfind('.');
+    string::size_type sep = _file.find_last_of("/\\");
+    if(dot != string::npos && (sep == string::npos || dot > sep))
+    {
+        basename = _file.substr(0, dot);
+        extension = _file.substr(dot);
+    }
+
+    string archive = basename + "-" + date + extension;
+    for(int id = 1; IceUtilInternal::fileExists(archive); ++id)
+    {
+        ostringstream os;
+        os << basename << "-" << date << "-" << id << extension;
+        archive = os.str();
+    }
+
+    //
+    // If the file can't be renamed we keep appending to it.
+    //
+    IceUtilInternal::rename(_file, archive);
+    _out.open(_file, fstream::out | fstream::app);
+    _size = 0;
+}
+
+Ice::AsyncLoggerI::AsyncLoggerI(const string& prefix, const LogWriterPtr& writer) :
+    _prefix(prefix),
+    _writer(writer)
+{
+    if(!prefix.empty())
+    {
+        _formattedPrefix = prefix + ": ";
+    }
+}
+
+void
+Ice::AsyncLoggerI::print(const string& message)
+{
+    string s = message;
+    write(s, false);
+}
+
+void
+Ice::AsyncLoggerI::trace(const string& category, const string& message)
+{
+    string s = "-- " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix;
+    if(!category.empty())
+    {
+        s += category + ": ";
+    }
+    s += message;
+
+    write(s, true);
+}
+
+void
+Ice::AsyncLoggerI::warning(const string& message)
+{
+    string s = "-! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "warning: " + message;
+    write(s, true);
+}
+
+void
+Ice::AsyncLoggerI::error(const string& message)
+{
+    string s = "!! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "error: " + message;
+    write(s, true);
+}
+
+string
+Ice::AsyncLoggerI::getPrefix()
+{
+    return _prefix;
+}
+
+LoggerPtr
+Ice::AsyncLoggerI::cloneWithPrefix(const std::string& prefix)
+{
+    return new AsyncLoggerI(prefix, _writer);
+}
+
+void
+Ice::AsyncLoggerI::write(string& s, bool indent)
+{
+    //
+    // The message is formatted by the calling thread, the writer
+    // thread only writes it to the file.
+    //
+    if(indent)
+    {
+        string::size_type idx = 0;
+        while((idx = s.find("\n", idx)) != string::npos)
+        {
+            s.insert(idx + 1, "   ");
+            ++idx;
+        }
+    }
+
+    _writer->write(s);
+}
@@ -0,0 +1,89 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_ASYNC_LOGGER_I_H
+#define ICE_ASYNC_LOGGER_I_H
+
+#include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/FileUtil.h>
+#include <Ice/Logger.h>
+
+#include <vector>
+
+namespace IceInternal
+{
+
+//
+// The log writer thread writes the messages queued by the
+// asynchronous loggers to the log file. The messages are written in
+// batches and the file is rotated once it reaches its maximum size.
+//
+class LogWriter : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    LogWriter(const std::string&, size_t, bool, Ice::Long);
+
+    void write(std::string&);
+    void destroy();
+
+    virtual void run();
+
+private:
+
+    void writeMessages(const std::vector<std::string>&, size_t);
+    void writeMessage(const std::string&);
+    void rotate();
+
+    const std::string _file;
+    const size_t _queueSizeMax;
+    const bool _drop;
+    const Ice::Long _sizeMax;
+
+    IceUtilInternal::ofstream _out;
+    Ice::Long _size;
+
+    std::vector<std::string> _queue;
+    size_t _dropped;
+    bool _destroyed;
+    bool _finished;
+};
+typedef IceUtil::Handle<LogWriter> LogWriterPtr;
+
+}
+
+namespace Ice
+{
+
+class AsyncLoggerI : public Logger
+{
+public:
+
+    AsyncLoggerI(const std::string&, const IceInternal::LogWriterPtr&);
+
+    virtual void print(const std::string&);
+    virtual void trace(const std::string&, const std::string&);
+    virtual void warning(const std::string&);
+    virtual void error(const std::string&);
+    virtual std::string getPrefix();
+    virtual LoggerPtr cloneWithPrefix(const std::string&);
+
+private:
+
+    void write(std::string&, bool);
+
+    const std::string _prefix;
+    std::string _formattedPrefix;
+    const IceInternal::LogWriterPtr _writer;
+};
+
+}
+
+#endif
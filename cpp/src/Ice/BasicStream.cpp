@@ -12,6 +12,7 @@
 #include <Ice/DefaultsAndOverrides.h>
 #include <Ice/Instance.h>
 #include <Ice/Object.h>
+#include <Ice/GCObject.h>
 #include <Ice/Proxy.h>
 #include <Ice/ProxyFactory.h>
 #include <Ice/ObjectFactory.h>
@@ -1888,18 +1889,17 @@ IceInternal::BasicStream::EncapsDecoder::readTypeId(bool isIndex)
     if(isIndex)
     {
         Int index = _stream->readSize();
-        TypeIdReadMap::const_iterator k = _typeIdMap.find(index);
-        if(k == _typeIdMap.end())
+        if(index < 1 || static_cast<size_t>(index) > _typeIdMap.size())
         {
             throw UnmarshalOutOfBoundsException(__FILE__, __LINE__);
         }
-        return k->second;
+        return _typeIdMap[index - 1];
     }
     else
     {
         string typeId;
         _stream->read(typeId, false);
-        _typeIdMap.insert(make_pair(++_typeIdIndex, typeId));
+        _typeIdMap.push_back(typeId);
         return typeId;
     }
 }
@@ -1948,36 +1948,49 @@ IceInternal::BasicStream::EncapsDecoder::newInstance(const string& typeId)
     return v;
 }
 
+void
+IceInternal::BasicStream::EncapsDecoder::checkIndex(Int index) const
+{
+    //
+    // Each instance is encoded with at least one byte, an index
+    // larger than the stream size can't be valid.
+    //
+    if(index < 1 || static_cast<size_t>(index) > _stream->b.size())
+    {
+        throw MarshalException(__FILE__, __LINE__, "invalid object id");
+    }
+}
+
 void
 IceInternal::BasicStream::EncapsDecoder::addPatchEntry(Int index, PatchFunc patchFunc, void* patchAddr)
 {
     assert(index > 0);
+    checkIndex(index);
 
     //
     // Check if already un-marshalled the object. If that's the case,
     // just patch the object smart pointer and we're done.
     //
-    IndexToPtrMap::iterator p = _unmarshaledMap.find(index);
-    if(p != _unmarshaledMap.end())
+    Ice::ObjectPtr* v = _unmarshaledMap.find(index);
+    if(v && *v)
     {
-        (*patchFunc)(patchAddr, p->second);
+        (*patchFunc)(patchAddr, *v);
         return;
     }
 
     //
-    // Add patch entry if the object isn't un-marshalled yet, the
+    // Add a patch entry if the object isn't un-marshalled yet, the
     // smart pointer will be patched when the instance is
     // un-marshalled.
     //
-
-    PatchMap::iterator q = _patchMap.find(index);
-    if(q == _patchMap.end())
+    PatchList& patchList = _patchMap[index];
+    if(patchList.empty())
     {
         //
         // We have no outstanding instances to be patched for this
-        // index, so make a new entry in the patch map.
+        // index.
         //
-        q = _patchMap.insert(make_pair(index, PatchList())).first;
+        ++_patchCount;
     }
 
     //
@@ -1986,102 +1999,117 @@ IceInternal::BasicStream::EncapsDecoder::addPatchEntry(Int index, PatchFunc patc
     PatchEntry e;
     e.patchFunc = patchFunc;
     e.patchAddr = patchAddr;
-    q->second.push_back(e);
+    patchList.push_back(e);
+}
+
+namespace
+{
+
+//
+// Tracks the nesting of the instances being un-marshalled, the depth
+// is restored if reading an instance fails.
+//
+class UnmarshalDepthGuard : private IceUtil::noncopyable
+{
+public:
+
+    UnmarshalDepthGuard(int& depth) : _depth(depth)
+    {
+        ++_depth;
+    }
+
+    ~UnmarshalDepthGuard()
+    {
+        --_depth;
+    }
+
+private:
+
+    int& _depth;
+};
+
 }
 
 void
 IceInternal::BasicStream::EncapsDecoder::unmarshal(Int index, const Ice::ObjectPtr& v)
 {
     //
-    // Add the object to the map of un-marshalled objects, this must
+    // Add the object to the table of un-marshalled objects, this must
     // be done before reading the objects (for circular references).
     //
-    _unmarshaledMap.insert(make_pair(index, v));
+    checkIndex(index);
+    Ice::ObjectPtr& entry = _unmarshaledMap[index];
+    if(!entry)
+    {
+        entry = v;
+    }
 
     //
-    // Read the object.
+    // Read the object. The instances read while reading the object
+    // are only post-processed once the outermost instance is read.
     //
-    v->__read(_stream);
+    {
+        UnmarshalDepthGuard depthGuard(_unmarshalDepth);
+        v->__read(_stream);
+    }
 
     //
     // Patch all instances now that the object is un-marshalled.
     //
-    PatchMap::iterator patchPos = _patchMap.find(index);
-    if(patchPos != _patchMap.end())
+    PatchList* patchList = _patchMap.find(index);
+    if(patchList && !patchList->empty())
     {
-        assert(patchPos->second.size() > 0);
-
         //
         // Patch all pointers that refer to the instance.
         //
-        for(PatchList::iterator k = patchPos->second.begin(); k != patchPos->second.end(); ++k)
+        for(PatchList::iterator k = patchList->begin(); k != patchList->end(); ++k)
         {
             (*k->patchFunc)(k->patchAddr, v);
         }
 
         //
-        // Clear out the patch map for that index -- there is nothing left
-        // to patch for that index for the time being.
+        // Clear out the patch list for that index -- there is nothing
+        // left to patch for that index for the time being.
         //
-        _patchMap.erase(patchPos);
+        PatchList().swap(*patchList);
+        --_patchCount;
     }
 
-    if(_objectList.empty() && _patchMap.empty())
+    _objectList.push_back(v);
+
+    if(_unmarshalDepth == 0 && _patchCount == 0)
     {
-        try
-        {
-            if(_stream->instance()->collectObjects())
-            {
-                v->ice_collectable(true);
-            }
-            v->ice_postUnmarshal();
-        }
-        catch(const std::exception& ex)
-        {
-            Warning out(_stream->instance()->initializationData().logger);
-            out << "std::exception raised by ice_postUnmarshal:\n" << ex;
-        }
-        catch(...)
+        //
+        // Mark the object graph as collectable and invoke
+        // ice_postUnmarshal on each object. We must do this after all
+        // objects have been unmarshaled in order to ensure that any
+        // object data members have been properly patched. The graph
+        // is marked at once rather than object by object, marking
+        // each object visits all the objects reachable from it.
+        //
+        if(_stream->instance()->collectObjects())
         {
-            Warning out(_stream->instance()->initializationData().logger);
-            out << "unknown exception raised by ice_postUnmarshal";
+            GCObject::__gcMarkCollectable(_objectList);
         }
-    }
-    else
-    {
-        _objectList.push_back(v);
 
-        if(_patchMap.empty())
+        for(ObjectList::iterator p = _objectList.begin(); p != _objectList.end(); ++p)
         {
-            //
-            // Iterate over the object list and invoke ice_postUnmarshal on
-            // each object.  We must do this after all objects have been
-            // unmarshaled in order to ensure that any object data members
-            // have been properly patched.
-            //
-            for(ObjectList::iterator p = _objectList.begin(); p != _objectList.end(); ++p)
+            try
             {
-                try
-                {
-                    if(_stream->instance()->collectObjects())
-                    {
-                        (*p)->ice_collectable(true);
-                    }
-                    (*p)->ice_postUnmarshal();
-                }
-                catch(const std::exception& ex)
-                {
-                    Warning out(_stream->instance()->initializationData().logger);
-                    out << "std::exception raised by ice_postUnmarshal:\n" << ex;
-                }
-                catch(...)
-                {
-                    Warning out(_stream->instance()->initializationData().logger);
-                    out << "unknown exception raised by ice_postUnmarshal";
-                }
+                (*p)->ice_postUnmarshal();
+            }
+            catch(const std::exception& ex)
+            {
+                Warning out(_stream->instance()->initializationData().logger);
+                out << "std::exception raised by ice_postUnmarshal:\n" << ex;
+            }
+            catch(...)
+            {
+                Warning out(_stream->instance()->initializationData().logger);
+                out << "unknown exception raised by ice_postUnmarshal";
             }
-            _objectList.clear();
         }
+        _objectList.clear();
     }
 }
 
@@ -2308,7 +2336,7 @@ IceInternal::BasicStream::EncapsDecoder10::readPendingObjects()
     }
     while(num);
 
-    if(!_patchMap.empty())
+    if(_patchCount > 0)
     {
         //
         // If any entries remain in the patch map, the sender has sent an index for an object, but failed
@@ -2867,7 +2895,7 @@ IceInternal::BasicStream::EncapsDecoder11::readInstance(Int index, PatchFunc pat
     //
     unmarshal(index, v);
 
-    if(!_current && !_patchMap.empty())
+    if(!_current && _patchCount > 0)
     {
         //
         // If any entries remain in the patch map, the sender has sent an index for an object, but failed
@@ -111,6 +111,7 @@ private:
     const ConnectionCallbackPtr _heartbeatCallback;
     BasicStream _stream;
 };
+typedef IceUtil::Handle<DispatchCall> DispatchCallPtr;
 
 class FinishCall : public DispatchWorkItem
 {
@@ -544,13 +545,13 @@ Ice::ConnectionI::updateObserver()
                                                                                      _observer.get()));
 }
 
-void
+IceUtil::Time
 Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_state != StateActive)
     {
-        return;
+        return IceUtil::Time();
     }
     assert(acm.timeout != IceUtil::Time());
 
@@ -583,9 +584,10 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
         // This check is necessary because the actitivy timer is
         // only set when a message is fully read/written.
         //
-        return;
+        return now + acm.timeout / 2;
     }
 
+    bool idle = _dispatchCount == 0 && _batchRequestQueue->isEmpty() && _requests.empty() && _asyncRequests.empty();
     if(acm.close != CloseOff && now >= (_acmLastActivity + acm.timeout))
     {
         if(acm.close == CloseOnIdleForceful ||
@@ -596,16 +598,31 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
             // the last period.
             //
             setState(StateClosed, ConnectionTimeoutException(__FILE__, __LINE__));
+            return IceUtil::Time();
         }
-        else if(acm.close != CloseOnInvocation &&
-                _dispatchCount == 0 && _batchRequestQueue->isEmpty() && _requests.empty() && _asyncRequests.empty())
+        else if(acm.close != CloseOnInvocation && idle)
         {
             //
             // The connection is idle, close it.
             //
             setState(StateClosing, ConnectionTimeoutException(__FILE__, __LINE__));
+            return IceUtil::Time();
         }
     }
+
+    if(idle && (acm.heartbeat == HeartbeatOff || acm.heartbeat == HeartbeatOnInvocation) &&
+       (acm.close == CloseOff || acm.close == CloseOnInvocation))
+    {
+        //
+        // Neither a heartbeat nor the closure of the connection can
+        // occur until the connection is used again. The monitor
+        // doesn't need to check the connection until then, it's
+        // notified of the next activity instead.
+        //
+        _acmNotifyActivity = true;
+        return IceUtil::Time();
+    }
+    return now + acm.timeout / 2;
 }
 
 bool
@@ -1469,6 +1486,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
     OutgoingAsyncBasePtr outAsync;
     ConnectionCallbackPtr heartbeatCallback;
     int dispatchCount = 0;
+    vector<DispatchCallPtr> readAheadCalls;
 
     ThreadPoolMessage<ConnectionI> msg(current, *this);
 
@@ -1506,88 +1524,9 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                 }
             }
 
-            while(readyOp & SocketOperationRead)
+            if(readyOp & SocketOperationRead)
             {
-                if(_observer && !_readHeader)
-                {
-                    _observer.startRead(_readStream);
-                }
-
-                readOp = read(_readStream);
-                if(readOp & SocketOperationRead)
-                {
-                    break;
-                }
-                if(_observer && !_readHeader)
-                {
-                    assert(_readStream.i == _readStream.b.end());
-                    _observer.finishRead(_readStream);
-                }
-
-                if(_readHeader) // Read header if necessary.
-                {
-                    _readHeader = false;
-
-                    if(_observer)
-                    {
-                        _observer->receivedBytes(static_cast<int>(headerSize));
-                    }
-
-                    ptrdiff_t pos = _readStream.i - _readStream.b.begin();
-                    if(pos < headerSize)
-                    {
-                        //
-                        // This situation is possible for small UDP packets.
-                        //
-                        throw IllegalMessageSizeException(__FILE__, __LINE__);
-                    }
-
-                    _readStream.i = _readStream.b.begin();
-                    const Byte* m;
-                    _readStream.readBlob(m, static_cast<Int>(sizeof(magic)));
-                    if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
-                    {
-                        BadMagicException ex(__FILE__, __LINE__);
-                        ex.badMagic = Ice::ByteSeq(&m[0], &m[0] + sizeof(magic));
-                        throw ex;
-                    }
-                    ProtocolVersion pv;
-                    _readStream.read(pv);
-                    checkSupportedProtocol(pv);
-                    EncodingVersion ev;
-                    _readStream.read(ev);
-                    checkSupportedProtocolEncoding(ev);
-
-                    Byte messageType;
-                    _readStream.read(messageType);
-                    Byte compress;
-                    _readStream.read(compress);
-                    Int size;
-                    _readStream.read(size);
-                    if(size < headerSize)
-                    {
-                        throw IllegalMessageSizeException(__FILE__, __LINE__);
-                    }
-                    if(size > static_cast<Int>(_messageSizeMax))
-                    {
-                        Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
-                    }
-                    if(size > static_cast<Int>(_readStream.b.size()))
-                    {
-                        _readStream.b.resize(size);
-                    }
-                    _readStream.i = _readStream.b.begin() + pos;
-                }
-
-                if(_readStream.i != _readStream.b.end())
-                {
-                    if(_endpoint->datagram())
-                    {
-                        throw DatagramLimitException(__FILE__, __LINE__); // The message was truncated.
-                    }
-                    continue;
-                }
-                break;
+                readOp = readMessage();
             }
 
             SocketOperation newOp = static_cast<SocketOperation>(readOp | writeOp);
@@ -1651,6 +1590,57 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                                                                               outAsync,
                                                                               heartbeatCallback,
                                                                               dispatchCount));
+
+                    //
+                    // Parse the other complete messages from the read-ahead
+                    // buffer. They are dispatched in order by this thread after
+                    // the first message.
+                    //
+                    try
+                    {
+                        while((_state == StateActive || _state == StateClosing) && hasReadAheadMessage())
+                        {
+#ifdef NDEBUG
+                            readMessage();
+#else
+                            SocketOperation op = readMessage();
+                            assert(op == SocketOperationNone);
+#endif
+                            BasicStream stream(_instance.get(), currentProtocolEncoding);
+                            Int n = 0;
+                            Int rid = 0;
+                            Byte c = 0;
+                            ServantManagerPtr sm;
+                            ObjectAdapterPtr oa;
+                            OutgoingAsyncBasePtr o;
+                            ConnectionCallbackPtr hb;
+                            newOp = static_cast<SocketOperation>(newOp | parseMessage(stream, n, rid, c, sm, oa, o, hb,
+                                                                                      dispatchCount));
+                            if(n || o || hb)
+                            {
+                                readAheadCalls.push_back(new DispatchCall(this, 0, vector<OutgoingMessage>(), c, rid,
+                                                                          n, sm, oa, o, hb, stream));
+                            }
+                        }
+                    }
+                    catch(const LocalException& ex)
+                    {
+                        //
+                        // The messages already parsed must still be dispatched.
+                        //
+                        setState(StateClosed, ex);
+                    }
+
+                    //
+                    // Make sure the thread pool calls us again for the remaining
+                    // messages if we stopped parsing them (when holding for
+                    // instance). The flag is reset by the transceiver on the
+                    // next socket read.
+                    //
+                    if(hasReadAheadMessage())
+                    {
+                        _hasMoreData = true;
+                    }
                 }
 
                 if(readyOp & SocketOperationWrite)
@@ -1672,6 +1662,11 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
             if(_acmLastActivity != IceUtil::Time())
             {
                 _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(_acmNotifyActivity)
+                {
+                    _acmNotifyActivity = false;
+                    _monitor->activity(this);
+                }
             }
 
             if(dispatchCount == 0)
@@ -1724,12 +1719,20 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
     {
         dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
                  current.stream);
+        for(vector<DispatchCallPtr>::const_iterator p = readAheadCalls.begin(); p != readAheadCalls.end(); ++p)
+        {
+            (*p)->run();
+        }
     }
     else
     {
         _threadPool->dispatchFromThisThread(new DispatchCall(this, startCB, sentCBs, compress, requestId, invokeNum,
                                                              servantManager, adapter, outAsync, heartbeatCallback,
                                                              current.stream));
+        for(vector<DispatchCallPtr>::const_iterator p = readAheadCalls.begin(); p != readAheadCalls.end(); ++p)
+        {
+            _threadPool->dispatchFromThisThread(*p);
+        }
     }
 }
 
@@ -2121,6 +2124,7 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _readTimeoutScheduled(false),
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
+    _acmNotifyActivity(false),
     _compressionLevel(1),
     _nextRequestId(1),
     _requestsHint(_requests.end()),
@@ -2129,6 +2133,8 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
+    _readAheadSize(0),
+    _readAheadPos(0),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
     _dispatchCount(0),
     _state(StateNotInitialized),
@@ -2149,6 +2155,17 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
         compressionLevel = 9;
     }
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
+    if(!_endpoint->datagram())
+    {
+        Int readAheadSize = properties->getPropertyAsIntWithDefault("Ice.ReadAheadSize", 0);
+        if(readAheadSize > 0)
+        {
+            const_cast<size_t&>(_readAheadSize) = static_cast<size_t>(readAheadSize) * 1024;
+        }
+    }
+#endif
+
     if(adapter)
     {
         _servantManager = adapter->getServantManager();
@@ -2893,6 +2910,11 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
             if(_acmLastActivity != IceUtil::Time())
             {
                 _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(_acmNotifyActivity)
+                {
+                    _acmNotifyActivity = false;
+                    _monitor->activity(this);
+                }
             }
             return status;
         }
@@ -2954,6 +2976,11 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
             if(_acmLastActivity != IceUtil::Time())
             {
                 _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(_acmNotifyActivity)
+                {
+                    _acmNotifyActivity = false;
+                    _monitor->activity(this);
+                }
             }
             return status;
         }
@@ -3533,6 +3560,173 @@ ConnectionI::toConnectionState(State state) const
     return connectionStateMap[static_cast<int>(state)];
 }
 
+SocketOperation
+ConnectionI::readMessage()
+{
+    while(true)
+    {
+        if(_observer && !_readHeader)
+        {
+            _observer.startRead(_readStream);
+        }
+
+        SocketOperation op;
+        if(_readAheadSize > 0 && _state > StateNotValidated)
+        {
+            op = readAhead(_readStream);
+        }
+        else
+        {
+            op = read(_readStream);
+        }
+        if(op & SocketOperationRead)
+        {
+            return op;
+        }
+        if(_observer && !_readHeader)
+        {
+            assert(_readStream.i == _readStream.b.end());
+            _observer.finishRead(_readStream);
+        }
+
+        if(_readHeader) // Read header if necessary.
+        {
+            _readHeader = false;
+
+            if(_observer)
+            {
+                _observer->receivedBytes(static_cast<int>(headerSize));
+            }
+
+            ptrdiff_t pos = _readStream.i - _readStream.b.begin();
+            if(pos < headerSize)
+            {
+                //
+                // This situation is possible for small UDP packets.
+                //
+                throw IllegalMessageSizeException(__FILE__, __LINE__);
+            }
+
+            _readStream.i = _readStream.b.begin();
+            const Byte* m;
+            _readStream.readBlob(m, static_cast<Int>(sizeof(magic)));
+            if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
+            {
+                BadMagicException ex(__FILE__, __LINE__);
+                ex.badMagic = Ice::ByteSeq(&m[0], &m[0] + sizeof(magic));
+                throw ex;
+            }
+            ProtocolVersion pv;
+            _readStream.read(pv);
+            checkSupportedProtocol(pv);
+            EncodingVersion ev;
+            _readStream.read(ev);
+            checkSupportedProtocolEncoding(ev);
+
+            Byte messageType;
+            _readStream.read(messageType);
+            Byte compress;
+            _readStream.read(compress);
+            Int size;
+            _readStream.read(size);
+            if(size < headerSize)
+            {
+                throw IllegalMessageSizeException(__FILE__, __LINE__);
+            }
+            if(size > static_cast<Int>(_messageSizeMax))
+            {
+                Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
+            }
+            if(size > static_cast<Int>(_readStream.b.size()))
+            {
+                _readStream.b.resize(size);
+            }
+            _readStream.i = _readStream.b.begin() + pos;
+        }
+
+        if(_readStream.i != _readStream.b.end())
+        {
+            if(_endpoint->datagram())
+            {
+                throw DatagramLimitException(__FILE__, __LINE__); // The message was truncated.
+            }
+            continue;
+        }
+        return SocketOperationNone;
+    }
+}
+
+SocketOperation
+ConnectionI::readAhead(Buffer& buf)
+{
+    while(true)
+    {
+        //
+        // Copy the data already received in the read-ahead buffer.
+        //
+        size_t available = static_cast<size_t>(_readAhead.i - _readAheadPos);
+        if(available > 0)
+        {
+            size_t n = min(available, static_cast<size_t>(buf.b.end() - buf.i));
+            memcpy(buf.i, _readAheadPos, n);
+            buf.i += n;
+            _readAheadPos += n;
+            if(buf.i == buf.b.end())
+            {
+                return SocketOperationNone;
+            }
+        }
+
+        //
+        // The read-ahead buffer is empty. Large message bodies are read
+        // directly in the message buffer, otherwise we read as much as
+        // the transceiver has available in the read-ahead buffer.
+        //
+        if(static_cast<size_t>(buf.b.end() - buf.i) >= _readAheadSize)
+        {
+            return read(buf);
+        }
+
+        if(_readAhead.b.empty())
+        {
+            _readAhead.b.resize(_readAheadSize);
+        }
+        _readAhead.i = _readAhead.b.begin();
+        _readAheadPos = _readAhead.b.begin();
+        read(_readAhead);
+        if(_readAhead.i == _readAhead.b.begin())
+        {
+            return SocketOperationRead;
+        }
+    }
+}
+
+bool
+ConnectionI::hasReadAheadMessage() const
+{
+    if(!_readHeader || _readStream.i != _readStream.b.begin())
+    {
+        return false; // A message is being read.
+    }
+
+    ptrdiff_t available = _readAhead.i - _readAheadPos;
+    if(available < headerSize)
+    {
+        return false;
+    }
+
+    //
+    // The message size is the last field of the header, encoded in
+    // little endian.
+    //
+    const Byte* p = _readAheadPos + headerSize - 4;
+    Int size = static_cast<Int>(static_cast<unsigned int>(p[0]) |
+                                static_cast<unsigned int>(p[1]) << 8 |
+                                static_cast<unsigned int>(p[2]) << 16 |
+                                static_cast<unsigned int>(p[3]) << 24);
+    return size <= available;
+}
+
 SocketOperation
 ConnectionI::read(Buffer& buf)
 {
@@ -165,7 +165,7 @@ public:
 
     void updateObserver();
 
-    void monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
+    IceUtil::Time monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
 
     bool sendRequest(IceInternal::OutgoingBase*, bool, bool, int);
     IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
@@ -289,6 +289,10 @@ private:
     Ice::ConnectionInfoPtr initConnectionInfo() const;
     Ice::Instrumentation::ConnectionState toConnectionState(State) const;
 
+    IceInternal::SocketOperation readMessage();
+    IceInternal::SocketOperation readAhead(IceInternal::Buffer&);
+    bool hasReadAheadMessage() const;
+
     IceInternal::SocketOperation read(IceInternal::Buffer&);
     IceInternal::SocketOperation write(IceInternal::Buffer&);
 
@@ -327,6 +331,7 @@ private:
     const bool _warnUdp;
 
     IceUtil::Time _acmLastActivity;
+    bool _acmNotifyActivity;
 
     const int _compressionLevel;
 
@@ -347,6 +352,16 @@ private:
 
     IceInternal::BasicStream _readStream;
     bool _readHeader;
+
+    //
+    // With Ice.ReadAheadSize, the connection reads as much data as
+    // available in the read-ahead buffer and parses all the complete
+    // messages it contains at once.
+    //
+    const size_t _readAheadSize;
+    IceInternal::Buffer _readAhead;
+    IceInternal::Buffer::Container::iterator _readAheadPos;
+
     IceInternal::BasicStream _writeStream;
 
     Observer _observer;
@@ -374,6 +374,27 @@ GCObject::ice_collectable(bool enable)
     }
 }
 
+void
+GCObject::__gcMarkCollectable(const vector<Ice::ObjectPtr>& objects)
+{
+    //
+    // The objects are new and can only be referenced by objects from
+    // the graph. Unlike ice_collectable(true), we don't need to clear
+    // the flags before marking the objects and each object is visited
+    // once: objects already marked from a previous object of the graph
+    // are skipped.
+    //
+    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(gcMutex);
+    for(vector<Ice::ObjectPtr>::const_iterator p = objects.begin(); p != objects.end(); ++p)
+    {
+        GCObject* obj = dynamic_cast<GCObject*>(p->get());
+        if(obj)
+        {
+            MarkCollectable().visit(obj);
+        }
+    }
+}
+
 bool
 GCObject::collect(IceUtilInternal::MutexPtrLock<IceUtil::Mutex>& lock)
 {
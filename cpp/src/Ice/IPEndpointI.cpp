@@ -13,6 +13,7 @@
 #include <Ice/LocalException.h>
 #include <Ice/PropertiesI.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/TraceLevels.h>
 #include <Ice/HashUtil.h>
 #include <Ice/NetworkProxy.h>
 #include <IceUtil/MutexPtrLock.h>
@@ -499,25 +500,47 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, Basic
 #ifndef ICE_OS_WINRT
 
 IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& instance) :
-    IceUtil::Thread("Ice.HostResolver"),
     _instance(instance),
     _protocol(instance->protocolSupport()),
     _preferIPv6(instance->preferIPv6()),
+    _cacheTimeout(IceUtil::Time::seconds(
+        instance->initializationData().properties->getPropertyAsInt("Ice.HostResolver.CacheTimeout"))),
+    _negativeCacheTimeout(IceUtil::Time::seconds(
+        instance->initializationData().properties->getPropertyAsInt("Ice.HostResolver.NegativeCacheTimeout"))),
     _destroyed(false)
 {
+    const Ice::PropertiesPtr& properties = _instance->initializationData().properties;
+    int size = properties->getPropertyAsIntWithDefault("Ice.HostResolver.Size", 1);
+    if(size < 1)
+    {
+        Ice::Warning out(_instance->initializationData().logger);
+        out << "Ice.HostResolver.Size < 1; Size adjusted to 1";
+        size = 1;
+    }
+
     __setNoDelete(true);
     try
     {
-        updateObserver();
-        bool hasPriority = _instance->initializationData().properties->getProperty("Ice.ThreadPriority") != "";
-        int priority = _instance->initializationData().properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
+        bool hasPriority = properties->getProperty("Ice.ThreadPriority") != "";
+        int priority = properties->getPropertyAsInt("Ice.ThreadPriority");
+        for(int i = 0; i < size; ++i)
         {
-            start(0, priority);
-        }
-        else
-        {
-            start();
+            ostringstream os;
+            os << "Ice.HostResolver";
+            if(size > 1)
+            {
+                os << "-" << i;
+            }
+            HelperThreadPtr thread = new HelperThread(this, os.str());
+            if(hasPriority)
+            {
+                thread->start(0, priority);
+            }
+            else
+            {
+                thread->start();
+            }
+            _threads.push_back(thread);
         }
     }
     catch(const IceUtil::Exception& ex)
@@ -526,6 +549,8 @@ IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& insta
             Ice::Error out(_instance->initializationData().logger);
             out << "cannot create thread for enpoint host resolver:\n" << ex;
         }
+        destroy();
+        joinWithAllThreads();
         throw;
     }
     __setNoDelete(false);
@@ -558,28 +583,60 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
         }
     }
 
-    Lock sync(*this);
-    assert(!_destroyed);
-
     ResolveEntry entry;
-    entry.host = host;
     entry.port = port;
     entry.selType = selType;
     entry.endpoint = endpoint;
     entry.callback = callback;
 
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
-    if(obsv)
+    CacheEntryPtr cached;
     {
-        entry.observer = obsv->getEndpointLookupObserver(endpoint);
-        if(entry.observer)
+        Lock sync(*this);
+        assert(!_destroyed);
+
+        map<string, CacheEntryPtr>::iterator p = _cache.find(host);
+        if(p != _cache.end())
+        {
+            if(p->second->expirationTime > IceUtil::Time::now(IceUtil::Time::Monotonic))
+            {
+                cached = p->second;
+            }
+            else
+            {
+                _cache.erase(p);
+            }
+        }
+
+        if(!cached)
         {
-            entry.observer->attach();
+            const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+            if(obsv)
+            {
+                entry.observer = obsv->getEndpointLookupObserver(endpoint);
+                if(entry.observer)
+                {
+                    entry.observer->attach();
+                }
+            }
+
+            //
+            // Only queue the host if it's not already queued or being
+            // resolved, the request is answered with the result of the
+            // pending lookup otherwise.
+            //
+            map<string, vector<ResolveEntry> >::iterator q = _pending.find(host);
+            if(q == _pending.end())
+            {
+                q = _pending.insert(make_pair(host, vector<ResolveEntry>())).first;
+                _queue.push_back(host);
+                notify();
+            }
+            q->second.push_back(entry);
+            return;
         }
     }
 
-    _queue.push_back(entry);
-    notify();
+    resolved(vector<ResolveEntry>(1, entry), cached);
 }
 
 void
@@ -588,15 +645,46 @@ IceInternal::EndpointHostResolver::destroy()
     Lock sync(*this);
     assert(!_destroyed);
     _destroyed = true;
-    notify();
+    notifyAll();
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithAllThreads()
+{
+    //
+    // We don't need to lock the mutex here, the threads are only
+    // created by the constructor and the resolver is destroyed.
+    //
+    for(vector<HelperThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    _threads.clear();
+
+    for(map<string, vector<ResolveEntry> >::const_iterator p = _pending.begin(); p != _pending.end(); ++p)
+    {
+        for(vector<ResolveEntry>::const_iterator q = p->second.begin(); q != p->second.end(); ++q)
+        {
+            Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
+            if(q->observer)
+            {
+                q->observer->failed(ex.ice_name());
+                q->observer->detach();
+            }
+            q->callback->exception(ex);
+        }
+    }
+    _pending.clear();
+    _queue.clear();
+    _cache.clear();
+}
+
+void
+IceInternal::EndpointHostResolver::run(const HelperThreadPtr& thread)
 {
     while(true)
     {
-        ResolveEntry r;
+        string host;
         ThreadObserverPtr threadObserver;
         {
             Lock sync(*this);
@@ -610,9 +698,9 @@ IceInternal::EndpointHostResolver::run()
                 break;
             }
 
-            r = _queue.front();
+            host = _queue.front();
             _queue.pop_front();
-            threadObserver = _observer.get();
+            threadObserver = thread->_observer.get();
         }
 
         if(threadObserver)
@@ -620,67 +708,121 @@ IceInternal::EndpointHostResolver::run()
             threadObserver->stateChanged(ThreadStateIdle, ThreadStateInUseForOther);
         }
 
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        CacheEntryPtr result = new CacheEntry;
+        result->protocol = _protocol;
         try
         {
             NetworkProxyPtr networkProxy = _instance->networkProxy();
-            ProtocolSupport protocol = _protocol;
             if(networkProxy)
             {
                 networkProxy = networkProxy->resolveHost(_protocol);
                 if(networkProxy)
                 {
-                    protocol = networkProxy->getProtocolSupport();
+                    result->protocol = networkProxy->getProtocolSupport();
                 }
             }
 
-            r.callback->connectors(r.endpoint->connectors(getAddresses(r.host,
-                                                                       r.port,
-                                                                       protocol,
-                                                                       r.selType,
-                                                                       _preferIPv6,
-                                                                       true),
-                                                          networkProxy));
+            result->addresses = getAddresses(host, 0, result->protocol, Ice::Ordered, _preferIPv6, true);
+            result->networkProxy = networkProxy;
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            result->exception.reset(ex.ice_clone());
+        }
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
 
-            if(threadObserver)
+        if(_instance->traceLevels()->network >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            if(result->exception)
             {
-                threadObserver->stateChanged(ThreadStateInUseForOther, ThreadStateIdle);
+                out << "failed to resolve host `" << host << "' in " << (now - start).toMilliSecondsDouble()
+                    << "ms\n" << *result->exception;
             }
-
-            if(r.observer)
+            else
             {
-                r.observer->detach();
+                out << "resolved host `" << host << "' in " << (now - start).toMilliSecondsDouble() << "ms";
             }
         }
-        catch(const Ice::LocalException& ex)
+
+        vector<ResolveEntry> entries;
         {
-            if(threadObserver)
+            Lock sync(*this);
+            map<string, vector<ResolveEntry> >::iterator p = _pending.find(host);
+            assert(p != _pending.end());
+            entries.swap(p->second);
+            _pending.erase(p);
+
+            //
+            // Only DNS failures are cached, other failures (to resolve
+            // the network proxy host for instance) might be transient.
+            //
+            IceUtil::Time timeout = _cacheTimeout;
+            if(result->exception)
             {
-                threadObserver->stateChanged(ThreadStateInUseForOther, ThreadStateIdle);
+                timeout = dynamic_cast<Ice::DNSException*>(result->exception.get()) ? _negativeCacheTimeout :
+                    IceUtil::Time();
             }
-            if(r.observer)
+            if(timeout > IceUtil::Time())
             {
-                r.observer->failed(ex.ice_name());
-                r.observer->detach();
+                result->expirationTime = now + timeout;
+                _cache[host] = result;
             }
-            r.callback->exception(ex);
         }
-    }
 
-    for(deque<ResolveEntry>::const_iterator p = _queue.begin(); p != _queue.end(); ++p)
-    {
-        Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
-        if(p->observer)
+        resolved(entries, result);
+
+        if(threadObserver)
         {
-            p->observer->failed(ex.ice_name());
-            p->observer->detach();
+            threadObserver->stateChanged(ThreadStateInUseForOther, ThreadStateIdle);
         }
-        p->callback->exception(ex);
     }
-    _queue.clear();
 
-    if(_observer)
+    if(thread->_observer)
     {
-        _observer.detach();
+        thread->_observer.detach();
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::resolved(const vector<ResolveEntry>& entries, const CacheEntryPtr& result)
+{
+    for(vector<ResolveEntry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        try
+        {
+            if(result->exception)
+            {
+                result->exception->ice_throw();
+            }
+
+            vector<Address> addresses = result->addresses;
+            for(vector<Address>::iterator q = addresses.begin(); q != addresses.end(); ++q)
+            {
+                setPort(*q, p->port);
+            }
+            if(p->selType == Ice::Random)
+            {
+                sortAddresses(addresses, result->protocol, p->selType, _preferIPv6);
+            }
+
+            p->callback->connectors(p->endpoint->connectors(addresses, result->networkProxy));
+
+            if(p->observer)
+            {
+                p->observer->detach();
+            }
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            if(p->observer)
+            {
+                p->observer->failed(ex.ice_name());
+                p->observer->detach();
+            }
+            p->callback->exception(ex);
+        }
     }
 }
 
@@ -688,7 +830,31 @@ void
 IceInternal::EndpointHostResolver::updateObserver()
 {
     Lock sync(*this);
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    for(vector<HelperThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->updateObserver();
+    }
+}
+
+IceInternal::EndpointHostResolver::HelperThread::HelperThread(const EndpointHostResolverPtr& resolver,
+                                                              const string& name) :
+    IceUtil::Thread(name),
+    _resolver(resolver)
+{
+    updateObserver();
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::run()
+{
+    _resolver->run(this);
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::updateObserver()
+{
+    // Must be called with the resolver mutex locked
+    const CommunicatorObserverPtr& obsv = _resolver->_instance->initializationData().observer;
     if(obsv)
     {
         _observer.attach(obsv->getThreadObserver("Communicator", name(), ThreadStateIdle, _observer.get()));
@@ -727,7 +893,7 @@ IceInternal::EndpointHostResolver::destroy()
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithAllThreads()
 {
 }
 
@@ -21,7 +21,11 @@
 #include <Ice/ObserverHelper.h>
 
 #ifndef ICE_OS_WINRT
+#   include <IceUtil/UniquePtr.h>
+#   include <IceUtil/Time.h>
+#   include <Ice/Exception.h>
 #   include <deque>
+#   include <map>
 #endif
 
 namespace IceInternal
@@ -103,7 +107,7 @@ private:
 };
 
 #ifndef ICE_OS_WINRT
-class ICE_API EndpointHostResolver : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+class ICE_API EndpointHostResolver : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 #else
 class ICE_API EndpointHostResolver : public IceUtil::Shared
 #endif
@@ -115,16 +119,34 @@ public:
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&);
     void destroy();
+    void joinWithAllThreads();
 
-    virtual void run();
     void updateObserver();
 
 private:
 
 #ifndef ICE_OS_WINRT
+    class HelperThread : public IceUtil::Thread
+    {
+    public:
+
+        HelperThread(const EndpointHostResolverPtr&, const std::string&);
+        virtual void run();
+
+        void updateObserver();
+
+    private:
+
+        friend class EndpointHostResolver;
+
+        const EndpointHostResolverPtr _resolver;
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    };
+    typedef IceUtil::Handle<HelperThread> HelperThreadPtr;
+    friend class HelperThread;
+
     struct ResolveEntry
     {
-        std::string host;
         int port;
         Ice::EndpointSelectionType selType;
         IPEndpointIPtr endpoint;
@@ -132,12 +154,40 @@ private:
         Ice::Instrumentation::ObserverPtr observer;
     };
 
+    //
+    // The result of the lookup of a host. The addresses are resolved
+    // with port 0 and in the order of the DNS reply, the port and the
+    // endpoint selection type are applied for each resolve request.
+    //
+    struct CacheEntry : public IceUtil::Shared
+    {
+        std::vector<Address> addresses;
+        ProtocolSupport protocol;
+        NetworkProxyPtr networkProxy;
+        IceUtil::UniquePtr<Ice::LocalException> exception;
+        IceUtil::Time expirationTime;
+    };
+    typedef IceUtil::Handle<CacheEntry> CacheEntryPtr;
+
+    void run(const HelperThreadPtr&);
+    void resolved(const std::vector<ResolveEntry>&, const CacheEntryPtr&);
+
     const InstancePtr _instance;
     const IceInternal::ProtocolSupport _protocol;
     const bool _preferIPv6;
+    const IceUtil::Time _cacheTimeout;
+    const IceUtil::Time _negativeCacheTimeout;
     bool _destroyed;
-    std::deque<ResolveEntry> _queue;
-    ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    std::vector<HelperThreadPtr> _threads;
+
+    //
+    // The hosts waiting to be resolved and the resolve requests for
+    // each host. Requests for a host which is already queued or being
+    // resolved are added to the pending requests of the host.
+    //
+    std::deque<std::string> _queue;
+    std::map<std::string, std::vector<ResolveEntry> > _pending;
+    std::map<std::string, CacheEntryPtr> _cache;
 #else
     const InstancePtr _instance;
 #endif
@@ -13,6 +13,7 @@
 #include <Ice/ObjectAdapter.h>
 #include <Ice/ServantLocator.h>
 #include <Ice/ServantManager.h>
+#include <Ice/InternTable.h>
 #include <Ice/Object.h>
 #include <Ice/ConnectionI.h>
 #include <Ice/LocalException.h>
@@ -37,6 +38,33 @@ extern bool ICE_UTIL_API printStackTraces;
 
 }
 
+namespace
+{
+
+//
+// Gives back the strings of the current to the intern table once the
+// request is dispatched.
+//
+class CurrentRecycler : private IceUtil::noncopyable
+{
+public:
+
+    CurrentRecycler(Ice::Current& current) : _current(current)
+    {
+    }
+
+    ~CurrentRecycler()
+    {
+        InternTable::recycle(_current);
+    }
+
+private:
+
+    Ice::Current& _current;
+};
+
+}
+
 IceInternal::IncomingBase::IncomingBase(Instance* instance, ResponseHandler* responseHandler,
                                         Ice::Connection* connection, const ObjectAdapterPtr& adapter,
                                         bool response, Byte compress, Int requestId) :
@@ -158,6 +186,31 @@ IncomingBase::__writeParamEncaps(const Byte* v, Ice::Int sz, bool ok)
     }
 }
 
+void
+IncomingBase::__adoptParamEncaps(BasicStream& reply, const Byte* v, Ice::Int sz, bool ok)
+{
+    //
+    // If the encapsulation ends a reply message with the same layout
+    // as ours, adopt the reply message and overwrite its header and
+    // request id rather than copying the encapsulation.
+    //
+    if(_response && sz > 0 && v + sz == reply.b.end() && v - reply.b.begin() == headerSize + 5 &&
+       reply.b[headerSize + 4] == (ok ? replyOK : replyUserException))
+    {
+        if(!ok)
+        {
+            _observer.userException();
+        }
+
+        assert(_os.b.size() == headerSize + 4); // Reply status position.
+        copy(_os.b.begin(), _os.b.end(), reply.b.begin());
+        _os.swapBuffer(reply);
+        _os.i = _os.b.end();
+        return;
+    }
+    __writeParamEncaps(v, sz, ok);
+}
+
 void
 IncomingBase::__writeUserException(const Ice::UserException& ex, Ice::FormatType format)
 {
@@ -558,50 +611,42 @@ IceInternal::Incoming::setActive(IncomingAsync& cb)
     _cb = &cb; // acquires a ref-count
 }
 
-void
-IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, BasicStream* stream)
+bool
+IceInternal::Incoming::swapRequest(Buffer& buf)
 {
-    _is = stream;
-
-    BasicStream::Container::iterator start = _is->i;
-
     //
-    // Read the current.
+    // Only the connection dispatches requests with a connection, from
+    // the message it received. The message of a single request is
+    // cleared once dispatched, the requests of a batch share the
+    // message. Collocated requests are read from the caller's stream.
     //
-    _is->read(_current.id);
+    if(!_current.con || _is->b.size() <= 8 || _is->b[8] != requestMsg)
+    {
+        return false;
+    }
 
-    //
-    // For compatibility with the old FacetPath.
-    //
-    string facet;
+    if(_inParamPos != 0 || _is->i != _is->b.end())
     {
-        vector<string> facetPath;
-        _is->read(facetPath);
-        if(!facetPath.empty())
-        {
-            if(facetPath.size() > 1)
-            {
-                throw MarshalException(__FILE__, __LINE__);
-            }
-            facet.swap(facetPath[0]);
-        }
+        return false;
     }
-    _current.facet.swap(facet);
+    _is->swapBuffer(buf);
+    return true;
+}
 
-    _is->read(_current.operation, false);
+void
+IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, BasicStream* stream)
+{
+    _is = stream;
 
-    Byte b;
-    _is->read(b);
-    _current.mode = static_cast<OperationMode>(b);
+    BasicStream::Container::iterator start = _is->i;
 
-    Int sz = _is->readSize();
-    while(sz--)
-    {
-        pair<const string, string> pr;
-        _is->read(const_cast<string&>(pr.first));
-        _is->read(pr.second);
-        _current.ctx.insert(_current.ctx.end(), pr);
-    }
+    //
+    // Read the current. The strings are read into the strings of the
+    // previous request dispatched by this thread and given back once
+    // this request is dispatched.
+    //
+    InternTable::read(_is, _current);
+    CurrentRecycler recycler(_current);
 
     const CommunicatorObserverPtr& obsv = _is->instance()->initializationData().observer;
     if(obsv)
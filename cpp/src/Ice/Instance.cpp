@@ -27,6 +27,7 @@
 #include <Ice/PropertiesI.h>
 #include <Ice/PropertiesAdminI.h>
 #include <Ice/LoggerI.h>
+#include <Ice/AsyncLoggerI.h>
 #include <Ice/NetworkProxy.h>
 #include <Ice/EndpointFactoryManager.h>
 #include <Ice/IPEndpointI.h> // For EndpointHostResolver
@@ -1232,7 +1233,28 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
 #endif
             if(!logfile.empty())
             {
-                _initData.logger = new LoggerI(_initData.properties->getProperty("Ice.ProgramName"), logfile);
+                if(_initData.properties->getPropertyAsInt("Ice.LogFile.Async") > 0)
+                {
+                    string overflow = _initData.properties->getPropertyWithDefault("Ice.LogFile.Overflow", "block");
+                    if(overflow != "block" && overflow != "drop")
+                    {
+                        throw InitializationException(__FILE__, __LINE__,
+                                                      "invalid value for Ice.LogFile.Overflow: " + overflow);
+                    }
+                    Int queueSize = _initData.properties->getPropertyAsIntWithDefault("Ice.LogFile.QueueSize", 10000);
+                    Int sizeMax = _initData.properties->getPropertyAsInt("Ice.LogFile.SizeMax");
+                    LogWriterPtr logWriter = new LogWriter(logfile, static_cast<size_t>(max(queueSize, 1)),
+                                                           overflow == "drop",
+                                                           static_cast<Ice::Long>(max(sizeMax, 0)) * 1024);
+                    logWriter->start();
+                    _logWriter = logWriter; // Only set once started, destroy() joins with it.
+                    _initData.logger = new AsyncLoggerI(_initData.properties->getProperty("Ice.ProgramName"),
+                                                        _logWriter);
+                }
+                else
+                {
+                    _initData.logger = new LoggerI(_initData.properties->getProperty("Ice.ProgramName"), logfile);
+                }
             }
             else
             {
@@ -1375,6 +1397,15 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             IceUtilInternal::MutexPtrLock<IceUtil::Mutex> sync(staticMutex);
             instanceList->remove(this);
         }
+
+        //
+        // Stop the log writer thread first, destroy() might not reach
+        // it if the instance is only partially constructed.
+        //
+        if(_logWriter)
+        {
+            _logWriter->destroy();
+        }
         destroy();
         __setNoDelete(false);
         throw;
@@ -1767,12 +1798,10 @@ IceInternal::Instance::destroy()
     {
         _serverThreadPool->joinWithAllThreads();
     }
-#ifndef ICE_OS_WINRT
     if(_endpointHostResolver)
     {
-        _endpointHostResolver->getThreadControl().join();
+        _endpointHostResolver->joinWithAllThreads();
     }
-#endif
 
     if(_servantFactoryManager)
     {
@@ -1816,6 +1845,15 @@ IceInternal::Instance::destroy()
         _pluginManager->destroy();
     }
 
+    //
+    // Write the queued log messages and join with the log writer
+    // thread. The asynchronous loggers write synchronously from now on.
+    //
+    if(_logWriter)
+    {
+        _logWriter->destroy();
+    }
+
     {
         Lock sync(*this);
 
@@ -1836,6 +1874,7 @@ IceInternal::Instance::destroy()
         _locatorManager = 0;
         _endpointFactoryManager = 0;
         _pluginManager = 0;
+        _logWriter = 0;
         _dynamicLibraryList = 0;
 
         _adminAdapter = 0;
@@ -60,6 +60,9 @@ typedef IceUtil::Handle<Timer> TimerPtr;
 class MetricsAdminI;
 typedef IceUtil::Handle<MetricsAdminI> MetricsAdminIPtr;
 
+class LogWriter;
+typedef IceUtil::Handle<LogWriter> LogWriterPtr;
+
 class RequestHandlerFactory;
 typedef IceUtil::Handle<RequestHandlerFactory> RequestHandlerFactoryPtr;
 
@@ -192,6 +195,7 @@ private:
     EndpointFactoryManagerPtr _endpointFactoryManager;
     DynamicLibraryListPtr _dynamicLibraryList;
     Ice::PluginManagerPtr _pluginManager;
+    LogWriterPtr _logWriter;
     const Ice::ImplicitContextIPtr _implicitContext;
     IceUtil::StringConverterPtr _stringConverter;
     IceUtil::WstringConverterPtr _wstringConverter;
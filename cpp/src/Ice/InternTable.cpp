@@ -0,0 +1,203 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/InternTable.h>
+#include <Ice/BasicStream.h>
+#include <Ice/LocalException.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+extern "C" void iceInternTableThreadDestructor(void*);
+
+namespace
+{
+
+struct ThreadStrings
+{
+    string name;
+    string category;
+    string facet;
+    string operation;
+};
+
+#ifndef ICE_OS_WINRT
+
+#   ifdef _WIN32
+DWORD key = TLS_OUT_OF_INDEXES;
+#   else
+pthread_key_t key;
+#   endif
+bool keyCreated = false;
+
+class Init
+{
+public:
+
+    Init()
+    {
+        //
+        // If the key can't be created, the strings are read without
+        // being recycled. Like for the implicit context key, the key
+        // is never deleted.
+        //
+#   ifdef _WIN32
+        key = TlsAlloc();
+        keyCreated = key != TLS_OUT_OF_INDEXES;
+#   else
+        keyCreated = pthread_key_create(&key, &iceInternTableThreadDestructor) == 0;
+#   endif
+    }
+};
+
+Init init;
+
+#endif
+
+ThreadStrings*
+getThreadStrings()
+{
+#ifdef ICE_OS_WINRT
+    return 0;
+#else
+    if(!keyCreated)
+    {
+        return 0;
+    }
+
+#   ifdef _WIN32
+    ThreadStrings* strings = static_cast<ThreadStrings*>(TlsGetValue(key));
+#   else
+    ThreadStrings* strings = static_cast<ThreadStrings*>(pthread_getspecific(key));
+#   endif
+    if(!strings)
+    {
+        strings = new ThreadStrings;
+#   ifdef _WIN32
+        if(TlsSetValue(key, strings) == 0)
+#   else
+        if(pthread_setspecific(key, strings) != 0)
+#   endif
+        {
+            delete strings;
+            return 0;
+        }
+    }
+    return strings;
+#endif
+}
+
+void
+readString(BasicStream* is, string* cached, string& v, bool convert)
+{
+    if(!cached)
+    {
+        is->read(v, convert);
+        return;
+    }
+
+    const char* data;
+    size_t sz;
+    string holder;
+    if(convert)
+    {
+        is->read(data, sz, holder);
+    }
+    else
+    {
+        is->read(data, sz);
+    }
+
+    //
+    // Assigning the bytes to the cached string doesn't allocate if
+    // the cached string buffer is large enough and isn't shared.
+    //
+    cached->assign(data, sz);
+    v.swap(*cached);
+}
+
+}
+
+void
+IceInternal::InternTable::read(BasicStream* is, Current& current)
+{
+    ThreadStrings* strings = getThreadStrings();
+
+    readString(is, strings ? &strings->name : 0, current.id.name, true);
+    readString(is, strings ? &strings->category : 0, current.id.category, true);
+
+    //
+    // For compatibility with the old FacetPath.
+    //
+    Int sz = is->readSize();
+    if(sz > 1)
+    {
+        throw MarshalException(__FILE__, __LINE__);
+    }
+    else if(sz == 1)
+    {
+        readString(is, strings ? &strings->facet : 0, current.facet, true);
+    }
+    else
+    {
+        current.facet.clear();
+    }
+
+    readString(is, strings ? &strings->operation : 0, current.operation, false);
+
+    Byte b;
+    is->read(b);
+    current.mode = static_cast<OperationMode>(b);
+
+    //
+    // The context is usually empty, in which case nothing is built.
+    //
+    sz = is->readSize();
+    while(sz--)
+    {
+        pair<const string, string> pr;
+        is->read(const_cast<string&>(pr.first));
+        is->read(pr.second);
+        current.ctx.insert(current.ctx.end(), pr);
+    }
+}
+
+void
+IceInternal::InternTable::recycle(Current& current)
+{
+    ThreadStrings* strings = getThreadStrings();
+    if(strings)
+    {
+        strings->name.swap(current.id.name);
+        strings->category.swap(current.id.category);
+        if(!current.facet.empty())
+        {
+            strings->facet.swap(current.facet);
+        }
+        strings->operation.swap(current.operation);
+    }
+}
+
+#if defined(_WIN32) && !defined(ICE_OS_WINRT)
+void
+IceInternal::InternTable::cleanupThread()
+{
+    if(keyCreated)
+    {
+        iceInternTableThreadDestructor(TlsGetValue(key));
+        TlsSetValue(key, 0);
+    }
+}
+#endif
+
+extern "C" void iceInternTableThreadDestructor(void* v)
+{
+    delete static_cast<ThreadStrings*>(v);
+}
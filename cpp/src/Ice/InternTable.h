@@ -0,0 +1,53 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_INTERN_TABLE_H
+#define ICE_INTERN_TABLE_H
+
+#include <Ice/Current.h>
+
+namespace IceInternal
+{
+
+class BasicStream;
+
+//
+// The intern table keeps, for each thread dispatching requests, the
+// identity, facet and operation strings of the last request
+// dispatched by the thread. The strings of a request are read into
+// these strings and given back to the table once the request is
+// dispatched: a thread dispatching requests reuses the string buffers
+// of its previous request instead of allocating new strings. The
+// strings of a thread are only used by this thread, reading and
+// recycling them doesn't lock.
+//
+class InternTable
+{
+public:
+
+    //
+    // Read the identity, facet, operation, mode and context of a
+    // request.
+    //
+    static void read(BasicStream*, Ice::Current&);
+
+    //
+    // Give back the strings of a dispatched request to the table of
+    // the calling thread.
+    //
+    static void recycle(Ice::Current&);
+
+#if defined(_WIN32) && !defined(ICE_OS_WINRT)
+    static void cleanupThread();
+#endif
+};
+
+}
+
+#endif
@@ -59,6 +59,7 @@ WINDOWS_OBJS   =  .\DLLMain.obj
 OBJS	       =  .\Acceptor.obj \
 		  .\ACM.obj \
 		  .\Application.obj \
+		  .\AsyncLoggerI.obj \
 		  .\AsyncResult.obj \
 		  .\Base64.obj \
 		  .\BasicStream.obj \
@@ -90,6 +91,7 @@ OBJS	       =  .\Acceptor.obj \
 		  .\Initialize.obj \
 		  .\Instance.obj \
 		  .\InstrumentationI.obj \
+		  .\InternTable.obj \
 		  .\IPEndpointI.obj \
 		  .\LocalObject.obj \
 		  .\LocatorInfo.obj \
@@ -420,6 +420,28 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
     }
 }
 
+void
+OutgoingAsync::adoptParamEncaps(Buffer& message, const Byte* encaps, Int size)
+{
+    //
+    // If the encapsulation ends the given message and the request
+    // header marshaled by prepare() has the same size as the one the
+    // message was received with, overwrite the message header and
+    // adopt the message rather than copying the encapsulation. This
+    // isn't possible for batch requests, they share the batch stream.
+    //
+    const Reference::Mode mode = _proxy->__reference()->getMode();
+    if(mode != Reference::ModeBatchOneway && mode != Reference::ModeBatchDatagram && size > 0 &&
+       encaps + size == message.b.end() && encaps - message.b.begin() == static_cast<ptrdiff_t>(_os.b.size()))
+    {
+        copy(_os.b.begin(), _os.b.end(), message.b.begin());
+        _os.swapBuffer(message);
+        _os.i = _os.b.end();
+        return;
+    }
+    writeParamEncaps(encaps, size);
+}
+
 bool
 OutgoingAsync::sent()
 {
@@ -116,6 +116,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Timeout", false, 0),
     IceInternal::Property("Ice.EventLog.Source", false, 0),
     IceInternal::Property("Ice.FactoryAssemblies", false, 0),
+    IceInternal::Property("Ice.HostResolver.CacheTimeout", false, 0),
+    IceInternal::Property("Ice.HostResolver.NegativeCacheTimeout", false, 0),
+    IceInternal::Property("Ice.HostResolver.Size", false, 0),
     IceInternal::Property("Ice.HTTPProxyHost", false, 0),
     IceInternal::Property("Ice.HTTPProxyPort", false, 0),
     IceInternal::Property("Ice.ImplicitContext", false, 0),
@@ -123,6 +126,10 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
+    IceInternal::Property("Ice.LogFile.Async", false, 0),
+    IceInternal::Property("Ice.LogFile.Overflow", false, 0),
+    IceInternal::Property("Ice.LogFile.QueueSize", false, 0),
+    IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
     IceInternal::Property("Ice.MessageSizeMax", false, 0),
     IceInternal::Property("Ice.Nohup", false, 0),
@@ -140,6 +147,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.PrintProcessId", false, 0),
     IceInternal::Property("Ice.PrintStackTraces", false, 0),
     IceInternal::Property("Ice.ProgramName", false, 0),
+    IceInternal::Property("Ice.ReadAheadSize", false, 0),
     IceInternal::Property("Ice.RetryIntervals", false, 0),
     IceInternal::Property("Ice.ServerIdleTime", false, 0),
     IceInternal::Property("Ice.SOCKSProxyHost", false, 0),
@@ -328,6 +336,10 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Port", false, 0),
     IceInternal::Property("IceDiscovery.Interface", false, 0),
     IceInternal::Property("IceDiscovery.DomainId", false, 0),
+    IceInternal::Property("IceDiscovery.BatchSize", false, 0),
+    IceInternal::Property("IceDiscovery.NegativeCacheTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.AdaptiveRetry", false, 0),
+    IceInternal::Property("IceDiscovery.AdaptiveRetryMultiplier", false, 0),
 };
 
 const IceInternal::PropertyArray
@@ -426,6 +438,7 @@ const IceInternal::PropertyArray
 
 const IceInternal::Property IceBoxPropsData[] = 
 {
+    IceInternal::Property("IceBox.DependsOn.*", false, 0),
     IceInternal::Property("IceBox.InheritProperties", false, 0),
     IceInternal::Property("IceBox.InstanceName", true, 0),
     IceInternal::Property("IceBox.LoadOrder", false, 0),
@@ -441,6 +454,8 @@ const IceInternal::Property IceBoxPropsData[] =
     IceInternal::Property("IceBox.ServiceManager.ThreadPool.SizeMax", true, 0),
     IceInternal::Property("IceBox.ServiceManager.ThreadPool.SizeWarn", true, 0),
     IceInternal::Property("IceBox.ServiceManager.ThreadPool.StackSize", true, 0),
+    IceInternal::Property("IceBox.ServiceThreads", false, 0),
+    IceInternal::Property("IceBox.Trace.ServiceManager", false, 0),
     IceInternal::Property("IceBox.Trace.ServiceObserver", false, 0),
     IceInternal::Property("IceBox.UseSharedCommunicator.*", false, 0),
 };
@@ -607,6 +622,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.CollocateRegistry", false, 0),
     IceInternal::Property("IceGrid.Node.Data", false, 0),
     IceInternal::Property("IceGrid.Node.DisableOnFailure", false, 0),
+    IceInternal::Property("IceGrid.Node.LoadSampleInterval", false, 0),
+    IceInternal::Property("IceGrid.Node.LoadUpdateThreshold", false, 0),
     IceInternal::Property("IceGrid.Node.Name", false, 0),
     IceInternal::Property("IceGrid.Node.Output", false, 0),
     IceInternal::Property("IceGrid.Node.ProcessorSocketCount", false, 0),
@@ -821,6 +838,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier", false, 0),
     IceInternal::Property("IceGrid.Registry.ReplicaName", false, 0),
     IceInternal::Property("IceGrid.Registry.ReplicaSessionTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.ReplicaUpdateLogSize", false, 0),
     IceInternal::Property("IceGrid.Registry.RequireNodeCertCN", false, 0),
     IceInternal::Property("IceGrid.Registry.RequireReplicaCertCN", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ACM.Timeout", false, 0),
@@ -975,6 +993,7 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
+    IceInternal::Property("IcePatch2.FileCacheSize", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
 };
 
@@ -985,7 +1004,9 @@ const IceInternal::PropertyArray
 const IceInternal::Property IcePatch2ClientPropsData[] = 
 {
     IceInternal::Property("IcePatch2Client.ChunkSize", false, 0),
+    IceInternal::Property("IcePatch2Client.DecompressThreads", false, 0),
     IceInternal::Property("IcePatch2Client.Directory", false, 0),
+    IceInternal::Property("IcePatch2Client.MaxInFlight", false, 0),
     IceInternal::Property("IcePatch2Client.Proxy", false, 0),
     IceInternal::Property("IcePatch2Client.Remove", false, 0),
     IceInternal::Property("IcePatch2Client.Thorough", false, 0),
@@ -1101,6 +1122,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
+    IceInternal::Property("Glacier2.Client.Coalesce", false, 0),
+    IceInternal::Property("Glacier2.Client.CoalesceSize", false, 0),
     IceInternal::Property("Glacier2.Client.ForwardContext", false, 0),
     IceInternal::Property("Glacier2.Client.SleepTime", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Override", false, 0),
@@ -1230,6 +1253,7 @@ const IceInternal::Property FreezePropsData[] =
     IceInternal::Property("Freeze.DbEnv.*.OldLogsAutoDelete", false, 0),
     IceInternal::Property("Freeze.DbEnv.*.PeriodicCheckpointMinSize", false, 0),
     IceInternal::Property("Freeze.Evictor.*.BtreeMinKey", false, 0),
+    IceInternal::Property("Freeze.Evictor.*.BulkReadSize", false, 0),
     IceInternal::Property("Freeze.Evictor.*.Checksum", false, 0),
     IceInternal::Property("Freeze.Evictor.*.MaxTxSize", false, 0),
     IceInternal::Property("Freeze.Evictor.*.PageSize", false, 0),
@@ -1237,8 +1261,11 @@ const IceInternal::Property FreezePropsData[] =
     IceInternal::Property("Freeze.Evictor.*.RollbackOnUserException", false, 0),
     IceInternal::Property("Freeze.Evictor.*.SavePeriod", false, 0),
     IceInternal::Property("Freeze.Evictor.*.SaveSizeTrigger", false, 0),
+    IceInternal::Property("Freeze.Evictor.*.SaveThreads", false, 0),
     IceInternal::Property("Freeze.Evictor.*.StreamTimeout", false, 0),
+    IceInternal::Property("Freeze.Evictor.*.StreamThreads", false, 0),
     IceInternal::Property("Freeze.Map.*.BtreeMinKey", false, 0),
+    IceInternal::Property("Freeze.Map.*.BulkReadSize", false, 0),
     IceInternal::Property("Freeze.Map.*.Checksum", false, 0),
     IceInternal::Property("Freeze.Map.*.PageSize", false, 0),
     IceInternal::Property("Freeze.Trace.DbEnv", false, 0),
@@ -824,6 +824,29 @@ IceProxy::Ice::Object::begin_ice_invoke(const string& operation,
     return __result;
 }
 
+AsyncResultPtr
+IceProxy::Ice::Object::___begin_ice_invoke(const string& operation,
+                                           OperationMode mode,
+                                           const pair<const Byte*, const Byte*>& inEncaps,
+                                           Buffer& message,
+                                           const Context* ctx,
+                                           const ::IceInternal::CallbackBasePtr& del,
+                                           const ::Ice::LocalObjectPtr& cookie)
+{
+    OutgoingAsyncPtr __result = new OutgoingAsync(this, ice_invoke_name, del, cookie);
+    try
+    {
+        __result->prepare(operation, mode, ctx);
+        __result->adoptParamEncaps(message, inEncaps.first, static_cast<Int>(inEncaps.second - inEncaps.first));
+        __result->invoke();
+    }
+    catch(const Exception& __ex)
+    {
+        __result->abort(__ex);
+    }
+    return __result;
+}
+
 bool
 IceProxy::Ice::Object::___end_ice_invoke(pair<const Byte*, const Byte*>& outEncaps, const AsyncResultPtr& __result)
 {
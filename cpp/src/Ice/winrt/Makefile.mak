@@ -14,6 +14,7 @@ SOURCE_DIR	= ..
 
 OBJS		= $(ARCH)\$(CONFIG)\Acceptor.obj \
 		  $(ARCH)\$(CONFIG)\ACM.obj \
+		  $(ARCH)\$(CONFIG)\AsyncLoggerI.obj \
 		  $(ARCH)\$(CONFIG)\AsyncResult.obj \
 		  $(ARCH)\$(CONFIG)\Base64.obj \
 		  $(ARCH)\$(CONFIG)\Buffer.obj \
@@ -52,6 +53,7 @@ OBJS		= $(ARCH)\$(CONFIG)\Acceptor.obj \
 		  $(ARCH)\$(CONFIG)\Incoming.obj \
 		  $(ARCH)\$(CONFIG)\Initialize.obj \
 		  $(ARCH)\$(CONFIG)\Instance.obj \
+		  $(ARCH)\$(CONFIG)\InternTable.obj \
 		  $(ARCH)\$(CONFIG)\IPEndpointI.obj \
 		  $(ARCH)\$(CONFIG)\LocalException.obj \
 		  $(ARCH)\$(CONFIG)\LocalObject.obj \
@@ -9,6 +9,7 @@
 
 #include <IceUtil/Options.h>
 #include <IceUtil/StringUtil.h>
+#include <IceUtil/Thread.h>
 #include <Ice/Ice.h>
 #include <Ice/DynamicLibrary.h>
 #include <Ice/SliceChecksums.h>
@@ -69,19 +70,335 @@ struct StartServiceInfo
     Ice::StringSeq args;
 };
 
+void
+checkDependencies(const vector<StartServiceInfo>& services, const vector<set<size_t> >& dependencies)
+{
+    //
+    // Remove the services without remaining dependencies until none
+    // is left, the services which can't be removed are part of a
+    // dependency cycle.
+    //
+    vector<size_t> remaining(services.size());
+    vector<vector<size_t> > dependents(services.size());
+    vector<size_t> ready;
+    for(size_t i = 0; i < services.size(); ++i)
+    {
+        remaining[i] = dependencies[i].size();
+        for(set<size_t>::const_iterator p = dependencies[i].begin(); p != dependencies[i].end(); ++p)
+        {
+            dependents[*p].push_back(i);
+        }
+        if(remaining[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    size_t removed = 0;
+    while(!ready.empty())
+    {
+        size_t i = ready.back();
+        ready.pop_back();
+        ++removed;
+        for(vector<size_t>::const_iterator p = dependents[i].begin(); p != dependents[i].end(); ++p)
+        {
+            if(--remaining[*p] == 0)
+            {
+                ready.push_back(*p);
+            }
+        }
+    }
+
+    if(removed != services.size())
+    {
+        FailureException ex(__FILE__, __LINE__);
+        ex.reason = "ServiceManager: dependency cycle between services";
+        for(size_t i = 0; i < services.size(); ++i)
+        {
+            if(remaining[i] > 0)
+            {
+                ex.reason += " `" + services[i].name + "'";
+            }
+        }
+        throw ex;
+    }
+}
+
+//
+// Runs a set of tasks with a bounded number of threads, the calling
+// thread included. A task runs once all the tasks it depends on are
+// completed, ready tasks run in order. If a task fails, no other task
+// is started and the failure is raised by run() once the running tasks
+// are completed.
+//
+class ServiceTasks : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    ServiceTasks(const vector<set<size_t> >& dependencies) :
+        _remaining(dependencies.size()),
+        _dependents(dependencies.size()),
+        _completed(0),
+        _failed(false)
+    {
+        for(size_t i = 0; i < dependencies.size(); ++i)
+        {
+            _remaining[i] = dependencies[i].size();
+            for(set<size_t>::const_iterator p = dependencies[i].begin(); p != dependencies[i].end(); ++p)
+            {
+                _dependents[*p].push_back(i);
+            }
+            if(_remaining[i] == 0)
+            {
+                _ready.insert(i);
+            }
+        }
+    }
+
+    virtual ~ServiceTasks()
+    {
+    }
+
+    void
+    run(int threads)
+    {
+        vector<IceUtil::ThreadControl> workers;
+        for(int i = 1; i < threads && i < static_cast<int>(_dependents.size()); ++i)
+        {
+            try
+            {
+                IceUtil::ThreadPtr thread = new WorkerThread(this);
+                workers.push_back(thread->start());
+            }
+            catch(const IceUtil::Exception&)
+            {
+                break; // Use the threads we got.
+            }
+        }
+
+        work();
+
+        for(vector<IceUtil::ThreadControl>::iterator p = workers.begin(); p != workers.end(); ++p)
+        {
+            p->join();
+        }
+
+        if(_failed)
+        {
+            FailureException ex(__FILE__, __LINE__);
+            ex.reason = _failure;
+            throw ex;
+        }
+    }
+
+protected:
+
+    virtual void runTask(size_t) = 0;
+
+private:
+
+    class WorkerThread : public IceUtil::Thread
+    {
+    public:
+
+        WorkerThread(ServiceTasks* tasks) :
+            IceUtil::Thread("IceBox.ServiceManager"),
+            _tasks(tasks)
+        {
+        }
+
+        virtual void
+        run()
+        {
+            _tasks->work();
+        }
+
+    private:
+
+        ServiceTasks* _tasks;
+    };
+
+    void
+    work()
+    {
+        while(true)
+        {
+            size_t task;
+            {
+                Lock sync(*this);
+                while(!_failed && _ready.empty() && _completed < _dependents.size())
+                {
+                    wait();
+                }
+                if(_failed || _ready.empty())
+                {
+                    return;
+                }
+                task = *_ready.begin();
+                _ready.erase(_ready.begin());
+            }
+
+            string failure;
+            try
+            {
+                runTask(task);
+            }
+            catch(const FailureException& ex)
+            {
+                failure = ex.reason;
+            }
+            catch(const Exception& ex)
+            {
+                ostringstream os;
+                os << "ServiceManager: " << ex;
+                failure = os.str();
+            }
+            catch(const std::exception& ex)
+            {
+                failure = string("ServiceManager: ") + ex.what();
+            }
+            catch(...)
+            {
+                failure = "ServiceManager: unknown exception";
+            }
+
+            Lock sync(*this);
+            if(!failure.empty())
+            {
+                if(!_failed)
+                {
+                    _failed = true;
+                    _failure = failure;
+                }
+            }
+            else
+            {
+                ++_completed;
+                for(vector<size_t>::const_iterator p = _dependents[task].begin(); p != _dependents[task].end(); ++p)
+                {
+                    if(--_remaining[*p] == 0)
+                    {
+                        _ready.insert(*p);
+                    }
+                }
+            }
+            notifyAll();
+        }
+    }
+
+    vector<size_t> _remaining;
+    vector<vector<size_t> > _dependents;
+    set<size_t> _ready;
+    size_t _completed;
+    bool _failed;
+    string _failure;
+};
+
+class StartTasks : public ServiceTasks
+{
+public:
+
+    StartTasks(ServiceManagerI* manager, const vector<StartServiceInfo>& services,
+               const vector<set<size_t> >& dependencies) :
+        ServiceTasks(dependencies),
+        _manager(manager),
+        _services(services)
+    {
+    }
+
+protected:
+
+    virtual void
+    runTask(size_t i)
+    {
+        _manager->start(_services[i].name, _services[i].entryPoint, _services[i].args);
+    }
+
+private:
+
+    ServiceManagerI* _manager;
+    const vector<StartServiceInfo>& _services;
+};
+
+class StopTasks : public ServiceTasks
+{
+public:
+
+    StopTasks(const vector<ServicePtr>& services, const vector<string>& names,
+              const vector<set<size_t> >& dependencies, const LoggerPtr& logger, int traceLevel) :
+        ServiceTasks(dependencies),
+        stopped(services.size(), 0),
+        _services(services),
+        _names(names),
+        _logger(logger),
+        _traceLevel(traceLevel)
+    {
+    }
+
+    vector<int> stopped;
+
+protected:
+
+    virtual void
+    runTask(size_t i)
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        try
+        {
+            _services[i]->stop();
+            stopped[i] = 1;
+        }
+        catch(const Exception& ex)
+        {
+            Warning out(_logger);
+            out << "ServiceManager: exception while stopping service " << _names[i] << ":\n";
+            out << ex;
+        }
+        catch(...)
+        {
+            Warning out(_logger);
+            out << "ServiceManager: unknown exception while stopping service " << _names[i];
+        }
+
+        if(_traceLevel >= 1 && stopped[i])
+        {
+            Trace out(_logger, "IceBox.ServiceManager");
+            out << "stopped service `" << _names[i] << "' in "
+                << (IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMilliSecondsDouble() << "ms";
+        }
+    }
+
+private:
+
+    const vector<ServicePtr>& _services;
+    const vector<string>& _names;
+    const LoggerPtr _logger;
+    const int _traceLevel;
+};
+
 }
 
 IceBox::ServiceManagerI::ServiceManagerI(CommunicatorPtr communicator, int& argc, char* argv[]) :
     _communicator(communicator),
     _adminEnabled(false),
     _pendingStatusChanges(false),
-    _traceServiceObserver(0)
+    _traceServiceObserver(0),
+    _traceServiceManager(0),
+    _serviceThreads(1)
 {
     const_cast<CallbackPtr&>(_observerCompletedCB) = newCallback(this, &ServiceManagerI::observerCompleted);
     _logger = _communicator->getLogger();
 
     PropertiesPtr props = _communicator->getProperties();
     _traceServiceObserver = props->getPropertyAsInt("IceBox.Trace.ServiceObserver");
+    _traceServiceManager = props->getPropertyAsInt("IceBox.Trace.ServiceManager");
+    _serviceThreads = props->getPropertyAsIntWithDefault("IceBox.ServiceThreads", 1);
+    if(_serviceThreads < 1)
+    {
+        Warning out(_logger);
+        out << "IceBox.ServiceThreads < 1; ServiceThreads adjusted to 1";
+        _serviceThreads = 1;
+    }
 
     if(props->getProperty("Ice.Admin.Enabled") == "")
     {
@@ -439,12 +756,37 @@ IceBox::ServiceManagerI::start()
         }
 
         //
-        // Start the services.
+        // Start the services. A service is only started once the
+        // services listed in its IceBox.DependsOn.<name> property are
+        // started. With IceBox.ServiceThreads > 1, independent services
+        // are started concurrently.
         //
-        for(vector<StartServiceInfo>::const_iterator r = servicesInfo.begin(); r != servicesInfo.end(); ++r)
+        map<string, size_t> indexes;
+        for(size_t i = 0; i < servicesInfo.size(); ++i)
         {
-            start(r->name, r->entryPoint, r->args);
+            indexes.insert(make_pair(servicesInfo[i].name, i));
         }
+        vector<set<size_t> > dependencies(servicesInfo.size());
+        for(size_t i = 0; i < servicesInfo.size(); ++i)
+        {
+            StringSeq dependsOn = properties->getPropertyAsList("IceBox.DependsOn." + servicesInfo[i].name);
+            for(StringSeq::const_iterator q = dependsOn.begin(); q != dependsOn.end(); ++q)
+            {
+                map<string, size_t>::const_iterator r = indexes.find(*q);
+                if(r == indexes.end())
+                {
+                    FailureException ex(__FILE__, __LINE__);
+                    ex.reason = "ServiceManager: unknown service `" + *q + "' in IceBox.DependsOn." +
+                        servicesInfo[i].name;
+                    throw ex;
+                }
+                dependencies[i].insert(r->second);
+            }
+        }
+        checkDependencies(servicesInfo, dependencies);
+
+        StartTasks tasks(this, servicesInfo, dependencies);
+        tasks.run(_serviceThreads);
 
         //
         // We may want to notify external scripts that the services
@@ -535,7 +877,11 @@ IceBox::ServiceManagerI::stop()
 void
 IceBox::ServiceManagerI::start(const string& service, const string& entryPoint, const StringSeq& args)
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+    //
+    // The services might be started concurrently, the mutex is only
+    // locked to add the service once it's started.
+    //
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
 
     //
     // Load the entry point.
@@ -733,7 +1079,17 @@ IceBox::ServiceManagerI::start(const string& service, const string& entryPoint,
 
         info.library = library;
         info.status = Started;
-        _services.push_back(info);
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+            _services.push_back(info);
+        }
+
+        if(_traceServiceManager >= 1)
+        {
+            Trace out(_logger, "IceBox.ServiceManager");
+            out << "started service `" << service << "' in "
+                << (IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMilliSecondsDouble() << "ms";
+        }
     }
     catch(const Exception&)
     {
@@ -767,30 +1123,49 @@ IceBox::ServiceManagerI::stopAll()
 
     //
     // First, for each service, we call stop on the service and flush its database environment to
-    // the disk.
+    // the disk. A service is only stopped once the started services which depend on it are
+    // stopped. With IceBox.ServiceThreads > 1, independent services are stopped concurrently.
     //
-    for(vector<ServiceInfo>::reverse_iterator p = _services.rbegin(); p != _services.rend(); ++p)
     {
-        ServiceInfo& info = *p;
-
-        if(info.status == Started)
+        vector<ServicePtr> services;
+        vector<string> names;
+        vector<ServiceInfo*> infos;
+        map<string, size_t> indexes;
+        for(vector<ServiceInfo>::reverse_iterator p = _services.rbegin(); p != _services.rend(); ++p)
         {
-            try
+            if(p->status == Started)
             {
-                info.service->stop();
-                info.status = Stopped;
-                stoppedServices.push_back(info.name);
+                indexes.insert(make_pair(p->name, services.size()));
+                services.push_back(p->service);
+                names.push_back(p->name);
+                infos.push_back(&*p);
             }
-            catch(const Exception& ex)
+        }
+
+        PropertiesPtr properties = _communicator->getProperties();
+        vector<set<size_t> > dependencies(services.size());
+        for(size_t i = 0; i < names.size(); ++i)
+        {
+            StringSeq dependsOn = properties->getPropertyAsList("IceBox.DependsOn." + names[i]);
+            for(StringSeq::const_iterator q = dependsOn.begin(); q != dependsOn.end(); ++q)
             {
-                Warning out(_logger);
-                out << "ServiceManager: exception while stopping service " << info.name << ":\n";
-                out << ex;
+                map<string, size_t>::const_iterator r = indexes.find(*q);
+                if(r != indexes.end())
+                {
+                    dependencies[r->second].insert(i); // *q must be stopped after names[i]
+                }
             }
-            catch(...)
+        }
+
+        StopTasks tasks(services, names, dependencies, _logger, _traceServiceManager);
+        tasks.run(_serviceThreads);
+
+        for(size_t i = 0; i < infos.size(); ++i)
+        {
+            if(tasks.stopped[i])
             {
-                Warning out(_logger);
-                out << "ServiceManager: unknown exception while stopping service " << info.name;
+                infos[i]->status = Stopped;
+                stoppedServices.push_back(infos[i]->name);
             }
         }
     }
@@ -38,6 +38,7 @@ public:
     int run();
 
     bool start();
+    void start(const std::string&, const std::string&, const ::Ice::StringSeq&);
     void stop();
 
     void observerCompleted(const Ice::AsyncResultPtr&);
@@ -63,7 +64,6 @@ private:
         Ice::StringSeq args;
     };
 
-    void start(const std::string&, const std::string&, const ::Ice::StringSeq&);
     void stopAll();
 
     void servicesStarted(const std::vector<std::string>&, const std::set<ServiceObserverPrx>&);
@@ -87,6 +87,8 @@ private:
 
     std::set<ServiceObserverPrx> _observers;
     int _traceServiceObserver;
+    int _traceServiceManager;
+    int _serviceThreads;
     ::Ice::CallbackPtr _observerCompletedCB;
 };
 
@@ -19,6 +19,16 @@ using namespace std;
 using namespace Ice;
 using namespace IceDiscovery;
 
+namespace
+{
+
+//
+// Lower bound of the retry timeout computed from the reply latency.
+//
+const IceUtil::Time minimumRetryTimeout = IceUtil::Time::milliSeconds(10);
+
+}
+
 IceDiscovery::Request::Request(const LookupIPtr& lookup, int retryCount) : _lookup(lookup), _nRetry(retryCount)
 {
 }
@@ -26,13 +36,45 @@ IceDiscovery::Request::Request(const LookupIPtr& lookup, int retryCount) : _look
 bool
 IceDiscovery::Request::retry()
 {
+    //
+    // A reply to a request sent more than once could answer any of
+    // the sends, don't use it to measure the latency.
+    //
+    _sent = IceUtil::Time();
     return --_nRetry >= 0;
 }
 
+void
+IceDiscovery::Request::sent()
+{
+    _sent = IceUtil::Time::now(IceUtil::Time::Monotonic);
+}
+
+IceUtil::Time
+IceDiscovery::Request::latency()
+{
+    //
+    // Only the first reply is used to measure the latency.
+    //
+    if(_sent == IceUtil::Time())
+    {
+        return IceUtil::Time();
+    }
+    IceUtil::Time latency = IceUtil::Time::now(IceUtil::Time::Monotonic) - _sent;
+    _sent = IceUtil::Time();
+    return latency;
+}
+
 bool
 AdapterRequest::retry()
 {
-    return _proxies.empty() && --_nRetry >= 0;
+    return _proxies.empty() && Request::retry();
+}
+
+bool
+AdapterRequest::hasProxies() const
+{
+    return !_proxies.empty();
 }
 
 bool
@@ -99,14 +141,31 @@ ObjectRequest::runTimerTask()
     _lookup->objectRequestTimedOut(this);
 }
 
+BatchTask::BatchTask(const LookupIPtr& lookup) : _lookup(lookup)
+{
+}
+
+void
+BatchTask::runTimerTask()
+{
+    _lookup->flushBatch();
+}
+
 LookupI::LookupI(const LocatorRegistryIPtr& registry, const LookupPrx& lookup, const Ice::PropertiesPtr& properties) : 
     _registry(registry), 
     _lookup(lookup), 
     _timeout(IceUtil::Time::milliSeconds(properties->getPropertyAsIntWithDefault("IceDiscovery.Timeout", 300))),
     _retryCount(properties->getPropertyAsIntWithDefault("IceDiscovery.RetryCount", 3)),
     _latencyMultiplier(properties->getPropertyAsIntWithDefault("IceDiscovery.LatencyMultiplier", 1)),
+    _adaptiveRetry(properties->getPropertyAsInt("IceDiscovery.AdaptiveRetry") > 0),
+    _adaptiveRetryMultiplier(
+        max(properties->getPropertyAsIntWithDefault("IceDiscovery.AdaptiveRetryMultiplier", 2), 1)),
     _domainId(properties->getProperty("IceDiscovery.DomainId")),
-    _timer(IceInternal::getInstanceTimer(lookup->ice_getCommunicator()))
+    _batchSize(static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("IceDiscovery.BatchSize", 1), 1))),
+    _negativeCacheTimeout(
+        IceUtil::Time::milliSeconds(properties->getPropertyAsIntWithDefault("IceDiscovery.NegativeCacheTimeout", 0))),
+    _timer(IceInternal::getInstanceTimer(lookup->ice_getCommunicator())),
+    _batchScheduled(false)
 {
 }
 
@@ -130,6 +189,9 @@ LookupI::destroy()
         _timer->cancel(p->second);
     }
     _adapterRequests.clear();
+
+    _batchObjects.clear();
+    _batchAdapters.clear();
 }
 
 void
@@ -177,10 +239,31 @@ LookupI::findAdapterById(const string& domainId, const std::string& adapterId,
     }
 }
 
+void
+LookupI::findObjectsAndAdaptersById(const string& domainId, const Ice::IdentitySeq& ids,
+                                    const Ice::StringSeq& adapterIds, const IceDiscovery::LookupReplyPrx& reply,
+                                    const Ice::Current& current)
+{
+    for(Ice::IdentitySeq::const_iterator p = ids.begin(); p != ids.end(); ++p)
+    {
+        findObjectById(domainId, *p, reply, current);
+    }
+    for(Ice::StringSeq::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+    {
+        findAdapterById(domainId, *p, reply, current);
+    }
+}
+
 void 
 LookupI::findObject(const Ice::AMD_Locator_findObjectByIdPtr& cb, const Ice::Identity& id)
 {
     Lock sync(*this);
+    if(isMiss(_objectMisses, id))
+    {
+        cb->ice_response(0);
+        return;
+    }
+
     map<Ice::Identity, ObjectRequestPtr>::const_iterator p = _objectRequests.find(id);
     if(p == _objectRequests.end())
     {
@@ -189,8 +272,7 @@ LookupI::findObject(const Ice::AMD_Locator_findObjectByIdPtr& cb, const Ice::Ide
 
     if(p->second->addCallback(cb))
     {
-        _lookup->begin_findObjectById(_domainId, id, _lookupReply);
-        _timer->schedule(p->second, _timeout);
+        sendObjectRequest(p->second);
     }
 }
 
@@ -198,6 +280,12 @@ void
 LookupI::findAdapter(const Ice::AMD_Locator_findAdapterByIdPtr& cb, const std::string& adapterId)
 {
     Lock sync(*this);
+    if(isMiss(_adapterMisses, adapterId))
+    {
+        cb->ice_response(0);
+        return;
+    }
+
     map<string, AdapterRequestPtr>::const_iterator p = _adapterRequests.find(adapterId);
     if(p == _adapterRequests.end())
     {
@@ -206,8 +294,7 @@ LookupI::findAdapter(const Ice::AMD_Locator_findAdapterByIdPtr& cb, const std::s
 
     if(p->second->addCallback(cb))
     {
-        _lookup->begin_findAdapterById(_domainId, adapterId, _lookupReply);
-        _timer->schedule(p->second, _timeout);
+        sendAdapterRequest(p->second);
     }
 }
 
@@ -215,12 +302,15 @@ void
 LookupI::foundObject(const Ice::Identity& id, const Ice::ObjectPrx& proxy)
 {
     Lock sync(*this);
+    _objectMisses.erase(id);
+
     map<Ice::Identity, ObjectRequestPtr>::iterator p = _objectRequests.find(id);
     if(p == _objectRequests.end())
     {
         return;
     }
 
+    addLatency(p->second->latency());
     p->second->response(proxy);
     _timer->cancel(p->second);
     _objectRequests.erase(p);
@@ -230,12 +320,15 @@ void
 LookupI::foundAdapter(const std::string& adapterId, const Ice::ObjectPrx& proxy, bool isReplicaGroup)
 {
     Lock sync(*this);
+    _adapterMisses.erase(adapterId);
+
     map<string, AdapterRequestPtr>::iterator p = _adapterRequests.find(adapterId);
     if(p == _adapterRequests.end())
     {
         return;
     }
 
+    addLatency(p->second->latency());
     if(p->second->response(proxy, isReplicaGroup))
     {
         _timer->cancel(p->second);
@@ -255,14 +348,19 @@ LookupI::objectRequestTimedOut(const ObjectRequestPtr& request)
 
     if(request->retry())
     {
+        //
+        // Retries always use the single lookup operation since peers
+        // running an older version ignore the batched lookup.
+        //
         _lookup->begin_findObjectById(_domainId, request->getId(), _lookupReply);
-        _timer->schedule(p->second, _timeout);
+        _timer->schedule(p->second, retryTimeout());
     }
     else
     {
         request->finished(0);
         _objectRequests.erase(p);
         _timer->cancel(request);
+        addMiss(_objectMisses, request->getId());
     }
 }
 
@@ -279,14 +377,186 @@ LookupI::adapterRequestTimedOut(const AdapterRequestPtr& request)
     if(request->retry())
     {
         _lookup->begin_findAdapterById(_domainId, request->getId(), _lookupReply);
-        _timer->schedule(p->second, _timeout);
+        _timer->schedule(p->second, retryTimeout());
     }
     else
     {
         request->finished(0);
         _adapterRequests.erase(p);
         _timer->cancel(request);
+        if(!request->hasProxies())
+        {
+            addMiss(_adapterMisses, request->getId());
+        }
+    }
+}
+
+void
+LookupI::flushBatch()
+{
+    Lock sync(*this);
+    _batchScheduled = false;
+
+    vector<Ice::Identity>::const_iterator o = _batchObjects.begin();
+    vector<string>::const_iterator a = _batchAdapters.begin();
+    while(o != _batchObjects.end() || a != _batchAdapters.end())
+    {
+        Ice::IdentitySeq ids;
+        Ice::StringSeq adapterIds;
+        while(o != _batchObjects.end() && ids.size() < _batchSize)
+        {
+            ids.push_back(*o++);
+        }
+        while(a != _batchAdapters.end() && ids.size() + adapterIds.size() < _batchSize)
+        {
+            adapterIds.push_back(*a++);
+        }
+
+        //
+        // A lone request is sent with the single lookup operation which
+        // is also understood by older peers.
+        //
+        if(ids.size() + adapterIds.size() > 1)
+        {
+            _lookup->begin_findObjectsAndAdaptersById(_domainId, ids, adapterIds, _lookupReply);
+        }
+        else if(!ids.empty())
+        {
+            _lookup->begin_findObjectById(_domainId, ids[0], _lookupReply);
+        }
+        else
+        {
+            _lookup->begin_findAdapterById(_domainId, adapterIds[0], _lookupReply);
+        }
+    }
+
+    _batchObjects.clear();
+    _batchAdapters.clear();
+}
+
+void
+LookupI::sendObjectRequest(const ObjectRequestPtr& request)
+{
+    request->sent();
+    if(_batchSize > 1)
+    {
+        //
+        // Coalesce the requests issued until the batch task runs.
+        //
+        _batchObjects.push_back(request->getId());
+        if(!_batchScheduled)
+        {
+            _timer->schedule(new BatchTask(this), IceUtil::Time());
+            _batchScheduled = true;
+        }
+    }
+    else
+    {
+        _lookup->begin_findObjectById(_domainId, request->getId(), _lookupReply);
+    }
+    _timer->schedule(request, retryTimeout());
+}
+
+void
+LookupI::sendAdapterRequest(const AdapterRequestPtr& request)
+{
+    request->sent();
+    if(_batchSize > 1)
+    {
+        _batchAdapters.push_back(request->getId());
+        if(!_batchScheduled)
+        {
+            _timer->schedule(new BatchTask(this), IceUtil::Time());
+            _batchScheduled = true;
+        }
+    }
+    else
+    {
+        _lookup->begin_findAdapterById(_domainId, request->getId(), _lookupReply);
+    }
+    _timer->schedule(request, retryTimeout());
+}
+
+void
+LookupI::addLatency(const IceUtil::Time& latency)
+{
+    if(!_adaptiveRetry || latency == IceUtil::Time())
+    {
+        return;
+    }
+
+    //
+    // Smoothed latency and variation, computed like the TCP
+    // retransmission timer (RFC 6298).
+    //
+    if(_latency == IceUtil::Time())
+    {
+        _latency = latency;
+        _latencyVariation = latency / 2;
+    }
+    else
+    {
+        IceUtil::Time delta = latency > _latency ? latency - _latency : _latency - latency;
+        _latencyVariation = (_latencyVariation * 3 + delta) / 4;
+        _latency = (_latency * 7 + latency) / 8;
+    }
+}
+
+IceUtil::Time
+LookupI::retryTimeout() const
+{
+    //
+    // The retry timeout is IceDiscovery.Timeout unless adaptive
+    // retries are enabled with IceDiscovery.AdaptiveRetry. In this
+    // case, once a reply is received, it's derived from the observed
+    // latency scaled by IceDiscovery.AdaptiveRetryMultiplier, with
+    // IceDiscovery.Timeout as the upper bound.
+    //
+    if(!_adaptiveRetry || _latency == IceUtil::Time())
+    {
+        return _timeout;
+    }
+    IceUtil::Time timeout = (_latency + _latencyVariation * 4) * _adaptiveRetryMultiplier;
+    return min(_timeout, max(minimumRetryTimeout, timeout));
+}
+
+template<class T> bool
+LookupI::isMiss(map<T, IceUtil::Time>& misses, const T& id)
+{
+    typename map<T, IceUtil::Time>::iterator p = misses.find(id);
+    if(p == misses.end())
+    {
+        return false;
+    }
+    else if(p->second > IceUtil::Time::now(IceUtil::Time::Monotonic))
+    {
+        return true;
+    }
+    misses.erase(p);
+    return false;
+}
+
+template<class T> void
+LookupI::addMiss(map<T, IceUtil::Time>& misses, const T& id)
+{
+    if(_negativeCacheTimeout <= IceUtil::Time())
+    {
+        return;
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(typename map<T, IceUtil::Time>::iterator p = misses.begin(); p != misses.end();)
+    {
+        if(p->second <= now)
+        {
+            misses.erase(p++);
+        }
+        else
+        {
+            ++p;
+        }
     }
+    misses[id] = now + _negativeCacheTimeout;
 }
 
 LookupReplyI::LookupReplyI(const LookupIPtr& lookup) : _lookup(lookup)
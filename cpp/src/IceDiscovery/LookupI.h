@@ -29,10 +29,14 @@ public:
 
     virtual bool retry();
 
+    void sent();
+    IceUtil::Time latency();
+
 protected:
 
     LookupIPtr _lookup;
     int _nRetry;
+    IceUtil::Time _sent;
 };
 
 template<class T, class CB> class RequestT : public Request
@@ -97,6 +101,7 @@ public:
     }
 
     bool response(const Ice::ObjectPrx&, bool);
+    bool hasProxies() const;
 
     virtual bool retry();
     virtual void finished(const Ice::ObjectPrx&);
@@ -110,6 +115,19 @@ private:
 };
 typedef IceUtil::Handle<AdapterRequest> AdapterRequestPtr;
 
+class BatchTask : public IceUtil::TimerTask
+{
+public:
+
+    BatchTask(const LookupIPtr&);
+
+    virtual void runTimerTask();
+
+private:
+
+    const LookupIPtr _lookup;
+};
+
 class LookupI : public Lookup, private IceUtil::Mutex
 {
 public:
@@ -125,6 +143,8 @@ public:
                                 const Ice::Current&);
     virtual void findAdapterById(const std::string&, const std::string&, const IceDiscovery::LookupReplyPrx&, 
                                  const Ice::Current&);
+    virtual void findObjectsAndAdaptersById(const std::string&, const Ice::IdentitySeq&, const Ice::StringSeq&,
+                                            const IceDiscovery::LookupReplyPrx&, const Ice::Current&);
 
     void findObject(const Ice::AMD_Locator_findObjectByIdPtr&, const Ice::Identity&);
     void findAdapter(const Ice::AMD_Locator_findAdapterByIdPtr&, const std::string&);
@@ -135,6 +155,8 @@ public:
     void adapterRequestTimedOut(const AdapterRequestPtr&);
     void objectRequestTimedOut(const ObjectRequestPtr&);
 
+    void flushBatch();
+
     const IceUtil::TimerPtr&
     timer()
     {
@@ -149,19 +171,51 @@ public:
 
 private:
 
+    void sendObjectRequest(const ObjectRequestPtr&);
+    void sendAdapterRequest(const AdapterRequestPtr&);
+    void addLatency(const IceUtil::Time&);
+    IceUtil::Time retryTimeout() const;
+    template<class T> bool isMiss(std::map<T, IceUtil::Time>&, const T&);
+    template<class T> void addMiss(std::map<T, IceUtil::Time>&, const T&);
+
     LocatorRegistryIPtr _registry;
     const LookupPrx _lookup;
     LookupReplyPrx _lookupReply;
     const IceUtil::Time _timeout;
     const int _retryCount;
     const int _latencyMultiplier;
+    const bool _adaptiveRetry;
+    const int _adaptiveRetryMultiplier;
     const std::string _domainId;
+    const size_t _batchSize;
+    const IceUtil::Time _negativeCacheTimeout;
 
     IceUtil::TimerPtr _timer;
     Ice::ObjectPrx _wellKnownProxy;
 
     std::map<Ice::Identity, ObjectRequestPtr> _objectRequests;
     std::map<std::string, AdapterRequestPtr> _adapterRequests;
+
+    //
+    // Requests waiting to be sent with a single batched lookup.
+    //
+    bool _batchScheduled;
+    std::vector<Ice::Identity> _batchObjects;
+    std::vector<std::string> _batchAdapters;
+
+    //
+    // Smoothed reply latency and its variation, used to compute the
+    // retry timeout.
+    //
+    IceUtil::Time _latency;
+    IceUtil::Time _latencyVariation;
+
+    //
+    // Negative cache: expiration time of the recent lookups which
+    // didn't find anything.
+    //
+    std::map<Ice::Identity, IceUtil::Time> _objectMisses;
+    std::map<std::string, IceUtil::Time> _adapterMisses;
 };
 
 class LookupReplyI : public LookupReply
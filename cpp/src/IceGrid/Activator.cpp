@@ -42,6 +42,17 @@
 #   include <grp.h> // for initgroups
 #endif
 
+//
+// posix_spawn_file_actions_addchdir_np and
+// posix_spawn_file_actions_addclosefrom_np are required to preserve
+// the semantics of the fork() activation.
+//
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+#   define ICE_GRID_POSIX_SPAWN
+#   include <spawn.h>
+extern char** environ;
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -299,7 +310,8 @@ extern "C" void CALLBACK activatorWaitCallback(PVOID data, BOOLEAN)
 
 Activator::Activator(const TraceLevelsPtr& traceLevels) :
     _traceLevels(traceLevels),
-    _deactivating(false)
+    _deactivating(false),
+    _activating(0)
 {
 #ifdef _WIN32
     _hIntr = CreateEvent(
@@ -632,6 +644,214 @@ Activator::activate(const string& name,
 
     return static_cast<Ice::Int>(process.pid);
 #else
+    //
+    // The activator mutex isn't locked while the process is created,
+    // independent servers can be activated concurrently. destroy()
+    // and the termination listener wait for pending activations.
+    //
+    ++_activating;
+    sync.release();
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    pid_t pid;
+    int pipeFd;
+    bool spawned;
+    try
+    {
+        spawned = spawnProcess(args, envs, pwd, uid, gid, pid, pipeFd);
+        if(!spawned)
+        {
+            pid = forkProcess(args, envs, pwd, uid, gid, pipeFd);
+        }
+    }
+    catch(...)
+    {
+        sync.acquire();
+        --_activating;
+
+        //
+        // Wake up the termination listener, it might be waiting for
+        // this activation to complete to terminate.
+        //
+        setInterrupt();
+        notifyAll();
+        throw;
+    }
+
+    if(_traceLevels->activator > 2)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
+        out << (spawned ? "spawned" : "forked") << " server `" << name << "' process (pid = " << pid << ") in "
+            << (IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMilliSecondsDouble() << "ms";
+    }
+
+    sync.acquire();
+    --_activating;
+
+    Process process;
+    process.pid = pid;
+    process.pipeFd = pipeFd;
+    process.server = server;
+    _processes.insert(make_pair(name, process));
+        
+    int flags = fcntl(process.pipeFd, F_GETFL);
+    flags |= O_NONBLOCK;
+    fcntl(process.pipeFd, F_SETFL, flags);
+
+    setInterrupt();
+    notifyAll();
+
+    //  
+    // Don't print the following trace, this might interfere with the
+    // output of the started process if it fails with an error message.
+    //
+//  if(_traceLevels->activator > 0)
+//  {
+//      Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
+//      out << "activated server `" << name << "' (pid = " << pid << ")";
+//  }
+    return pid;
+#endif
+}
+
+#ifndef _WIN32
+bool
+Activator::spawnProcess(const StringSeq& args, const StringSeq& envs, const string& pwd, uid_t uid, gid_t gid,
+                        pid_t& pid, int& pipeFd)
+{
+#ifdef ICE_GRID_POSIX_SPAWN
+    //
+    // Unlike fork(), posix_spawn() doesn't copy the node page tables.
+    // It can't change the process user, it's only used if the server
+    // runs with the node user and the node doesn't run as root (the
+    // supplementary groups are initialized for root). It's also not
+    // used if the server sets PATH and the executable needs to be
+    // found with it.
+    //
+    if(getuid() == 0 || uid != getuid() || uid != geteuid() || gid != getgid() || gid != getegid())
+    {
+        return false;
+    }
+    if(args[0].find('/') == string::npos)
+    {
+        for(StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+        {
+            if(p->compare(0, 5, "PATH=") == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    //
+    // The server environment is the node environment with the server
+    // environment variables.
+    //
+    vector<string> environment;
+    map<string, size_t> names;
+    for(char** e = environ; *e != 0; ++e)
+    {
+        string var(*e);
+        names[var.substr(0, var.find('='))] = environment.size();
+        environment.push_back(var);
+    }
+    for(StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+    {
+        map<string, size_t>::const_iterator q = names.find(p->substr(0, p->find('=')));
+        if(q != names.end())
+        {
+            environment[q->second] = *p;
+        }
+        else
+        {
+            names[p->substr(0, p->find('='))] = environment.size();
+            environment.push_back(*p);
+        }
+    }
+    vector<char*> envp;
+    for(vector<string>::const_iterator p = environment.begin(); p != environment.end(); ++p)
+    {
+        envp.push_back(const_cast<char*>(p->c_str()));
+    }
+    envp.push_back(0);
+
+    IceUtilInternal::ArgVector av(args);
+
+    int fds[2];
+    if(pipe(fds) != 0)
+    {
+        SyscallException ex(__FILE__, __LINE__);
+        ex.error = getSystemErrno();
+        throw ex;
+    }
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+
+    //
+    // Unblock signals blocked by IceUtil::CtrlCHandler and assign a
+    // new process group for the process.
+    //
+    sigset_t sigs;
+    pthread_sigmask(SIG_SETMASK, 0, &sigs);
+    sigdelset(&sigs, SIGHUP);
+    sigdelset(&sigs, SIGINT);
+    sigdelset(&sigs, SIGTERM);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETPGROUP);
+
+    //
+    // Close all file descriptors, except for standard input, standard
+    // output, standard error, and the write side of the newly created
+    // pipe which is moved to the descriptor 3.
+    //
+    if(fds[1] != 3)
+    {
+        posix_spawn_file_actions_adddup2(&actions, fds[1], 3);
+    }
+    posix_spawn_file_actions_addclosefrom_np(&actions, 4);
+
+    if(!pwd.empty())
+    {
+        posix_spawn_file_actions_addchdir_np(&actions, pwd.c_str());
+    }
+
+    int err = posix_spawnp(&pid, av.argv[0], &actions, &attr, av.argv, &envp[0]);
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    close(fds[1]);
+
+    if(err != 0)
+    {
+        close(fds[0]);
+
+        //
+        // The error is either from the working directory change or
+        // from the exec.
+        //
+        struct stat buf;
+        if(!pwd.empty() && (stat(pwd.c_str(), &buf) != 0 || !S_ISDIR(buf.st_mode)))
+        {
+            throw "cannot change working directory to `" + pwd + "': " + IceUtilInternal::errorToString(err);
+        }
+        throw "cannot execute `" + args[0] + "': " + IceUtilInternal::errorToString(err);
+    }
+
+    pipeFd = fds[0];
+    return true;
+#else
+    return false;
+#endif
+}
+
+pid_t
+Activator::forkProcess(const StringSeq& args, const StringSeq& envs, const string& pwd, uid_t uid, gid_t gid,
+                       int& pipeFd)
+{
     int fds[2];
     if(pipe(fds) != 0)
     {
@@ -830,33 +1050,12 @@ Activator::activate(const string& name,
         // pipe anymore.
         //
         close(errorFds[0]);
-
-        Process process;
-        process.pid = pid;
-        process.pipeFd = fds[0];
-        process.server = server;
-        _processes.insert(make_pair(name, process));
-        
-        int flags = fcntl(process.pipeFd, F_GETFL);
-        flags |= O_NONBLOCK;
-        fcntl(process.pipeFd, F_SETFL, flags);
-
-        setInterrupt();
-
-    //  
-    // Don't print the following trace, this might interfere with the
-    // output of the started process if it fails with an error message.
-    //
-//      if(_traceLevels->activator > 0)
-//      {
-//          Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
-//          out << "activated server `" << name << "' (pid = " << pid << ")";
-//      }
+        pipeFd = fds[0];
     }
 
     return pid;
-#endif
 }
+#endif
 
 namespace
 {
@@ -1076,6 +1275,10 @@ Activator::destroy()
     {
         IceUtil::Monitor< IceUtil::Mutex>::Lock sync(*this);
         assert(_deactivating);
+        while(_activating > 0)
+        {
+            wait();
+        }
         processes = _processes;
     }
 
@@ -1284,7 +1487,7 @@ Activator::terminationListener()
             {
                 clearInterrupt();
 
-                if(_deactivating && _processes.empty())
+                if(_deactivating && _processes.empty() && _activating == 0)
                 {
                     return;
                 }
@@ -1347,7 +1550,7 @@ Activator::terminationListener()
             //
             // We are deactivating and there's no more active processes.
             //
-            deactivated = _deactivating && _processes.empty();
+            deactivated = _deactivating && _processes.empty() && _activating == 0;
         }
         
         for(vector<Process>::const_iterator p = terminated.begin(); p != terminated.end(); ++p)
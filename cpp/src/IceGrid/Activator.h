@@ -83,11 +83,14 @@ private:
     
 #ifndef _WIN32
     int waitPid(pid_t);
+    bool spawnProcess(const Ice::StringSeq&, const Ice::StringSeq&, const std::string&, uid_t, gid_t, pid_t&, int&);
+    pid_t forkProcess(const Ice::StringSeq&, const Ice::StringSeq&, const std::string&, uid_t, gid_t, int&);
 #endif
 
     TraceLevelsPtr _traceLevels;
     std::map<std::string, Process> _processes;
     bool _deactivating;
+    int _activating;
 
 #ifdef _WIN32
     HANDLE _hIntr;
@@ -40,6 +40,7 @@ const string adaptersDbName = "adapters";
 const string objectsDbName = "objects";
 const string internalObjectsDbName = "internal-objects";
 const string serialsDbName = "serials";
+const string replicaSyncDbName = "replica-sync";
 
 struct ObjectLoadCI : binary_function<pair<Ice::ObjectPrx, float>&, pair<Ice::ObjectPrx, float>&, bool>
 {
@@ -589,6 +590,32 @@ Database::getSerials() const
     return toMap(serials);
 }
 
+bool
+Database::isFullSynchronizationRequired() const
+{
+    SerialsDict dict(Freeze::createConnection(_communicator, _envName), replicaSyncDbName);
+    return dict.find("full") != dict.end();
+}
+
+void
+Database::setFullSynchronizationRequired(bool required)
+{
+    //
+    // The flag is saved with the database so that a replica restarted
+    // after a failed synchronization still requests the whole
+    // database from the master.
+    //
+    SerialsDict dict(Freeze::createConnection(_communicator, _envName), replicaSyncDbName);
+    if(required)
+    {
+        dict.put(SerialsDict::value_type("full", 1));
+    }
+    else
+    {
+        dict.erase("full");
+    }
+}
+
 void
 Database::addApplication(const ApplicationInfo& info, AdminSessionI* session, Ice::Long dbSerial)
 {
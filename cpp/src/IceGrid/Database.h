@@ -84,6 +84,9 @@ public:
 
     StringLongDict getSerials() const;
 
+    bool isFullSynchronizationRequired() const;
+    void setFullSynchronizationRequired(bool);
+
     void addApplication(const ApplicationInfo&, AdminSessionI*, Ice::Long = 0);
     void updateApplication(const ApplicationUpdateInfo&, bool, AdminSessionI*, Ice::Long = 0);
     void syncApplicationDescriptor(const ApplicationDescriptor&, bool, AdminSessionI*);
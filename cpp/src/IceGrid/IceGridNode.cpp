@@ -512,6 +512,12 @@ NodeService::startImpl(int argc, char* argv[], int& status)
     //
     _sessions->create(_node);
 
+    //
+    // Start sampling the node load if enabled, significant load
+    // changes are pushed to the registries.
+    //
+    _node->startLoadSampling();
+
     //
     // Create Admin unless there is a collocated registry with its own Admin
     //
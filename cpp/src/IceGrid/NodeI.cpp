@@ -277,6 +277,24 @@ private:
     AdapterDynamicInfo _info;
 };
 
+class LoadSampleTask : public IceUtil::TimerTask
+{
+public:
+
+    LoadSampleTask(const NodeIPtr& node) : _node(node)
+    {
+    }
+
+    virtual void runTimerTask()
+    {
+        _node->sampleLoad();
+    }
+
+private:
+
+    const NodeIPtr _node;
+};
+
 }
 
 NodeI::Update::Update(const NodeIPtr& node, const NodeObserverPrx& observer) : _node(node), _observer(observer)
@@ -748,6 +766,32 @@ NodeI::read(const string& filename, Ice::Long pos, int size, Ice::Long& newPos,
     return _fileCache->read(getFilePath(filename), pos, size, newPos, lines);
 }
 
+void
+NodeI::startLoadSampling()
+{
+    IceUtil::Time interval = _platform.getLoadSampleInterval();
+    if(interval > IceUtil::Time())
+    {
+        _timer->scheduleRepeated(new LoadSampleTask(this), interval);
+    }
+}
+
+void
+NodeI::sampleLoad()
+{
+    if(_platform.sampleLoad())
+    {
+        if(_traceLevels->node > 2)
+        {
+            LoadInfo load = _platform.getLoadInfo();
+            Ice::Trace out(_traceLevels->logger, _traceLevels->nodeCat);
+            out << "load changed, sending update to the registries ";
+            out << "(load = " << load.avg1 << ", " << load.avg5 << ", " << load.avg15 << ")";
+        }
+        _sessions.loadChanged();
+    }
+}
+
 void
 NodeI::shutdown()
 {
@@ -850,7 +894,7 @@ NodeI::allowEndpointsOverride() const
 NodeSessionPrx
 NodeI::registerWithRegistry(const InternalRegistryPrx& registry)
 {
-    return registry->registerNode(_platform.getInternalNodeInfo(), _proxy, _platform.getLoadInfo());
+    return registry->registerNode(_platform.getInternalNodeInfo(), _proxy, _platform.reportLoadInfo());
 }
 
 void
@@ -109,6 +109,8 @@ public:
     virtual bool read(const std::string&, Ice::Long, int, Ice::Long&, Ice::StringSeq&, const Ice::Current&) const;
 
     void shutdown();
+    void startLoadSampling();
+    void sampleLoad();
     
     IceUtil::TimerPtr getTimer() const;
     Ice::CommunicatorPtr getCommunicator() const;
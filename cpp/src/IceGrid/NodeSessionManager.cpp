@@ -211,7 +211,7 @@ NodeSessionKeepAliveThread::keepAlive(const NodeSessionPrx& session)
 
     try
     {
-        session->keepAlive(_node->getPlatformInfo().getLoadInfo());
+        session->keepAlive(_node->getPlatformInfo().reportLoadInfo());
         return true;
     }
     catch(const Ice::LocalException& ex)
@@ -405,6 +405,26 @@ NodeSessionManager::replicaRemoved(const InternalRegistryPrx& replica)
     //
 }
 
+void
+NodeSessionManager::loadChanged()
+{
+    //
+    // Push the new load to the registries right away, the keep alive
+    // message carries the node load.
+    //
+    Lock sync(*this);
+    if(_destroyed || !_thread)
+    {
+        return;
+    }
+
+    _thread->keepAliveNow();
+    for(NodeSessionMap::const_iterator p = _sessions.begin(); p != _sessions.end(); ++p)
+    {
+        p->second->keepAliveNow();
+    }
+}
+
 NodeSessionKeepAliveThreadPtr
 NodeSessionManager::addReplicaSession(const InternalRegistryPrx& replica)
 {
@@ -66,6 +66,8 @@ public:
     void replicaAdded(const InternalRegistryPrx&);
     void replicaRemoved(const InternalRegistryPrx&);
 
+    void loadChanged();
+
     NodeSessionPrx getMasterNodeSession() const { return _thread->getSession(); }
     std::vector<IceGrid::QueryPrx> getQueryObjects() { return findAllQueryObjects(true); }
 
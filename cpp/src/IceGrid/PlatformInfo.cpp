@@ -19,6 +19,7 @@
 
 #include <set>
 #include <climits>
+#include <cmath>
 
 #if defined(_WIN32)
 #   include <pdhmsg.h> // For PDH_MORE_DATA
@@ -147,6 +148,40 @@ getSocketCount(const Ice::LoggerPtr& logger)
 }
 #endif
 
+#if defined(__linux)
+//
+// Get the number of runnable and blocked processes, this is the value
+// sampled by the kernel every 5 seconds to compute the load averages.
+//
+bool
+getRunQueueLength(int& length)
+{
+    IceUtilInternal::ifstream is(string("/proc/stat"));
+    int running = -1;
+    int blocked = -1;
+    while(is)
+    {
+        string line;
+        getline(is, line);
+        if(line.find("procs_running ") == 0)
+        {
+            running = atoi(line.c_str() + sizeof("procs_running ") - 1);
+        }
+        else if(line.find("procs_blocked ") == 0)
+        {
+            blocked = atoi(line.c_str() + sizeof("procs_blocked ") - 1);
+        }
+    }
+
+    if(running < 0 || blocked < 0)
+    {
+        return false;
+    }
+    length = max(running - 1, 0) + blocked; // Don't count the sampling thread.
+    return true;
+}
+#endif
+
 }
 
 namespace IceGrid
@@ -181,7 +216,9 @@ toNodeInfo(const InternalNodeInfoPtr& node)
 PlatformInfo::PlatformInfo(const string& prefix, 
                            const Ice::CommunicatorPtr& communicator, 
                            const TraceLevelsPtr& traceLevels) : 
-    _traceLevels(traceLevels)
+    _traceLevels(traceLevels),
+    _loadUpdateThreshold(0.1f),
+    _reportedLoad(-1.0f)
 {
     //
     // Initialization of the necessary data structures to get the load average.
@@ -194,6 +231,9 @@ PlatformInfo::PlatformInfo(const string& prefix,
     _last1Total = 0;
     _last5Total = 0;
     _last15Total = 0;
+#elif defined(__linux)
+    _loadSampled = false;
+    _loadAvgs[0] = _loadAvgs[1] = _loadAvgs[2] = 0.0;
 #elif defined(_AIX)
     struct nlist nl;
     nl.n_name = "avenrun";
@@ -335,6 +375,38 @@ PlatformInfo::PlatformInfo(const string& prefix,
     {
         _name = properties->getProperty(prefix + ".Name");
         endpointsPrefix = prefix;
+
+        //
+        // With a sample interval, the node samples its load at the
+        // given interval (in milliseconds) and the load is pushed to
+        // the registries as soon as it changes by more than the update
+        // threshold (in percent of the node capacity, 0 pushes any
+        // change).
+        //
+        int interval = properties->getPropertyAsInt(prefix + ".LoadSampleInterval");
+        if(interval > 0)
+        {
+            _loadSampleInterval = IceUtil::Time::milliSeconds(interval);
+#if !defined(__linux)
+            //
+            // The load averages are only computed by the node on
+            // Linux. On other platforms, the node checks the system
+            // load averages at the sample interval but they don't
+            // change more often than the system updates them.
+            //
+            Ice::Warning out(_traceLevels->logger);
+            out << prefix << ".LoadSampleInterval: the load averages are only sampled by the node on Linux,\n";
+            out << "the system load averages are checked instead and they might change less often";
+#endif
+        }
+        int threshold = properties->getPropertyAsIntWithDefault(prefix + ".LoadUpdateThreshold", 10);
+        if(threshold < 0)
+        {
+            Ice::Warning out(_traceLevels->logger);
+            out << prefix << ".LoadUpdateThreshold < 0; LoadUpdateThreshold adjusted to 10";
+            threshold = 10;
+        }
+        _loadUpdateThreshold = threshold / 100.0f;
     }
 
     Ice::PropertyDict props = properties->getPropertiesForPrefix(endpointsPrefix);
@@ -437,6 +509,84 @@ PlatformInfo::getInternalReplicaInfo() const
     return info;
 }
 
+LoadInfo
+PlatformInfo::reportLoadInfo()
+{
+    LoadInfo info = getLoadInfo();
+
+    //
+    // Remember the load sent to the registries, sampleLoad() compares
+    // the new samples with it.
+    //
+    IceUtil::Mutex::Lock sync(_loadMutex);
+    _reportedLoad = info.avg1;
+    return info;
+}
+
+IceUtil::Time
+PlatformInfo::getLoadSampleInterval() const
+{
+    return _loadSampleInterval;
+}
+
+bool
+PlatformInfo::sampleLoad()
+{
+#if defined(__linux)
+    //
+    // Compute the load averages from the run queue length like the
+    // kernel does, but at the sample interval rather than every 5
+    // seconds.
+    //
+    int length;
+    if(getRunQueueLength(length))
+    {
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        IceUtil::Mutex::Lock sync(_loadMutex);
+        if(!_loadSampled)
+        {
+            double loadAvg[3];
+            if(getloadavg(loadAvg, 3) != -1)
+            {
+                copy(loadAvg, loadAvg + 3, _loadAvgs);
+            }
+            else
+            {
+                _loadAvgs[0] = _loadAvgs[1] = _loadAvgs[2] = length;
+            }
+            _loadSampled = true;
+        }
+        else
+        {
+            static const double periods[3] = { 60.0, 300.0, 900.0 };
+            double elapsed = (now - _lastSampleTime).toSecondsDouble();
+            for(int i = 0; i < 3; ++i)
+            {
+                double decay = exp(-elapsed / periods[i]);
+                _loadAvgs[i] = _loadAvgs[i] * decay + length * (1.0 - decay);
+            }
+        }
+        _lastSampleTime = now;
+    }
+#endif
+
+    //
+    // Return true if the load changed significantly since it was last
+    // sent to the registries.
+    //
+    LoadInfo info = getLoadInfo();
+    IceUtil::Mutex::Lock sync(_loadMutex);
+    if(info.avg1 < 0.0f || _reportedLoad < 0.0f)
+    {
+        return false;
+    }
+    float delta = fabs(info.avg1 - _reportedLoad);
+#if !defined(_WIN32)
+    delta /= _nProcessorThreads; // Unix load averages aren't divided by the number of processors.
+#endif
+    return delta > 0.0f && delta >= _loadUpdateThreshold;
+}
+
 LoadInfo
 PlatformInfo::getLoadInfo()
 {
@@ -451,6 +601,18 @@ PlatformInfo::getLoadInfo()
     info.avg5 = static_cast<float>(_last5Total) / _usages5.size() / 100.0f;
     info.avg15 = static_cast<float>(_last15Total) / _usages15.size() / 100.0f;
 #elif defined(__sun) || defined(__linux) || defined(__APPLE__) || defined(__FreeBSD__)
+#   if defined(__linux)
+    {
+        IceUtil::Mutex::Lock sync(_loadMutex);
+        if(_loadSampled)
+        {
+            info.avg1 = static_cast<float>(_loadAvgs[0]);
+            info.avg5 = static_cast<float>(_loadAvgs[1]);
+            info.avg15 = static_cast<float>(_loadAvgs[2]);
+            return info;
+        }
+    }
+#   endif
     //
     // We use the load average divided by the number of
     // processors to figure out if the machine is busy or
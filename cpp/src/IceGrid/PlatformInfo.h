@@ -46,6 +46,9 @@ public:
     RegistryInfo getRegistryInfo() const;
 
     LoadInfo getLoadInfo();
+    LoadInfo reportLoadInfo();
+    IceUtil::Time getLoadSampleInterval() const;
+    bool sampleLoad();
     int getProcessorSocketCount() const;
     std::string getHostname() const;
     std::string getDataDir() const;
@@ -69,6 +72,16 @@ private:
     std::string _cwd;
     std::string _endpoints;
     int _nProcessorSockets;
+    IceUtil::Time _loadSampleInterval;
+    float _loadUpdateThreshold;
+
+    IceUtil::Mutex _loadMutex;
+    float _reportedLoad;
+#if defined(__linux)
+    bool _loadSampled;
+    IceUtil::Time _lastSampleTime;
+    double _loadAvgs[3];
+#endif
 
 #if defined(_WIN32)
     IceUtil::ThreadPtr _updateUtilizationThread;
@@ -28,6 +28,18 @@ operator==(const ObjectInfo& info, const Ice::Identity& id)
 
 }
 
+namespace
+{
+
+Ice::Long
+getSerial(const StringLongDict& serials, const string& dbName)
+{
+    StringLongDict::const_iterator p = serials.find(dbName);
+    return p != serials.end() ? p->second : -1;
+}
+
+}
+
 ReplicaSessionI::ReplicaSessionI(const DatabasePtr& database, 
                                  const WellKnownObjectsManagerPtr& wellKnownObjects,
                                  const InternalReplicaInfoPtr& info,
@@ -97,6 +109,7 @@ ReplicaSessionI::getTimeout(const Ice::Current&) const
 void
 ReplicaSessionI::setDatabaseObserver(const DatabaseObserverPrx& observer, 
                                      const IceUtil::Optional<StringLongDict>& slaveSerials,
+                                     const IceUtil::Optional<bool>& incremental,
                                      const Ice::Current&)
 {
     //
@@ -147,6 +160,30 @@ ReplicaSessionI::setDatabaseObserver(const DatabaseObserverPrx& observer,
         }
     }
 
+    //
+    // If the slave requests an incremental synchronization, only the
+    // updates which occurred after its database serials are sent to
+    // the slave if still available. Otherwise, the whole databases
+    // are sent.
+    //
+    Ice::Long applicationSerial = -1;
+    Ice::Long adapterSerial = -1;
+    Ice::Long objectSerial = -1;
+    if(slaveSerials && incremental && *incremental)
+    {
+        applicationSerial = getSerial(*slaveSerials, "applications");
+        adapterSerial = getSerial(*slaveSerials, "adapters");
+        objectSerial = getSerial(*slaveSerials, "objects");
+
+        if(_traceLevels->replica > 1)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->replicaCat);
+            out << "replica `" << _info->name << "' requested incremental synchronization (applications serial = `"
+                << applicationSerial << "', adapters serial = `" << adapterSerial << "', objects serial = `"
+                << objectSerial << "')";
+        }
+    }
+
     int serialApplicationObserver;
     int serialAdapterObserver;
     int serialObjectObserver;
@@ -163,9 +200,9 @@ ReplicaSessionI::setDatabaseObserver(const DatabaseObserverPrx& observer,
         }   
         _observer = observer;
 
-        serialApplicationObserver = applicationObserver->subscribe(_observer, _info->name);
-        serialAdapterObserver = adapterObserver->subscribe(_observer, _info->name);
-        serialObjectObserver = objectObserver->subscribe(_observer, _info->name);
+        serialApplicationObserver = applicationObserver->subscribe(_observer, _info->name, applicationSerial);
+        serialAdapterObserver = adapterObserver->subscribe(_observer, _info->name, adapterSerial);
+        serialObjectObserver = objectObserver->subscribe(_observer, _info->name, objectSerial);
     }
 
     applicationObserver->waitForSyncedSubscribers(serialApplicationObserver, _info->name);
@@ -23,9 +23,11 @@ class MasterDatabaseObserverI : public DatabaseObserver, public IceUtil::Mutex
 {
 public:
 
-    MasterDatabaseObserverI(const ReplicaSessionManager::ThreadPtr& thread,
+    MasterDatabaseObserverI(ReplicaSessionManager& manager,
+                            const ReplicaSessionManager::ThreadPtr& thread,
                             const DatabasePtr& database, 
                             const ReplicaSessionPrx& session) : 
+        _manager(manager),
         _thread(thread),
         _database(database),
         _session(session)
@@ -37,6 +39,7 @@ public:
     {
         int serial;
         _database->syncApplications(applications, getSerials(current.ctx, serial));
+        traceInit("applications", applications.size());
         receivedUpdate(ApplicationObserverTopicName, serial);
     }
 
@@ -105,6 +108,7 @@ public:
     {
         int serial;
         _database->syncAdapters(adapters, getSerials(current.ctx, serial));
+        traceInit("adapters", adapters.size());
         receivedUpdate(AdapterObserverTopicName, serial);
     }
 
@@ -161,6 +165,7 @@ public:
     {
         int serial;
         _database->syncObjects(objects, getSerials(current.ctx, serial));
+        traceInit("objects", objects.size());
         receivedUpdate(ObjectObserverTopicName, serial);
     }
 
@@ -259,15 +264,44 @@ private:
         }
     }
     
+    void
+    traceInit(const string& dbName, size_t count)
+    {
+        TraceLevelsPtr traceLevels = _database->getTraceLevels();
+        if(traceLevels->replica > 1)
+        {
+            Ice::Trace out(traceLevels->logger, traceLevels->replicaCat);
+            out << "received the whole `" << dbName << "' database from the master (" << count << " entries)";
+        }
+    }
+
     void 
     receivedUpdate(TopicName name, int serial, const string& failure = string())
     {
-        try
+        //
+        // Updates sent by the master from its update log are sent
+        // without serial, only the last one is acknowledged.
+        //
+        if(!failure.empty())
         {
-            _session->receivedUpdate(name, serial, failure);
+            //
+            // Request the whole database from the master on the next
+            // session, the failure might be caused by an update which
+            // doesn't apply to our database. This is done before the
+            // master is notified of the failure to not race with the
+            // next session creation.
+            //
+            _manager.requireFullSynchronization();
         }
-        catch(const Ice::LocalException&)
+        if(serial >= 0 || !failure.empty())
         {
+            try
+            {
+                _session->receivedUpdate(name, serial, failure);
+            }
+            catch(const Ice::LocalException&)
+            {
+            }
         }
         if(!failure.empty())
         {
@@ -275,6 +309,7 @@ private:
         }
     }
 
+    ReplicaSessionManager& _manager;
     const ReplicaSessionManager::ThreadPtr _thread;
     const DatabasePtr _database;
     const ReplicaSessionPrx _session;
@@ -283,7 +318,7 @@ private:
 };
 
 ReplicaSessionManager::ReplicaSessionManager(const Ice::CommunicatorPtr& communicator, const string& instanceName) :
-    SessionManager(communicator, instanceName) 
+    SessionManager(communicator, instanceName)
 {
 }
 
@@ -411,6 +446,20 @@ ReplicaSessionManager::registerAllWellKnownObjects()
     }
 }
 
+void
+ReplicaSessionManager::requireFullSynchronization()
+{
+    try
+    {
+        _database->setFullSynchronizationRequired(true);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        Ice::Warning out(_communicator->getLogger());
+        out << "couldn't save the full synchronization request:\n" << ex;
+    }
+}
+
 IceGrid::InternalRegistryPrx
 ReplicaSessionManager::findInternalRegistryForReplica(const Ice::Identity& id)
 {
@@ -614,7 +663,7 @@ ReplicaSessionManager::createSessionImpl(const InternalRegistryPrx& registry, Ic
         // to the session so that it can subscribe it. This call only
         // returns once the observer is subscribed and initialized.
         //
-        DatabaseObserverPtr servant = new MasterDatabaseObserverI(_thread, _database, session);
+        DatabaseObserverPtr servant = new MasterDatabaseObserverI(*this, _thread, _database, session);
         _observer = DatabaseObserverPrx::uncheckedCast(_database->getInternalAdapter()->addWithUUID(servant));
         StringLongDict serials = _database->getSerials();
         IceUtil::Optional<StringLongDict> serialsOpt;
@@ -622,7 +671,19 @@ ReplicaSessionManager::createSessionImpl(const InternalRegistryPrx& registry, Ic
         {
             serialsOpt = serials; // Don't provide serials parameter if serials aren't supported.
         }
-        session->setDatabaseObserver(_observer, serialsOpt);
+
+        //
+        // Only request the updates which occurred since our database
+        // serials unless a previous synchronization failed. The
+        // request is cleared before the synchronization: if this one
+        // fails too, the observer saves a new request.
+        //
+        bool incremental = !_database->isFullSynchronizationRequired();
+        if(!incremental)
+        {
+            _database->setFullSynchronizationRequired(false);
+        }
+        session->setDatabaseObserver(_observer, serialsOpt, incremental);
         return session;
     }
     catch(const Ice::Exception&)
@@ -79,6 +79,8 @@ public:
     void registerAllWellKnownObjects();
     ReplicaSessionPrx getSession() const { return _thread ? _thread->getSession() : ReplicaSessionPrx(); }
 
+    void requireFullSynchronization();
+
     IceGrid::InternalRegistryPrx findInternalRegistryForReplica(const Ice::Identity&);
     
 private:
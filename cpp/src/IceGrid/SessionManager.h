@@ -235,6 +235,21 @@ public:
         }
     }
 
+    void
+    keepAliveNow()
+    {
+        //
+        // Send a keep alive without waiting for the timeout if the
+        // session is established and no other action is pending.
+        //
+        Lock sync(*this);
+        if(_state == Connected && _nextAction == None)
+        {
+            _nextAction = KeepAlive;
+            notifyAll();
+        }
+    }
+
     void
     destroyActiveSession()
     {
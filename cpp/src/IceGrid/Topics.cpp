@@ -27,10 +27,189 @@ Ice::EncodingVersion encodings[] = {
     { 1, 1 }
 };
 
+//
+// Updates kept in the update log of the database topics.
+//
+class ApplicationAddedUpdate : public ObserverTopic::Update
+{
+public:
+
+    ApplicationAddedUpdate(const ApplicationInfo& info) : _info(info)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int serial, const Ice::Context& ctx) const
+    {
+        ApplicationObserverPrx::uncheckedCast(obsv)->applicationAdded(serial, _info, ctx);
+    }
+
+private:
+
+    const ApplicationInfo _info;
+};
+
+class ApplicationRemovedUpdate : public ObserverTopic::Update
+{
+public:
+
+    ApplicationRemovedUpdate(const string& name) : _name(name)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int serial, const Ice::Context& ctx) const
+    {
+        ApplicationObserverPrx::uncheckedCast(obsv)->applicationRemoved(serial, _name, ctx);
+    }
+
+private:
+
+    const string _name;
+};
+
+class ApplicationUpdatedUpdate : public ObserverTopic::Update
+{
+public:
+
+    ApplicationUpdatedUpdate(const ApplicationUpdateInfo& info) : _info(info)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int serial, const Ice::Context& ctx) const
+    {
+        ApplicationObserverPrx::uncheckedCast(obsv)->applicationUpdated(serial, _info, ctx);
+    }
+
+private:
+
+    const ApplicationUpdateInfo _info;
+};
+
+class AdapterAddedUpdate : public ObserverTopic::Update
+{
+public:
+
+    AdapterAddedUpdate(const AdapterInfo& info) : _info(info)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int, const Ice::Context& ctx) const
+    {
+        AdapterObserverPrx::uncheckedCast(obsv)->adapterAdded(_info, ctx);
+    }
+
+private:
+
+    const AdapterInfo _info;
+};
+
+class AdapterUpdatedUpdate : public ObserverTopic::Update
+{
+public:
+
+    AdapterUpdatedUpdate(const AdapterInfo& info) : _info(info)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int, const Ice::Context& ctx) const
+    {
+        AdapterObserverPrx::uncheckedCast(obsv)->adapterUpdated(_info, ctx);
+    }
+
+private:
+
+    const AdapterInfo _info;
+};
+
+class AdapterRemovedUpdate : public ObserverTopic::Update
+{
+public:
+
+    AdapterRemovedUpdate(const string& id) : _id(id)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int, const Ice::Context& ctx) const
+    {
+        AdapterObserverPrx::uncheckedCast(obsv)->adapterRemoved(_id, ctx);
+    }
+
+private:
+
+    const string _id;
+};
+
+class ObjectAddedUpdate : public ObserverTopic::Update
+{
+public:
+
+    ObjectAddedUpdate(const ObjectInfo& info) : _info(info)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int, const Ice::Context& ctx) const
+    {
+        ObjectObserverPrx::uncheckedCast(obsv)->objectAdded(_info, ctx);
+    }
+
+private:
+
+    const ObjectInfo _info;
+};
+
+class ObjectUpdatedUpdate : public ObserverTopic::Update
+{
+public:
+
+    ObjectUpdatedUpdate(const ObjectInfo& info) : _info(info)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int, const Ice::Context& ctx) const
+    {
+        ObjectObserverPrx::uncheckedCast(obsv)->objectUpdated(_info, ctx);
+    }
+
+private:
+
+    const ObjectInfo _info;
+};
+
+class ObjectRemovedUpdate : public ObserverTopic::Update
+{
+public:
+
+    ObjectRemovedUpdate(const Ice::Identity& id) : _id(id)
+    {
+    }
+
+    virtual void
+    publish(const Ice::ObjectPrx& obsv, int, const Ice::Context& ctx) const
+    {
+        ObjectObserverPrx::uncheckedCast(obsv)->objectRemoved(_id, ctx);
+    }
+
+private:
+
+    const Ice::Identity _id;
+};
+
 }
 
 ObserverTopic::ObserverTopic(const IceStorm::TopicManagerPrx& topicManager, const string& name, Ice::Long dbSerial) :
-    _logger(topicManager->ice_getCommunicator()->getLogger()), _serial(0), _dbSerial(dbSerial)
+    _logger(topicManager->ice_getCommunicator()->getLogger()), 
+    _serial(0), 
+    _dbSerial(dbSerial),
+    _logSize(topicManager->ice_getCommunicator()->getProperties()->getPropertyAsIntWithDefault(
+                 "IceGrid.Registry.ReplicaUpdateLogSize", 1000)),
+    _logStart(dbSerial)
 {
     for(int i = 0; i < static_cast<int>(sizeof(encodings) / sizeof(Ice::EncodingVersion)); ++i)
     {
@@ -61,7 +240,7 @@ ObserverTopic::~ObserverTopic()
 }
 
 int
-ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
+ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name, Ice::Long dbSerial)
 {
     Lock sync(*this);
     if(_topics.empty())
@@ -70,6 +249,7 @@ ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
     }
 
     assert(obsv);
+    int replayed = -1;
     try
     {
         IceStorm::QoS qos;
@@ -82,7 +262,23 @@ ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
             out << "unsupported encoding version for observer `" << obsv << "'";
             return -1;
         }
-        initObserver(p->second->subscribeAndGetPublisher(qos, obsv->ice_twoway()));
+        Ice::ObjectPrx publisher = p->second->subscribeAndGetPublisher(qos, obsv->ice_twoway());
+
+        //
+        // If the subscriber provided the serial of its database, try
+        // to only send the updates it missed. If the update log
+        // doesn't go back far enough or if an update from the log
+        // failed on the subscriber, send the whole database.
+        //
+        bool fullSync = !name.empty() && _fullSyncSubscribers.erase(name) > 0;
+        if(dbSerial >= 0 && !fullSync)
+        {
+            replayed = initObserverFromLog(publisher, dbSerial);
+        }
+        if(replayed < 0)
+        {
+            initObserver(publisher);
+        }
     }
     catch(const IceStorm::AlreadySubscribed&)
     {
@@ -93,6 +289,10 @@ ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
     {
         assert(_syncSubscribers.find(name) == _syncSubscribers.end());
         _syncSubscribers.insert(name);
+        if(replayed == 0)
+        {
+            return -1; // The subscriber is up-to-date, there's no update to wait for.
+        }
         addExpectedUpdate(_serial, name);
         return _serial;
     }
@@ -159,6 +359,38 @@ void
 ObserverTopic::receivedUpdate(const string& name, int serial, const string& failure)
 {
     Lock sync(*this);
+    if(serial < 0)
+    {
+        //
+        // An update sent from the log without serial failed on the
+        // subscriber. The failure is reported with the update the
+        // subscriber was expected to acknowledge and the whole
+        // database will be sent when it subscribes again.
+        //
+        if(!failure.empty() && !name.empty())
+        {
+            _fullSyncSubscribers.insert(name);
+            map<int, set<string> >::iterator p = _waitForUpdates.begin();
+            while(p != _waitForUpdates.end())
+            {
+                if(p->second.erase(name) > 0)
+                {
+                    _updateFailures[p->first].insert(make_pair(name, failure));
+                }
+                if(p->second.empty())
+                {
+                    _waitForUpdates.erase(p++);
+                }
+                else
+                {
+                    ++p;
+                }
+            }
+            notifyAll();
+        }
+        return;
+    }
+
     map<int, set<string> >::iterator p = _waitForUpdates.find(serial);
     if(p != _waitForUpdates.end())
     {
@@ -288,6 +520,96 @@ ObserverTopic::getContext(int serial, Ice::Long dbSerial) const
     return context;
 }
 
+void
+ObserverTopic::logUpdate(const UpdatePtr& update, Ice::Long dbSerial)
+{
+    // Must be called with the lock held and after updateSerial().
+    if(_logSize <= 0)
+    {
+        return;
+    }
+
+    if(dbSerial < 0)
+    {
+        //
+        // The update doesn't come with a database serial (the master
+        // doesn't support serials), the log can't be used anymore.
+        //
+        clearLog(-1);
+        return;
+    }
+
+    //
+    // Updates without a database serial (such as the registry
+    // well-known objects updates) are logged with the current
+    // database serial. They are idempotent and are sent again to
+    // replicas which are synchronized from the log.
+    //
+    LogEntry entry;
+    entry.update = update;
+    entry.dbSerial = dbSerial > 0 ? dbSerial : _dbSerial;
+    entry.serialized = dbSerial > 0;
+    _log.push_back(entry);
+
+    while(static_cast<int>(_log.size()) > _logSize)
+    {
+        const LogEntry& first = _log.front();
+        _logStart = first.serialized ? first.dbSerial : first.dbSerial + 1;
+        _log.pop_front();
+    }
+}
+
+void
+ObserverTopic::clearLog(Ice::Long dbSerial)
+{
+    // Must be called with the lock held.
+    _log.clear();
+    _logStart = dbSerial;
+}
+
+int
+ObserverTopic::initObserverFromLog(const Ice::ObjectPrx& obsv, Ice::Long dbSerial)
+{
+    // Must be called with the lock held.
+    if(_logStart <= 0 || dbSerial < _logStart || dbSerial > _dbSerial)
+    {
+        return -1;
+    }
+
+    //
+    // Find the first update following the update which set the
+    // database serial of the subscriber. If several updates share
+    // this serial (e.g.: replica group removal), the following ones
+    // are sent again, they are idempotent.
+    //
+    deque<LogEntry>::const_iterator p = _log.begin();
+    if(dbSerial > _logStart)
+    {
+        while(p != _log.end() && (!p->serialized || p->dbSerial != dbSerial))
+        {
+            ++p;
+        }
+        if(p == _log.end())
+        {
+            return -1;
+        }
+        ++p;
+    }
+
+    //
+    // Only the last update is sent with the topic serial, the
+    // subscriber acknowledges it once all the updates are applied.
+    //
+    int count = 0;
+    for(; p != _log.end(); ++p)
+    {
+        int serial = p + 1 == _log.end() ? _serial : -1;
+        p->update->publish(obsv, serial, getContext(serial, p->serialized ? p->dbSerial : 0));
+        ++count;
+    }
+    return count;
+}
+
 RegistryObserverTopic::RegistryObserverTopic(const IceStorm::TopicManagerPrx& topicManager) : 
     ObserverTopic(topicManager, "RegistryObserver")
 {
@@ -582,6 +904,7 @@ ApplicationObserverTopic::applicationInit(Ice::Long dbSerial, const ApplicationI
         return -1;
     }
     updateSerial(dbSerial);
+    clearLog(dbSerial);
     _applications.clear();
     for(ApplicationInfoSeq::const_iterator p = apps.begin(); p != apps.end(); ++p)
     {
@@ -613,6 +936,7 @@ ApplicationObserverTopic::applicationAdded(Ice::Long dbSerial, const Application
     }
 
     updateSerial(dbSerial);
+    logUpdate(new ApplicationAddedUpdate(info), dbSerial);
     _applications.insert(make_pair(info.descriptor.name, info));
     try
     {
@@ -639,6 +963,7 @@ ApplicationObserverTopic::applicationRemoved(Ice::Long dbSerial, const string& n
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new ApplicationRemovedUpdate(name), dbSerial);
     _applications.erase(name);
     try
     {
@@ -666,6 +991,7 @@ ApplicationObserverTopic::applicationUpdated(Ice::Long dbSerial, const Applicati
     }
 
     updateSerial(dbSerial);
+    logUpdate(new ApplicationUpdatedUpdate(info), dbSerial);
     try
     {
         map<string, ApplicationInfo>::iterator p = _applications.find(info.descriptor.name);
@@ -747,6 +1073,7 @@ AdapterObserverTopic::adapterInit(Ice::Long dbSerial, const AdapterInfoSeq& adpt
         return -1;
     }
     updateSerial(dbSerial);
+    clearLog(dbSerial);
     _adapters.clear();
     for(AdapterInfoSeq::const_iterator q = adpts.begin(); q != adpts.end(); ++q)
     {
@@ -777,6 +1104,7 @@ AdapterObserverTopic::adapterAdded(Ice::Long dbSerial, const AdapterInfo& info)
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new AdapterAddedUpdate(info), dbSerial);
     _adapters.insert(make_pair(info.id, info));
     try
     {
@@ -803,6 +1131,7 @@ AdapterObserverTopic::adapterUpdated(Ice::Long dbSerial, const AdapterInfo& info
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new AdapterUpdatedUpdate(info), dbSerial);
     _adapters[info.id] = info;
     try
     {
@@ -829,6 +1158,7 @@ AdapterObserverTopic::adapterRemoved(Ice::Long dbSerial, const string& id)
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new AdapterRemovedUpdate(id), dbSerial);
     _adapters.erase(id);
     try
     {
@@ -875,6 +1205,7 @@ ObjectObserverTopic::objectInit(Ice::Long dbSerial, const ObjectInfoSeq& objects
         return -1;
     }
     updateSerial(dbSerial);
+    clearLog(dbSerial);
     _objects.clear();
     for(ObjectInfoSeq::const_iterator r = objects.begin(); r != objects.end(); ++r)
     {
@@ -905,6 +1236,7 @@ ObjectObserverTopic::objectAdded(Ice::Long dbSerial, const ObjectInfo& info)
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new ObjectAddedUpdate(info), dbSerial);
     _objects.insert(make_pair(info.proxy->ice_getIdentity(), info));
     try
     {
@@ -931,6 +1263,7 @@ ObjectObserverTopic::objectUpdated(Ice::Long dbSerial, const ObjectInfo& info)
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new ObjectUpdatedUpdate(info), dbSerial);
     _objects[info.proxy->ice_getIdentity()] = info;
     try
     {
@@ -957,6 +1290,7 @@ ObjectObserverTopic::objectRemoved(Ice::Long dbSerial, const Ice::Identity& id)
         return -1;
     }
     updateSerial(dbSerial);
+    logUpdate(new ObjectRemovedUpdate(id), dbSerial);
     _objects.erase(id);
     try
     {
@@ -990,6 +1324,7 @@ ObjectObserverTopic::wellKnownObjectsAddedOrUpdated(const ObjectInfoSeq& infos)
         if(q != _objects.end())
         {
             q->second = *p;
+            logUpdate(new ObjectUpdatedUpdate(*p));
             try
             {
                 for(vector<ObjectObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -1006,6 +1341,7 @@ ObjectObserverTopic::wellKnownObjectsAddedOrUpdated(const ObjectInfoSeq& infos)
         else
         {
             _objects.insert(make_pair(p->proxy->ice_getIdentity(), *p));
+            logUpdate(new ObjectAddedUpdate(*p));
             try
             {
                 for(vector<ObjectObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -1043,6 +1379,7 @@ ObjectObserverTopic::wellKnownObjectsRemoved(const ObjectInfoSeq& infos)
     {
         updateSerial();
         _objects.erase(p->proxy->ice_getIdentity());
+        logUpdate(new ObjectRemovedUpdate(p->proxy->ice_getIdentity()));
         try
         {
             for(vector<ObjectObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
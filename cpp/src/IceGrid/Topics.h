@@ -15,6 +15,7 @@
 #include <IceGrid/Internal.h>
 #include <IceGrid/Observer.h>
 #include <set>
+#include <deque>
 
 namespace IceGrid
 {
@@ -23,10 +24,23 @@ class ObserverTopic : public IceUtil::Monitor<IceUtil::Mutex>, virtual public Ic
 {
 public:
 
+    //
+    // An update kept in the topic update log. The update log is used
+    // to only send to a replica the updates it missed since the
+    // serial of its database rather than the whole database.
+    //
+    class Update : public IceUtil::Shared
+    {
+    public:
+
+        virtual void publish(const Ice::ObjectPrx&, int, const Ice::Context&) const = 0;
+    };
+    typedef IceUtil::Handle<Update> UpdatePtr;
+
     ObserverTopic(const IceStorm::TopicManagerPrx&, const std::string&, Ice::Long = 0);
     virtual ~ObserverTopic();
 
-    int subscribe(const Ice::ObjectPrx&, const std::string& = std::string());
+    int subscribe(const Ice::ObjectPrx&, const std::string& = std::string(), Ice::Long = -1);
     void unsubscribe(const Ice::ObjectPrx&, const std::string& = std::string());
     void destroy();
 
@@ -45,6 +59,10 @@ protected:
     void updateSerial(Ice::Long = 0);
     Ice::Context getContext(int, Ice::Long = 0) const;
 
+    void logUpdate(const UpdatePtr&, Ice::Long = 0);
+    void clearLog(Ice::Long);
+    int initObserverFromLog(const Ice::ObjectPrx&, Ice::Long);
+
     template<typename T> std::vector<T> getPublishers() const
     {
         std::vector<T> publishers;
@@ -64,6 +82,20 @@ protected:
     std::set<std::string> _syncSubscribers;
     std::map<int, std::set<std::string> > _waitForUpdates;
     std::map<int, std::map<std::string, std::string> > _updateFailures;
+
+private:
+
+    struct LogEntry
+    {
+        UpdatePtr update;
+        Ice::Long dbSerial;
+        bool serialized;
+    };
+
+    const int _logSize;
+    std::deque<LogEntry> _log;
+    Ice::Long _logStart;
+    std::set<std::string> _fullSyncSubscribers;
 };
 typedef IceUtil::Handle<ObserverTopic> ObserverTopicPtr;
 
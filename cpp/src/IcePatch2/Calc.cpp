@@ -107,6 +107,8 @@ usage(const string& appName)
         "-z, --compress          Always compress files.\n"
         "-Z, --no-compress       Never compress files.\n"
         "-i, --case-insensitive  Files must not differ in case only.\n"
+        "-t, --threads NUM       Checksum and compress files with NUM threads.\n"
+        "-r, --reuse             Reuse the checksums of unchanged files.\n"
         "-V, --verbose           Verbose mode.\n"
         ;
 }
@@ -131,6 +133,8 @@ main(int argc, char* argv[])
     int compress = 1;
     bool verbose;
     bool caseInsensitive;
+    int threads = 1;
+    bool reuse;
 
     IceUtilInternal::Options opts;
     opts.addOpt("h", "help");
@@ -139,6 +143,8 @@ main(int argc, char* argv[])
     opts.addOpt("Z", "no-compress");
     opts.addOpt("V", "verbose");
     opts.addOpt("i", "case-insensitive");
+    opts.addOpt("t", "threads", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("r", "reuse");
     
     vector<string> args;
     try
@@ -180,6 +186,17 @@ main(int argc, char* argv[])
     }
     verbose = opts.isSet("verbose");
     caseInsensitive = opts.isSet("case-insensitive");
+    reuse = opts.isSet("reuse");
+    if(opts.isSet("threads"))
+    {
+        istringstream is(opts.optArg("threads"));
+        if(!(is >> threads) || threads < 1)
+        {
+            cerr << appName << ": the number of threads must be a positive integer" << endl;
+            usage(appName);
+            return EXIT_FAILURE;
+        }
+    }
 
     if(args.empty())
     {
@@ -235,11 +252,17 @@ main(int argc, char* argv[])
         }
     
         LargeFileInfoSeq infoSeq;
+
+        ChecksumCache cache;
+        if(reuse)
+        {
+            loadChecksumCache(absDataDir, cache);
+        }
             
         if(fileSeq.empty())
         {
             CalcCB calcCB;
-            if(!getFileInfoSeq(absDataDir, compress, verbose ? &calcCB : 0, infoSeq))
+            if(!getFileInfoSeq(absDataDir, compress, verbose ? &calcCB : 0, infoSeq, threads, reuse ? &cache : 0))
             {
                 return EXIT_FAILURE;
             }
@@ -253,7 +276,8 @@ main(int argc, char* argv[])
                 LargeFileInfoSeq partialInfoSeq;
 
                 CalcCB calcCB;
-                if(!getFileInfoSeqSubDir(absDataDir, *p, compress, verbose ? &calcCB : 0, partialInfoSeq))
+                if(!getFileInfoSeqSubDir(absDataDir, *p, compress, verbose ? &calcCB : 0, partialInfoSeq, threads,
+                                         reuse ? &cache : 0))
                 {
                     return EXIT_FAILURE;
                 }
@@ -309,6 +333,24 @@ main(int argc, char* argv[])
         }
 
         saveFileInfoSeq(absDataDir, infoSeq);
+
+        if(reuse)
+        {
+            //
+            // Only keep the entries of files that are still part of the
+            // distribution.
+            //
+            ChecksumCache newCache;
+            for(LargeFileInfoSeq::const_iterator p = infoSeq.begin(); p != infoSeq.end(); ++p)
+            {
+                ChecksumCache::const_iterator q = cache.find(p->path);
+                if(q != cache.end())
+                {
+                    newCache.insert(*q);
+                }
+            }
+            saveChecksumCache(absDataDir, newCache);
+        }
     }
     catch(const string& ex)
     {
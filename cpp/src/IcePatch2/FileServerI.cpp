@@ -24,8 +24,95 @@ using namespace Ice;
 using namespace IcePatch2;
 using namespace IcePatch2Internal;
 
-IcePatch2::FileServerI::FileServerI(const std::string& dataDir, const LargeFileInfoSeq& infoSeq) :
-    _dataDir(dataDir), _tree0(FileTree0())
+IcePatch2::FileServerI::OpenFile::OpenFile(const string& absolutePath, const string& path) :
+    _path(path),
+    _fd(IceUtilInternal::open(absolutePath, O_RDONLY|O_BINARY))
+{
+    if(_fd == -1)
+    {
+        throw FileAccessException(string("cannot open `") + path + "' for reading: " + strerror(errno));
+    }
+
+    IceUtilInternal::structstat buf;
+    if(IceUtilInternal::stat(absolutePath, &buf) == -1)
+    {
+        IceUtilInternal::close(_fd);
+        throw FileAccessException(string("cannot stat `") + path + "':\n" + IceUtilInternal::lastErrorToString());
+    }
+    _size = buf.st_size;
+    _mtime = buf.st_mtime;
+    _ino = buf.st_ino;
+    _checked = IceUtil::Time::now(IceUtil::Time::Monotonic);
+}
+
+IcePatch2::FileServerI::OpenFile::~OpenFile()
+{
+    IceUtilInternal::close(_fd);
+}
+
+bool
+IcePatch2::FileServerI::OpenFile::isCurrent(const string& absolutePath, const IceUtil::Time& now)
+{
+    //
+    // Check the file at most once per second rather than for each
+    // chunk. The path is checked instead of the open descriptor to
+    // also detect a file replaced by another file.
+    //
+    if(now - _checked < IceUtil::Time::seconds(1))
+    {
+        return true;
+    }
+
+    IceUtilInternal::structstat buf;
+    if(IceUtilInternal::stat(absolutePath, &buf) == -1 ||
+       buf.st_size != _size || buf.st_mtime != _mtime || buf.st_ino != _ino)
+    {
+        return false;
+    }
+    _checked = now;
+    return true;
+}
+
+void
+IcePatch2::FileServerI::OpenFile::read(Long pos, Int num, vector<Byte>& buffer)
+{
+    //
+    // The file might be truncated or rewritten while it's open, a
+    // short read returns less data than the requested chunk.
+    //
+    Long end = min(pos + num, _size);
+    if(pos >= end)
+    {
+        return;
+    }
+
+    buffer.resize(static_cast<size_t>(end - pos));
+#ifdef _WIN32
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_lseek(_fd, static_cast<off_t>(pos), SEEK_SET) != static_cast<off_t>(pos))
+    {
+        ostringstream posStr;
+        posStr << pos;
+
+        throw FileAccessException("cannot seek position " + posStr.str() + " in file `" + _path + "': " +
+                                  strerror(errno));
+    }
+
+    int r;
+    if((r = _read(_fd, &buffer[0], static_cast<unsigned int>(buffer.size()))) == -1)
+#else
+    ssize_t r;
+    if((r = pread(_fd, &buffer[0], buffer.size(), static_cast<off_t>(pos))) == -1)
+#endif
+    {
+        throw FileAccessException("cannot read `" + _path + "': " + strerror(errno));
+    }
+
+    buffer.resize(static_cast<size_t>(r));
+}
+
+IcePatch2::FileServerI::FileServerI(const std::string& dataDir, const LargeFileInfoSeq& infoSeq, int fileCacheSize) :
+    _dataDir(dataDir), _tree0(FileTree0()), _fileCacheSize(fileCacheSize > 0 ? fileCacheSize : 0)
 {
     FileTree0& tree0 = const_cast<FileTree0&>(_tree0);
     getFileTree0(infoSeq, tree0);
@@ -79,14 +166,13 @@ IcePatch2::FileServerI::getFileCompressed_async(const AMD_FileServer_getFileComp
     {
         vector<Byte> buffer;
         getFileCompressedInternal(pa, pos, num, buffer, false);
-        if(buffer.empty())
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
-        }
-        else
+        pair<const Byte*, const Byte*> data(0, 0);
+        if(!buffer.empty())
         {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size()));
+            data.first = &buffer[0];
+            data.second = data.first + buffer.size();
         }
+        cb->ice_response(data);
     }
     catch(const std::exception& ex)
     {
@@ -102,15 +188,13 @@ IcePatch2::FileServerI::getLargeFileCompressed_async(const AMD_FileServer_getLar
     {
         vector<Byte> buffer;
         getFileCompressedInternal(pa, pos, num, buffer, true);
-        if(buffer.empty())
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
-        }
-        else
+        pair<const Byte*, const Byte*> data(0, 0);
+        if(!buffer.empty())
         {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size()));
+            data.first = &buffer[0];
+            data.second = data.first + buffer.size();
         }
-        
+        cb->ice_response(data);
     }
     catch(const std::exception& ex)
     {
@@ -141,58 +225,56 @@ IcePatch2::FileServerI::getFileCompressedInternal(const std::string& pa, Ice::Lo
         return;
     }
     
-    string absolutePath = _dataDir + '/' + path + ".bz2";
-    int fd = IceUtilInternal::open(absolutePath, O_RDONLY|O_BINARY);
-    if(fd == -1)
-    {
-        throw FileAccessException(string("cannot open `") + path + "' for reading: " + strerror(errno));
-    }
+    OpenFilePtr file = openFile(path);
     
-    if(!largeFile)
+    if(!largeFile && file->size() > 0x7FFFFFFF)
     {
-        IceUtilInternal::structstat buf;
-        if(IceUtilInternal::stat(absolutePath, &buf) == -1)
-        {
-            throw FileAccessException(string("cannot stat `") + path + "':\n" + IceUtilInternal::lastErrorToString());
-        }
-        
-        if(buf.st_size > 0x7FFFFFFF)
-        {
-            ostringstream os;
-            os << "cannot encode size `" << buf.st_size << "' for file `" << path << "' as Ice::Int" << endl;
-            throw FileAccessException(os.str());
-        }
+        ostringstream os;
+        os << "cannot encode size `" << file->size() << "' for file `" << path << "' as Ice::Int" << endl;
+        throw FileAccessException(os.str());
     }
 
-    if(
-#if defined(_MSC_VER)
-        _lseek(fd, static_cast<off_t>(pos), SEEK_SET)
-#else
-        lseek(fd, static_cast<off_t>(pos), SEEK_SET)
-#endif
-        != static_cast<off_t>(pos))
-    {
-        IceUtilInternal::close(fd);
+    file->read(pos, num, buffer);
+}
 
-        ostringstream posStr;
-        posStr << pos;
+IcePatch2::FileServerI::OpenFilePtr
+IcePatch2::FileServerI::openFile(const string& path) const
+{
+    const string absolutePath = _dataDir + '/' + path + ".bz2";
 
-        throw FileAccessException("cannot seek position " + posStr.str() + " in file `" + path + "': " +
-                                  strerror(errno));
-    }
+    IceUtil::Mutex::Lock sync(_mutex);
 
-    buffer.resize(num);
-#ifdef _WIN32
-    int r;
-    if((r = _read(fd, &buffer[0], static_cast<unsigned int>(num))) == -1)
-#else
-    ssize_t r;
-    if((r = read(fd, &buffer[0], static_cast<size_t>(num))) == -1)
-#endif
+    map<string, OpenFileList::iterator>::iterator p = _openFileMap.find(path);
+    if(p != _openFileMap.end())
     {
-        IceUtilInternal::close(fd);
-        throw FileAccessException("cannot read `" + path + "': " + strerror(errno));
+        //
+        // Reopen the file if it was modified or replaced since it was
+        // opened, for example if icepatch2calc ran against the data
+        // directory.
+        //
+        if(p->second->second->isCurrent(absolutePath, IceUtil::Time::now(IceUtil::Time::Monotonic)))
+        {
+            _openFiles.splice(_openFiles.begin(), _openFiles, p->second);
+            return p->second->second;
+        }
+        _openFiles.erase(p->second);
+        _openFileMap.erase(p);
     }
 
-    IceUtilInternal::close(fd);
+    OpenFilePtr file = new OpenFile(absolutePath, path);
+    if(_fileCacheSize > 0)
+    {
+        //
+        // An evicted file is closed once the requests still using it
+        // release it.
+        //
+        _openFiles.push_front(make_pair(path, file));
+        _openFileMap.insert(make_pair(path, _openFiles.begin()));
+        if(_openFileMap.size() > _fileCacheSize)
+        {
+            _openFileMap.erase(_openFiles.back().first);
+            _openFiles.pop_back();
+        }
+    }
+    return file;
 }
@@ -10,9 +10,13 @@
 #ifndef ICE_PATCH2_FILE_SERVER_I_H
 #define ICE_PATCH2_FILE_SERVER_I_H
 
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
 #include <IcePatch2Lib/Util.h>
 #include <IcePatch2/FileServer.h>
 
+#include <list>
+
 namespace IcePatch2
 {
 
@@ -20,7 +24,7 @@ class FileServerI : public FileServer
 {
 public:
 
-    FileServerI(const std::string&, const LargeFileInfoSeq&);
+    FileServerI(const std::string&, const LargeFileInfoSeq&, int);
 
     FileInfoSeq getFileInfoSeq(Ice::Int, const Ice::Current&) const;
     
@@ -44,16 +48,59 @@ public:
                                       const Ice::Current&) const;
 
 private:
-    
-    void
-    getFileCompressedInternal(const std::string&,
-                              Ice::Long,
-                              Ice::Int, 
-                              std::vector<Ice::Byte>&,
-                              bool) const;
+
+    //
+    // A compressed file kept open to serve its chunks without
+    // reopening it for each request. The chunks are read with pread
+    // rather than served from a mapping of the file: a mapped file
+    // that is truncated or rewritten, for example by icepatch2calc,
+    // raises SIGBUS when the mapping is read.
+    //
+    class OpenFile : public IceUtil::Shared
+    {
+    public:
+
+        OpenFile(const std::string&, const std::string&);
+        virtual ~OpenFile();
+
+        Ice::Long size() const
+        {
+            return _size;
+        }
+
+        bool isCurrent(const std::string&, const IceUtil::Time&);
+
+        void read(Ice::Long, Ice::Int, std::vector<Ice::Byte>&);
+
+    private:
+
+        const std::string _path;
+        int _fd;
+        Ice::Long _size;
+        time_t _mtime;
+        ino_t _ino;
+        IceUtil::Time _checked;
+#ifdef _WIN32
+        IceUtil::Mutex _mutex;
+#endif
+    };
+    typedef IceUtil::Handle<OpenFile> OpenFilePtr;
+
+    void getFileCompressedInternal(const std::string&, Ice::Long, Ice::Int, std::vector<Ice::Byte>&, bool) const;
+
+    OpenFilePtr openFile(const std::string&) const;
 
     const std::string _dataDir;
     const IcePatch2Internal::FileTree0 _tree0;
+    const size_t _fileCacheSize;
+
+    //
+    // The open files, most recently used first.
+    //
+    typedef std::list<std::pair<std::string, OpenFilePtr> > OpenFileList;
+    mutable IceUtil::Mutex _mutex;
+    mutable OpenFileList _openFiles;
+    mutable std::map<std::string, OpenFileList::iterator> _openFileMap;
 };
 
 }
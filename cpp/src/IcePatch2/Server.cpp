@@ -141,7 +141,8 @@ IcePatch2::PatcherService::start(int argc, char* argv[], int& status)
     Identity id;
     id.category = instanceName;
     id.name = "server";
-    adapter->add(new FileServerI(dataDir, infoSeq), id);
+    int fileCacheSize = properties->getPropertyAsIntWithDefault("IcePatch2.FileCacheSize", 64);
+    adapter->add(new FileServerI(dataDir, infoSeq, fileCacheSize), id);
 
     adapter->activate();
 
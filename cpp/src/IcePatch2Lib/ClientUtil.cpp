@@ -13,6 +13,7 @@
 #include <IcePatch2/ClientUtil.h>
 #include <IcePatch2Lib/Util.h>
 #include <list>
+#include <deque>
 #include <iterator>
 
 using namespace std;
@@ -24,27 +25,49 @@ using namespace IcePatch2Internal;
 namespace
 {
 
-class Decompressor : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+class Decompressor : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
 
     Decompressor(const string&);
     virtual ~Decompressor();
 
+    void start(int);
     void destroy();
     void add(const LargeFileInfo&);
     void exception() const;
     void log(FILE* fp);
-    virtual void run();
+    void run();
 
 private:
 
+    class DecompressorThread : public IceUtil::Thread
+    {
+    public:
+
+        DecompressorThread(Decompressor* decompressor) :
+            IceUtil::Thread("IcePatch2 decompressor thread"),
+            _decompressor(decompressor)
+        {
+        }
+
+        virtual void run()
+        {
+            _decompressor->run();
+        }
+
+    private:
+
+        Decompressor* _decompressor;
+    };
+
     const string _dataDir;
 
     string _exception;
     list<LargeFileInfo> _files;
     LargeFileInfoSeq _filesDone;
     bool _destroy;
+    vector<IceUtil::ThreadControl> _threads;
 };
 typedef IceUtil::Handle<Decompressor> DecompressorPtr;
 
@@ -73,6 +96,8 @@ private:
     const bool _thorough;
     const Ice::Int _chunkSize;
     const Ice::Int _remove;
+    const size_t _maxInFlight;
+    const int _decompressThreads;
     const FileServerPrx _serverCompress;
     const FileServerPrx _serverNoCompress;
 
@@ -96,12 +121,41 @@ Decompressor::~Decompressor()
     assert(_destroy);
 }
 
+void
+Decompressor::start(int size)
+{
+    for(int i = 0; i < size; ++i)
+    {
+        IceUtil::ThreadPtr thread = new DecompressorThread(this);
+#if defined(__hppa)
+        //
+        // The thread stack size is only 64KB only HP-UX and that's not
+        // enough for this thread.
+        //
+        _threads.push_back(thread->start(256 * 1024)); // 256KB
+#else 
+        _threads.push_back(thread->start());
+#endif
+    }
+}
+
 void
 Decompressor::destroy()
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    _destroy = true;
-    notify();
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        _destroy = true;
+        notifyAll();
+    }
+
+    //
+    // Wait for the files queued so far to be decompressed.
+    //
+    for(vector<IceUtil::ThreadControl>::iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        p->join();
+    }
+    _threads.clear();
 }
 
 void
@@ -162,7 +216,7 @@ Decompressor::run()
                 wait();
             }
         
-            if(!_files.empty())
+            if(!_files.empty() && _exception.empty())
             {
                 info = _files.front();
                 _files.pop_front();
@@ -183,7 +237,11 @@ Decompressor::run()
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
             _destroy = true;
-            _exception = ex;
+            if(_exception.empty())
+            {
+                _exception = ex;
+            }
+            notifyAll();
             return;
         }
     }
@@ -196,6 +254,9 @@ PatcherI::PatcherI(const CommunicatorPtr& communicator, const PatcherFeedbackPtr
     _thorough(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.Thorough", 0) > 0),
     _chunkSize(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.ChunkSize", 100)),
     _remove(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.Remove", 1)),
+    _maxInFlight(max(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.MaxInFlight", 8), 1)),
+    _decompressThreads(max(communicator->getProperties()->getPropertyAsIntWithDefault(
+                               "IcePatch2Client.DecompressThreads", 2), 1)),
     _log(0),
     _useSmallFileAPI(false)
 {
@@ -226,6 +287,10 @@ PatcherI::PatcherI(const FileServerPrx& server,
     _thorough(thorough),
     _chunkSize(chunkSize),
     _remove(remove),
+    _maxInFlight(max(server->ice_getCommunicator()->getProperties()->getPropertyAsIntWithDefault(
+                         "IcePatch2Client.MaxInFlight", 8), 1)),
+    _decompressThreads(max(server->ice_getCommunicator()->getProperties()->getPropertyAsIntWithDefault(
+                               "IcePatch2Client.DecompressThreads", 2), 1)),
     _useSmallFileAPI(false)
 {
     init(server);
@@ -690,15 +755,7 @@ bool
 PatcherI::updateFiles(const LargeFileInfoSeq& files)
 {
     DecompressorPtr decompressor = new Decompressor(_dataDir);
-#if defined(__hppa)
-    //
-    // The thread stack size is only 64KB only HP-UX and that's not
-    // enough for this thread.
-    //
-    decompressor->start(256 * 1024); // 256KB
-#else 
-    decompressor->start();
-#endif
+    decompressor->start(_decompressThreads);
     bool result;
 
     try
@@ -708,13 +765,11 @@ PatcherI::updateFiles(const LargeFileInfoSeq& files)
     catch(...)
     {
         decompressor->destroy();
-        decompressor->getThreadControl().join();
         decompressor->log(_log);
         throw;
     }
     
     decompressor->destroy();
-    decompressor->getThreadControl().join();
     decompressor->log(_log);
     decompressor->exception();
 
@@ -735,8 +790,15 @@ PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DecompressorP
         }
     }
     
-    AsyncResultPtr curCB;
-    AsyncResultPtr nxtCB;
+    //
+    // Chunk requests are sent ahead of the file being written, across
+    // file boundaries, keeping up to _maxInFlight requests pending.
+    // The replies are consumed in request order, the files are
+    // therefore still written and reported sequentially.
+    //
+    deque<AsyncResultPtr> pending;
+    LargeFileInfoSeq::const_iterator next = files.begin();
+    Ice::Long nextPos = 0;
 
     for(LargeFileInfoSeq::const_iterator p = files.begin(); p != files.end(); ++p)
     {
@@ -795,42 +857,26 @@ PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DecompressorP
 
                     while(pos < p->size)
                     {
-                        if(!curCB)
-                        {
-                            assert(!nxtCB);
-                            curCB = _useSmallFileAPI ? 
-                                _serverNoCompress->begin_getFileCompressed(p->path, static_cast<Ice::Int>(pos), _chunkSize) :
-                                _serverNoCompress->begin_getLargeFileCompressed(p->path, pos, _chunkSize);
-                        }
-                        else
+                        while(pending.size() < _maxInFlight && next != files.end())
                         {
-                            assert(nxtCB);
-                            swap(nxtCB, curCB);
-                        }
-
-                        if(pos + _chunkSize < p->size)
-                        {
-                            nxtCB = _useSmallFileAPI ?
-                                _serverNoCompress->begin_getFileCompressed(p->path, static_cast<Ice::Int>(pos + _chunkSize), _chunkSize) :
-                                _serverNoCompress->begin_getLargeFileCompressed(p->path, pos + _chunkSize, _chunkSize);
-                        }
-                        else
-                        {
-                            LargeFileInfoSeq::const_iterator q = p + 1;
-
-                            while(q != files.end() && q->size <= 0)
+                            if(nextPos >= next->size) // Directory, empty file or all chunks requested.
                             {
-                                ++q;
+                                ++next;
+                                nextPos = 0;
+                                continue;
                             }
 
-                            if(q != files.end())
-                            {
-                                nxtCB = _useSmallFileAPI ?
-                                    _serverNoCompress->begin_getFileCompressed(q->path, 0, _chunkSize) :
-                                    _serverNoCompress->begin_getLargeFileCompressed(q->path, 0, _chunkSize);
-                            }
+                            pending.push_back(_useSmallFileAPI ?
+                                _serverNoCompress->begin_getFileCompressed(next->path, static_cast<Ice::Int>(nextPos),
+                                                                           _chunkSize) :
+                                _serverNoCompress->begin_getLargeFileCompressed(next->path, nextPos, _chunkSize));
+                            nextPos += _chunkSize;
                         }
 
+                        assert(!pending.empty());
+                        AsyncResultPtr curCB = pending.front();
+                        pending.pop_front();
+
                         ByteSeq bytes;
 
                         try
@@ -843,18 +889,26 @@ PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DecompressorP
                             throw "error from IcePatch2 server for `" + p->path + "': " + ex.reason;
                         }
 
-                        if(bytes.empty())
+                        //
+                        // Each chunk must be complete, the following
+                        // requests were sent for the next positions.
+                        // Older servers pad the last chunk of a file
+                        // up to the requested size, only the expected
+                        // bytes are written.
+                        //
+                        const Ice::Long expected = min<Ice::Long>(_chunkSize, p->size - pos);
+                        if(expected <= 0 || static_cast<Ice::Long>(bytes.size()) < expected)
                         {
                             throw "size mismatch for `" + p->path + "'";
                         }
 
-                        if(fwrite(reinterpret_cast<char*>(&bytes[0]), bytes.size(), 1, fileBZ2) != 1)
+                        if(fwrite(reinterpret_cast<char*>(&bytes[0]), static_cast<size_t>(expected), 1, fileBZ2) != 1)
                         {
                             throw ": cannot write `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString();
                         }
 
-                        pos += bytes.size();
-                        updated += bytes.size();
+                        pos += expected;
+                        updated += expected;
 
                         if(!_feedback->patchProgress(pos, p->size, updated, total))
                         {
@@ -36,6 +36,7 @@
 #endif
 
 #include <iterator>
+#include <deque>
 
 // Ignore OS X OpenSSL deprecation warnings
 #ifdef __APPLE__
@@ -44,6 +45,7 @@
 
 const char* IcePatch2Internal::checksumFile = "IcePatch2.sum";
 const char* IcePatch2Internal::logFile = "IcePatch2.log";
+const char* IcePatch2Internal::checksumCacheFile = "IcePatch2.cache";
 
 using namespace std;
 using namespace Ice;
@@ -750,11 +752,369 @@ IcePatch2Internal::setFileFlags(const string&, const LargeFileInfo&)
 namespace
 {
 
+class ChecksumJob : public IceUtil::Shared
+{
+public:
+
+    ChecksumJob(const string& path, const string& relPath, Long fileSize, Long mtime, bool doCompress,
+                LargeFileInfoSeq::size_type index, const LargeFileInfo& info) :
+        path(path),
+        relPath(relPath),
+        fileSize(fileSize),
+        mtime(mtime),
+        doCompress(doCompress),
+        index(index),
+        info(info)
+    {
+    }
+
+    void run();
+
+    const string path;
+    const string relPath;
+    const Long fileSize;
+    const Long mtime;
+    const bool doCompress;
+    const LargeFileInfoSeq::size_type index;
+    LargeFileInfo info;
+};
+typedef IceUtil::Handle<ChecksumJob> ChecksumJobPtr;
+
+void
+ChecksumJob::run()
+{
+    const string pathBZ2 = path + ".bz2";
+    IceUtilInternal::structstat bufBZ2;
+
+    ByteSeq bytesSHA;
+
+    if(relPath.size() + fileSize == 0)
+    {
+        bytesSHA.resize(20);
+        fill(bytesSHA.begin(), bytesSHA.end(), 0);
+    }
+    else
+    {
+        IceUtilInternal::SHA1 hasher;
+        if(relPath.size() != 0)
+        {
+            hasher.update(reinterpret_cast<const IceUtil::Byte*>(relPath.c_str()), relPath.size());
+        }
+
+        if(fileSize != 0)
+        {
+            int fd = IceUtilInternal::open(path.c_str(), O_BINARY|O_RDONLY);
+            if(fd == -1)
+            {
+                throw "cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString();
+            }
+
+            const string pathBZ2Temp = path + ".bz2temp";
+            FILE* stdioFile = 0;
+            int bzError = 0;
+            BZFILE* bzFile = 0;
+            if(doCompress)
+            {
+                stdioFile = IceUtilInternal::fopen(simplify(pathBZ2Temp), "wb");
+                if(!stdioFile)
+                {
+                    IceUtilInternal::close(fd);
+                    throw "cannot open `" + pathBZ2Temp + "' for writing:\n" + IceUtilInternal::lastErrorToString();
+                }
+
+                bzFile = BZ2_bzWriteOpen(&bzError, stdioFile, 5, 0, 0);
+                if(bzError != BZ_OK)
+                {
+                    string ex = "BZ2_bzWriteOpen failed";
+                    if(bzError == BZ_IO_ERROR)
+                    {
+                    ex += string(": ") + IceUtilInternal::lastErrorToString();
+                    }
+                    fclose(stdioFile);
+                    IceUtilInternal::close(fd);
+                    throw ex;
+                }
+            }
+
+            long bytesLeft = fileSize;
+            while(bytesLeft > 0)
+            {
+                ByteSeq bytes(min(bytesLeft, 1024l*1024));
+                if(
+#if defined(_MSC_VER)
+                    _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#else
+                    read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#endif
+                    == -1)
+                {
+                    if(doCompress)
+                    {
+                        fclose(stdioFile);
+                    }
+                    
+                    IceUtilInternal::close(fd);
+                    throw "cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString();
+                }
+                bytesLeft -= static_cast<unsigned int>(bytes.size());
+                if(doCompress)
+                {
+                    BZ2_bzWrite(&bzError, bzFile, const_cast<Byte*>(&bytes[0]), static_cast<int>(bytes.size()));
+                    if(bzError != BZ_OK)
+                    {
+                        string ex = "BZ2_bzWrite failed";
+                        if(bzError == BZ_IO_ERROR)
+                        {
+                            ex += string(": ") + IceUtilInternal::lastErrorToString();
+                        }
+                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                        fclose(stdioFile);
+                        IceUtilInternal::close(fd);
+                        throw ex;
+                    }
+                }
+
+                hasher.update(reinterpret_cast<IceUtil::Byte*>(&bytes[0]), bytes.size());
+            }
+
+            IceUtilInternal::close(fd);
+
+            if(doCompress)
+            {
+                BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                if(bzError != BZ_OK)
+                {
+                    string ex = "BZ2_bzWriteClose failed";
+                    if(bzError == BZ_IO_ERROR)
+                    {
+                        ex += string(": ") + IceUtilInternal::lastErrorToString();
+                    }
+                    fclose(stdioFile);
+                    throw ex;
+                }
+
+                fclose(stdioFile);
+
+                rename(pathBZ2Temp, pathBZ2);
+
+                if(IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1)
+                {
+                    throw "cannot stat `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString();
+                }
+
+                info.size = bufBZ2.st_size;
+            }
+        }
+        hasher.finalize(bytesSHA);
+    }
+
+    info.checksum.swap(bytesSHA);
+}
+
+//
+// Bounded queue of checksum jobs served by a pool of worker threads.
+// The directory walk blocks in add() when the workers fall behind, so
+// the number of files being read at any time is bounded by the pool.
+//
+class ChecksumWorkQueue : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    ChecksumWorkQueue(int);
+    ~ChecksumWorkQueue();
+
+    void add(const ChecksumJobPtr&);
+    void finish();
+    void abort();
+    void run();
+
+private:
+
+    void join();
+
+    deque<ChecksumJobPtr> _queue;
+    const deque<ChecksumJobPtr>::size_type _maxQueued;
+    bool _done;
+    string _exception;
+    vector<IceUtil::ThreadControl> _threads;
+};
+
+class ChecksumThread : public IceUtil::Thread
+{
+public:
+
+    ChecksumThread(ChecksumWorkQueue& queue) :
+        IceUtil::Thread("IcePatch2 checksum thread"),
+        _queue(queue)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _queue.run();
+    }
+
+private:
+
+    ChecksumWorkQueue& _queue;
+};
+
+ChecksumWorkQueue::ChecksumWorkQueue(int threads) :
+    _maxQueued(static_cast<deque<ChecksumJobPtr>::size_type>(threads) * 2),
+    _done(false)
+{
+    try
+    {
+        for(int i = 0; i < threads; ++i)
+        {
+            IceUtil::ThreadPtr thread = new ChecksumThread(*this);
+            _threads.push_back(thread->start());
+        }
+    }
+    catch(const IceUtil::Exception& ex)
+    {
+        abort();
+        ostringstream os;
+        os << "cannot start checksum thread:\n" << ex;
+        throw os.str();
+    }
+}
+
+ChecksumWorkQueue::~ChecksumWorkQueue()
+{
+    abort();
+}
+
+void
+ChecksumWorkQueue::add(const ChecksumJobPtr& job)
+{
+    Lock sync(*this);
+    while(_queue.size() >= _maxQueued && _exception.empty())
+    {
+        wait();
+    }
+    if(!_exception.empty())
+    {
+        throw _exception;
+    }
+    _queue.push_back(job);
+    notifyAll();
+}
+
+void
+ChecksumWorkQueue::finish()
+{
+    {
+        Lock sync(*this);
+        _done = true;
+        notifyAll();
+    }
+
+    join();
+
+    if(!_exception.empty())
+    {
+        throw _exception;
+    }
+}
+
+void
+ChecksumWorkQueue::abort()
+{
+    {
+        Lock sync(*this);
+        _queue.clear();
+        _done = true;
+        notifyAll();
+    }
+
+    join();
+}
+
+void
+ChecksumWorkQueue::run()
+{
+    while(true)
+    {
+        ChecksumJobPtr job;
+        {
+            Lock sync(*this);
+            while(_queue.empty() && !_done)
+            {
+                wait();
+            }
+            if(_queue.empty())
+            {
+                return;
+            }
+            job = _queue.front();
+            _queue.pop_front();
+            notifyAll();
+        }
+
+        string exception;
+        try
+        {
+            job->run();
+        }
+        catch(const string& ex)
+        {
+            exception = ex;
+        }
+        catch(const char* ex)
+        {
+            exception = ex;
+        }
+        catch(const std::exception& ex)
+        {
+            exception = ex.what();
+        }
+
+        if(!exception.empty())
+        {
+            Lock sync(*this);
+            if(_exception.empty())
+            {
+                _exception = exception;
+            }
+            _queue.clear();
+            notifyAll();
+        }
+    }
+}
+
+void
+ChecksumWorkQueue::join()
+{
+    for(vector<IceUtil::ThreadControl>::iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        p->join();
+    }
+    _threads.clear();
+}
+
+struct GetFileInfoSeqContext
+{
+    GetFileInfoSeqContext(int compress, GetFileInfoSeqCB* cb, ChecksumWorkQueue* queue, ChecksumCache* cache) :
+        compress(compress), cb(cb), queue(queue), cache(cache)
+    {
+    }
+
+    const int compress;
+    GetFileInfoSeqCB* const cb;
+    ChecksumWorkQueue* const queue;
+    ChecksumCache* const cache;
+    vector<ChecksumJobPtr> jobs;
+};
+
 static bool
-getFileInfoSeqInternal(const string& basePath, const string& relPath, int compress, GetFileInfoSeqCB* cb,
+getFileInfoSeqInternal(const string& basePath, const string& relPath, GetFileInfoSeqContext& ctx,
                        LargeFileInfoSeq& infoSeq)
 {
-    if(relPath == checksumFile || relPath == logFile)
+    GetFileInfoSeqCB* cb = ctx.cb;
+
+    if(relPath == checksumFile || relPath == logFile || relPath == checksumCacheFile)
     {
         return true;
     }
@@ -839,7 +1199,7 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             StringSeq content = readDirectory(path);
             for(StringSeq::const_iterator p = content.begin(); p != content.end() ; ++p)
             {
-                if(!getFileInfoSeqInternal(basePath, simplify(relPath + '/' + *p), compress, cb, infoSeq))
+                if(!getFileInfoSeqInternal(basePath, simplify(relPath + '/' + *p), ctx, infoSeq))
                 {
                     return false;
                 }
@@ -859,14 +1219,15 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             IceUtilInternal::structstat bufBZ2;
             const string pathBZ2 = path + ".bz2";
             bool doCompress = false;
-            if(buf.st_size != 0 && compress > 0)
+            if(buf.st_size != 0 && ctx.compress > 0)
             {
                 //
                 // compress == 0: Never compress.
                 // compress == 1: Compress if necessary.
                 // compress >= 2: Always compress.
                 //
-                if(compress >= 2 || IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1 || buf.st_mtime >= bufBZ2.st_mtime)
+                if(ctx.compress >= 2 || IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1 ||
+                   buf.st_mtime >= bufBZ2.st_mtime)
                 {
                     if(cb && !cb->compress(relPath))
                     {
@@ -881,136 +1242,34 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
                 }
             }
 
+            if(ctx.cache && !doCompress)
+            {
+                ChecksumCache::const_iterator p = ctx.cache->find(relPath);
+                if(p != ctx.cache->end() && p->second.size == buf.st_size && p->second.mtime == buf.st_mtime)
+                {
+                    info.checksum = p->second.checksum;
+                    infoSeq.push_back(info);
+                    return true;
+                }
+            }
+
             if(cb && !cb->checksum(relPath))
             {
                 return false;
             }
 
-            ByteSeq bytesSHA;
-
-            if(relPath.size() + buf.st_size == 0)
+            ChecksumJobPtr job = new ChecksumJob(path, relPath, buf.st_size, buf.st_mtime, doCompress,
+                                                 infoSeq.size(), info);
+            infoSeq.push_back(info);
+            ctx.jobs.push_back(job);
+            if(ctx.queue)
             {
-                bytesSHA.resize(20);
-                fill(bytesSHA.begin(), bytesSHA.end(), 0);
+                ctx.queue->add(job);
             }
             else
             {
-                IceUtilInternal::SHA1 hasher;
-                if(relPath.size() != 0)
-                {
-                    hasher.update(reinterpret_cast<const IceUtil::Byte*>(relPath.c_str()), relPath.size());
-                }
-
-                if(buf.st_size != 0)
-                {
-                    int fd = IceUtilInternal::open(path.c_str(), O_BINARY|O_RDONLY);
-                    if(fd == -1)
-                    {
-                        throw "cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString();
-                    }
-
-                    const string pathBZ2Temp = path + ".bz2temp";
-                    FILE* stdioFile = 0;
-                    int bzError = 0;
-                    BZFILE* bzFile = 0;
-                    if(doCompress)
-                    {
-                        stdioFile = IceUtilInternal::fopen(simplify(pathBZ2Temp), "wb");
-                        if(!stdioFile)
-                        {
-                            IceUtilInternal::close(fd);
-                            throw "cannot open `" + pathBZ2Temp + "' for writing:\n" + IceUtilInternal::lastErrorToString();
-                        }
-
-                        bzFile = BZ2_bzWriteOpen(&bzError, stdioFile, 5, 0, 0);
-                        if(bzError != BZ_OK)
-                        {
-                            string ex = "BZ2_bzWriteOpen failed";
-                            if(bzError == BZ_IO_ERROR)
-                            {
-                            ex += string(": ") + IceUtilInternal::lastErrorToString();
-                            }
-                            fclose(stdioFile);
-                            IceUtilInternal::close(fd);
-                            throw ex;
-                        }
-                    }
-
-                    long bytesLeft = buf.st_size;
-                    while(bytesLeft > 0)
-                    {
-                        ByteSeq bytes(min(bytesLeft, 1024l*1024));
-                        if(
-#if defined(_MSC_VER)
-                            _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
-#else
-                            read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
-#endif
-                            == -1)
-                        {
-                            if(doCompress)
-                            {
-                                fclose(stdioFile);
-                            }
-                            
-                            IceUtilInternal::close(fd);
-                            throw "cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString();
-                        }
-                        bytesLeft -= static_cast<unsigned int>(bytes.size());
-                        if(doCompress)
-                        {
-                            BZ2_bzWrite(&bzError, bzFile, const_cast<Byte*>(&bytes[0]), static_cast<int>(bytes.size()));
-                            if(bzError != BZ_OK)
-                            {
-                                string ex = "BZ2_bzWrite failed";
-                                if(bzError == BZ_IO_ERROR)
-                                {
-                                    ex += string(": ") + IceUtilInternal::lastErrorToString();
-                                }
-                                BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
-                                fclose(stdioFile);
-                                IceUtilInternal::close(fd);
-                                throw ex;
-                            }
-                        }
-
-                        hasher.update(reinterpret_cast<IceUtil::Byte*>(&bytes[0]), bytes.size());
-                    }
-
-                    IceUtilInternal::close(fd);
-
-                    if(doCompress)
-                    {
-                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
-                        if(bzError != BZ_OK)
-                        {
-                            string ex = "BZ2_bzWriteClose failed";
-                            if(bzError == BZ_IO_ERROR)
-                            {
-                                ex += string(": ") + IceUtilInternal::lastErrorToString();
-                            }
-                            fclose(stdioFile);
-                            throw ex;
-                        }
-
-                        fclose(stdioFile);
-
-                        rename(pathBZ2Temp, pathBZ2);
-
-                        if(IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1)
-                        {
-                            throw "cannot stat `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString();
-                        }
-
-                        info.size = bufBZ2.st_size;
-                    }
-                }
-                hasher.finalize(bytesSHA);
+                job->run();
             }
-
-            info.checksum.swap(bytesSHA);
-
-            infoSeq.push_back(info);
         }
     }
 
@@ -1021,23 +1280,62 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
 
 bool
 IcePatch2Internal::getFileInfoSeq(const string& basePath, int compress, GetFileInfoSeqCB* cb, 
-                                  LargeFileInfoSeq& infoSeq)
+                                  LargeFileInfoSeq& infoSeq, int threads, ChecksumCache* cache)
 {
-    return getFileInfoSeqSubDir(basePath, ".", compress, cb, infoSeq);
+    return getFileInfoSeqSubDir(basePath, ".", compress, cb, infoSeq, threads, cache);
 }
 
 bool
 IcePatch2Internal::getFileInfoSeqSubDir(const string& basePa, const string& relPa, int compress, GetFileInfoSeqCB* cb,
-                                        LargeFileInfoSeq& infoSeq)
+                                        LargeFileInfoSeq& infoSeq, int threads, ChecksumCache* cache)
 {
     const string basePath = simplify(basePa);
     const string relPath = simplify(relPa);
 
-    if(!getFileInfoSeqInternal(basePath, relPath, compress, cb, infoSeq))
+    //
+    // Files modified in the second the scan started might change again
+    // without their modification time changing, so they are not cached.
+    //
+    const Long scanStart = static_cast<Long>(time(0));
+
+    IceUtil::UniquePtr<ChecksumWorkQueue> queue;
+    if(threads > 1)
+    {
+        queue.reset(new ChecksumWorkQueue(threads));
+    }
+
+    GetFileInfoSeqContext ctx(compress, cb, queue.get(), cache);
+    if(!getFileInfoSeqInternal(basePath, relPath, ctx, infoSeq))
     {
         return false;
     }
 
+    if(queue.get())
+    {
+        queue->finish();
+    }
+
+    for(vector<ChecksumJobPtr>::const_iterator p = ctx.jobs.begin(); p != ctx.jobs.end(); ++p)
+    {
+        const ChecksumJobPtr& job = *p;
+        infoSeq[job->index] = job->info;
+
+        if(cache)
+        {
+            if(job->mtime < scanStart)
+            {
+                ChecksumCacheEntry& entry = (*cache)[job->relPath];
+                entry.size = job->fileSize;
+                entry.mtime = job->mtime;
+                entry.checksum = job->info.checksum;
+            }
+            else
+            {
+                cache->erase(job->relPath);
+            }
+        }
+    }
+
     sort(infoSeq.begin(), infoSeq.end(), FileInfoLess());
     infoSeq.erase(unique(infoSeq.begin(), infoSeq.end(), FileInfoEqual()), infoSeq.end());
 
@@ -1184,6 +1482,90 @@ IcePatch2Internal::loadFileInfoSeq(const string& pa, LargeFileInfoSeq& infoSeq)
     }
 }
 
+void
+IcePatch2Internal::saveChecksumCache(const string& pa, const ChecksumCache& cache)
+{
+    const string path = simplify(pa + '/' + checksumCacheFile);
+    FILE* fp = IceUtilInternal::fopen(path, "w");
+    if(!fp)
+    {
+        throw "cannot open `" + path + "' for writing:\n" + IceUtilInternal::lastErrorToString();
+    }
+    try
+    {
+        for(ChecksumCache::const_iterator p = cache.begin(); p != cache.end(); ++p)
+        {
+            int rc = fprintf(fp, "%s\t%s\t%" ICE_INT64_FORMAT "d\t%" ICE_INT64_FORMAT "d\n",
+                             IceUtilInternal::escapeString(p->first, "").c_str(),
+                             bytesToString(p->second.checksum).c_str(),
+                             p->second.size,
+                             p->second.mtime);
+            if(rc <= 0)
+            {
+                throw "error writing `" + path + "':\n" + IceUtilInternal::lastErrorToString();
+            }
+        }
+    }
+    catch(...)
+    {
+        fclose(fp);
+        throw;
+    }
+    fclose(fp);
+}
+
+void
+IcePatch2Internal::loadChecksumCache(const string& pa, ChecksumCache& cache)
+{
+    //
+    // The cache is only an optimization, a missing or unreadable
+    // cache file simply means that every file is checksummed again.
+    //
+    const string path = simplify(pa + '/' + checksumCacheFile);
+    FILE* fp = IceUtilInternal::fopen(path, "r");
+    if(!fp)
+    {
+        return;
+    }
+
+    string data;
+    char buf[BUFSIZ];
+    while(fgets(buf, static_cast<int>(sizeof(buf)), fp) != 0)
+    {
+        data += buf;
+
+        size_t len = strlen(buf);
+        if(buf[len - 1] != '\n')
+        {
+            continue;
+        }
+
+        istringstream is(data);
+        data.clear();
+
+        string s;
+        getline(is, s, '\t');
+        string relPath;
+        try
+        {
+            relPath = IceUtilInternal::unescapeString(s, 0, s.size());
+        }
+        catch(const IceUtil::IllegalArgumentException&)
+        {
+            continue;
+        }
+
+        ChecksumCacheEntry entry;
+        getline(is, s, '\t');
+        entry.checksum = stringToBytes(s);
+        if(entry.checksum.size() == 20 && (is >> entry.size >> entry.mtime))
+        {
+            cache[relPath] = entry;
+        }
+    }
+    fclose(fp);
+}
+
 void
 IcePatch2Internal::getFileTree0(const LargeFileInfoSeq& infoSeq, FileTree0& tree0)
 {
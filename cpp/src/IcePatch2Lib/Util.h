@@ -19,6 +19,7 @@ namespace IcePatch2Internal
 
 ICE_PATCH2_API extern const char* checksumFile;
 ICE_PATCH2_API extern const char* logFile;
+ICE_PATCH2_API extern const char* checksumCacheFile;
 
 ICE_PATCH2_API std::string lastError();
 
@@ -163,9 +164,33 @@ public:
     virtual bool compress(const std::string&) = 0;
 };
 
-ICE_PATCH2_API bool getFileInfoSeq(const std::string&, int, GetFileInfoSeqCB*, IcePatch2::LargeFileInfoSeq&);
+//
+// Checksums of previously scanned files, keyed by relative path. An
+// entry is only reused while the file size and modification time
+// still match.
+//
+struct ChecksumCacheEntry
+{
+    Ice::Long size;
+    Ice::Long mtime;
+    Ice::ByteSeq checksum;
+};
+typedef std::map<std::string, ChecksumCacheEntry> ChecksumCache;
+
+//
+// If the thread count is greater than one, files are checksummed and
+// compressed by a pool of worker threads. The resulting sequence is
+// the same as with a single thread.
+//
+ICE_PATCH2_API bool getFileInfoSeq(const std::string&, int, GetFileInfoSeqCB*, IcePatch2::LargeFileInfoSeq&,
+                                   int = 1, ChecksumCache* = 0);
+
+ICE_PATCH2_API bool getFileInfoSeqSubDir(const std::string&, const std::string&, int, GetFileInfoSeqCB*,
+                                         IcePatch2::LargeFileInfoSeq&, int = 1, ChecksumCache* = 0);
+
+ICE_PATCH2_API void saveChecksumCache(const std::string&, const ChecksumCache&);
 
-ICE_PATCH2_API bool getFileInfoSeqSubDir(const std::string&, const std::string&, int, GetFileInfoSeqCB*, IcePatch2::LargeFileInfoSeq&);
+ICE_PATCH2_API void loadChecksumCache(const std::string&, ChecksumCache&);
 
 ICE_PATCH2_API void saveFileInfoSeq(const std::string&, const IcePatch2::LargeFileInfoSeq&);
 
@@ -318,6 +318,39 @@ SubscriberObserverI::delivered(int count)
     forEach(DeliveredUpdate(count));
 }
 
+namespace
+{
+
+struct DroppedUpdate
+{
+    DroppedUpdate(int count) : count(count)
+    {
+    }
+
+    void operator()(const SubscriberMetricsPtr& v)
+    {
+        if(v->queued > 0)
+        {
+            v->queued -= count;
+        }
+        if(!v->dropped)
+        {
+            v->dropped = 0;
+        }
+        *v->dropped += count;
+    }
+
+    int count;
+};
+
+}
+
+void
+SubscriberObserverI::dropped(int count)
+{
+    forEach(DroppedUpdate(count));
+}
+
 TopicManagerObserverI::TopicManagerObserverI(const IceInternal::MetricsAdminIPtr& metrics) : 
     _metrics(metrics),
     _topics(metrics, "Topic"),
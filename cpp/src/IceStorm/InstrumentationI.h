@@ -35,6 +35,7 @@ public:
     virtual void queued(int);
     virtual void outstanding(int);
     virtual void delivered(int);
+    virtual void dropped(int);
 };
 
 class TopicManagerObserverI : public IceStorm::Instrumentation::TopicManagerObserver
@@ -169,6 +169,8 @@ NodeI::NodeI(const InstancePtr& instance,
     _nodes(nodes),
     _state(NodeStateInactive),
     _updateCounter(0),
+    _cachedReaders(0),
+    _cachedReadable(0),
     _max(0),
     _generation(-1),
     _destroy(false)
@@ -430,7 +432,7 @@ NodeI::merge(const set<int>& coordinatorSet)
         setState(NodeStateElection);
 
         // No more replica changes are permitted.
-        while(!_destroy && _updateCounter > 0)
+        while(!_destroy && (_updateCounter > 0 || _cachedReaders > 0))
         {
             wait();
         }
@@ -773,7 +775,7 @@ NodeI::invitation(int j, const string& gn, const Ice::Current&)
         // We're now joining with another group. If we are active we
         // must stop serving as a master or slave.
         setState(NodeStateElection);
-        while(!_destroy && _updateCounter > 0)
+        while(!_destroy && (_updateCounter > 0 || _cachedReaders > 0))
         {
             wait();
         }
@@ -1019,7 +1021,7 @@ NodeI::recovery(Ice::Long generation)
     }
 
     setState(NodeStateInactive);
-    while(!_destroy && _updateCounter > 0)
+    while(!_destroy && (_updateCounter > 0 || _cachedReaders > 0))
     {
         wait();
     }
@@ -1066,7 +1068,8 @@ NodeI::destroy()
     Lock sync(*this);
     assert(!_destroy);
 
-    while(_updateCounter > 0)
+    _cachedReadable.exchange(0);
+    while(_updateCounter > 0 || _cachedReaders > 0)
     {
         wait();
     }
@@ -1173,6 +1176,22 @@ NodeI::updateMaster(const char* /*file*/, int /*line*/)
 Ice::ObjectPrx
 NodeI::startCachedRead(Ice::Long& generation, const char* file, int line)
 {
+    //
+    // Cached reads don't lock the node while it is replicating
+    // normally. The reader registers itself and then checks
+    // _cachedReadable. Any state change clears _cachedReadable before
+    // waiting for the registered readers to finish, so if the flag is
+    // still set the generation and coordinator cannot change until
+    // finishCachedRead() is called.
+    //
+    ++_cachedReaders;
+    if(_cachedReadable > 0)
+    {
+        generation = _generation;
+        return _coordinatorProxy;
+    }
+    finishCachedRead();
+
     Lock sync(*this);
     while(!_destroy && _state != NodeStateNormal)
     {
@@ -1183,10 +1202,25 @@ NodeI::startCachedRead(Ice::Long& generation, const char* file, int line)
         throw Ice::UnknownException(file, line);
     }
     generation = _generation;
-    ++_updateCounter;
+    ++_cachedReaders;
+    _cachedReadable.exchange(1);
     return _coordinatorProxy;
 }
 
+void
+NodeI::finishCachedRead()
+{
+    //
+    // If the node is waiting for the readers to finish, the last one
+    // out must wake it up.
+    //
+    if(--_cachedReaders == 0 && _cachedReadable == 0)
+    {
+        Lock sync(*this);
+        notifyAll();
+    }
+}
+
 void
 NodeI::startObserverUpdate(Ice::Long generation, const char* file, int line)
 {
@@ -1246,6 +1280,12 @@ stateToString(NodeState s)
 void
 NodeI::setState(NodeState s)
 {
+    //
+    // Force cached reads back through the lock until a reader sees
+    // the node in the normal state again.
+    //
+    _cachedReadable.exchange(0);
+
     if(s != _state)
     {
         if(_traceLevels->election > 0)
@@ -16,6 +16,7 @@
 #include <IceStorm/Replica.h>
 #include <IceStorm/Instance.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/Atomic.h>
 #include <set>
 
 namespace IceStormElection
@@ -55,6 +56,7 @@ public:
     void checkObserverInit(Ice::Long);
     Ice::ObjectPrx startUpdate(Ice::Long&, const char*, int);
     Ice::ObjectPrx startCachedRead(Ice::Long&, const char*, int);
+    void finishCachedRead();
     void startObserverUpdate(Ice::Long, const char*, int);
     bool updateMaster(const char*, int);
 
@@ -81,6 +83,8 @@ private:
 
     NodeState _state;
     int _updateCounter;
+    IceUtilInternal::Atomic _cachedReaders; // The number of cached reads in progress.
+    IceUtilInternal::Atomic _cachedReadable; // Whether cached reads can skip the lock.
 
     int _coord; // Id of the coordinator.
     std::string _group; // My group id.
@@ -142,7 +146,7 @@ public:
     {
         if(_node)
         {
-            _node->finishUpdate();
+            _node->finishCachedRead();
         }
     }
 
@@ -17,6 +17,7 @@
 #include <IceStorm/TopicManagerI.h>
 #include <IceStorm/TransientTopicManagerI.h>
 #include <IceStorm/Instance.h>
+#include <IceStorm/Subscriber.h>
 
 #include <IceStorm/Service.h>
 
@@ -134,6 +135,7 @@ ServiceI::start(
     PropertiesPtr properties = communicator->getProperties();
 
     validateProperties(name, properties, communicator->getLogger());
+    Subscriber::validateProperties(name, properties, communicator->getLogger());
 
     int id = properties->getPropertyAsIntWithDefault(name + ".NodeId", -1);
 
@@ -534,6 +536,14 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Trace.Topic",
         "Trace.TopicManager",
         "Send.Timeout",
+        "Subscriber.MaxQueuedEvents",
+        "Subscriber.MaxQueuedBytes",
+        "Subscriber.OverflowPolicy",
+        "Subscriber.CoalesceKey",
+        "Topic.*.MaxQueuedEvents",
+        "Topic.*.MaxQueuedBytes",
+        "Topic.*.OverflowPolicy",
+        "Topic.*.CoalesceKey",
         "Discard.Interval",
         "SQL.DatabaseType",
         "SQL.EncodingVersion",
@@ -13,7 +13,9 @@
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/StringUtil.h>
 #include <iterator>
+#include <algorithm>
 
 using namespace std;
 using namespace IceStorm;
@@ -78,6 +80,91 @@ private:
 };
 typedef IceUtil::Handle<PerSubscriberPublisherI> PerSubscriberPublisherIPtr;
 
+//
+// Returns the value of the given subscriber QoS, which overrides the
+// <service>.Topic.<topic>.<name> and <service>.Subscriber.<name>
+// properties. The QoS name is the property name starting with a lower
+// case letter.
+//
+string
+getQueueSetting(const Ice::PropertiesPtr& properties, const QoS& qos, const string& topicPrefix,
+                const string& defaultPrefix, const string& name, bool& fromQoS)
+{
+    string qosName = name;
+    qosName[0] = static_cast<char>(tolower(static_cast<unsigned char>(qosName[0])));
+    QoS::const_iterator p = qos.find(qosName);
+    fromQoS = p != qos.end();
+    if(fromQoS)
+    {
+        return p->second;
+    }
+    return properties->getPropertyWithDefault(topicPrefix + name, properties->getProperty(defaultPrefix + name));
+}
+
+template<typename T> bool
+parseQueueLimit(const string& s, T& limit)
+{
+    istringstream is(s);
+    T v;
+    if(!(is >> v) || v < 0)
+    {
+        return false;
+    }
+    limit = v;
+    return true;
+}
+
+bool
+parseOverflowPolicy(const string& s, Subscriber::OverflowPolicy& policy)
+{
+    if(s == "dropOldest")
+    {
+        policy = Subscriber::OverflowDropOldest;
+    }
+    else if(s == "dropNewest")
+    {
+        policy = Subscriber::OverflowDropNewest;
+    }
+    else if(s == "coalesce")
+    {
+        policy = Subscriber::OverflowCoalesce;
+    }
+    else if(s == "unsubscribe")
+    {
+        policy = Subscriber::OverflowUnsubscribe;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+//
+// Returns false if the value of the given event queue property isn't
+// valid.
+//
+bool
+validQueueSetting(const string& name, const string& value)
+{
+    if(name == "MaxQueuedEvents")
+    {
+        int limit;
+        return parseQueueLimit(value, limit);
+    }
+    else if(name == "MaxQueuedBytes")
+    {
+        Ice::Long limit;
+        return parseQueueLimit(value, limit);
+    }
+    else if(name == "OverflowPolicy")
+    {
+        Subscriber::OverflowPolicy policy;
+        return parseOverflowPolicy(value, policy);
+    }
+    return true;
+}
+
 IceStorm::Instrumentation::SubscriberState
 toSubscriberState(Subscriber::SubscriberState s)
 {
@@ -238,6 +325,7 @@ SubscriberBatch::doFlush()
 
     EventDataSeq v;
     v.swap(_events);
+    _queuedBytes = 0;
     assert(!v.empty());
     
     if(_observer)
@@ -352,6 +440,7 @@ SubscriberOneway::flush()
         //
         EventDataPtr e = _events.front();
         _events.erase(_events.begin());
+        _queuedBytes -= static_cast<Ice::Long>(e->data.size());
         if(_observer)
         {
             _observer->outstanding(1);
@@ -447,6 +536,7 @@ SubscriberTwoway::flush()
         //
         EventDataPtr e = _events.front();
         _events.erase(_events.begin());
+        _queuedBytes -= static_cast<Ice::Long>(e->data.size());
         ++_outstanding;
         if(_observer)
         {
@@ -489,6 +579,7 @@ SubscriberLink::flush()
 
     EventDataSeq v;
     v.swap(_events);
+    _queuedBytes = 0;
 
     EventDataSeq::iterator p = v.begin();
     while(p != v.end())
@@ -629,6 +720,45 @@ Subscriber::create(
     }
 }
 
+void
+Subscriber::validateProperties(const string& name, const Ice::PropertiesPtr& properties,
+                               const Ice::LoggerPtr& logger)
+{
+    static const string settings[] = { "MaxQueuedEvents", "MaxQueuedBytes", "OverflowPolicy" };
+
+    vector<string> invalidProps;
+    for(unsigned int i = 0; i < sizeof(settings)/sizeof(*settings); ++i)
+    {
+        const string key = name + ".Subscriber." + settings[i];
+        const string value = properties->getProperty(key);
+        if(!value.empty() && !validQueueSetting(settings[i], value))
+        {
+            invalidProps.push_back(key + "=" + value);
+        }
+    }
+
+    const string topicPrefix = name + ".Topic.";
+    Ice::PropertyDict props = properties->getPropertiesForPrefix(topicPrefix);
+    for(Ice::PropertyDict::const_iterator p = props.begin(); p != props.end(); ++p)
+    {
+        string::size_type pos = p->first.rfind('.');
+        if(pos != string::npos && pos > topicPrefix.size() && !validQueueSetting(p->first.substr(pos + 1), p->second))
+        {
+            invalidProps.push_back(p->first + "=" + p->second);
+        }
+    }
+
+    if(!invalidProps.empty())
+    {
+        Ice::Warning out(logger);
+        out << "invalid subscriber queue properties for IceStorm service '" << name << "', using the defaults:";
+        for(vector<string>::const_iterator p = invalidProps.begin(); p != invalidProps.end(); ++p)
+        {
+            out << "\n    " << *p;
+        }
+    }
+}
+
 Subscriber::~Subscriber()
 {
     //cout << "~Subscriber" << endl;
@@ -653,10 +783,8 @@ Subscriber::record() const
 }
 
 bool
-Subscriber::queue(bool forwarded, const EventDataSeq& events)
+Subscriber::queue(bool forwarded, const EventDataSeq& allEvents)
 {
-    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
-
     // If this is a link subscriber if the set of events were
     // forwarded from another IceStorm instance then do not queue the
     // events.
@@ -665,6 +793,29 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
         return true;
     }
 
+    //
+    // The filter is immutable, so the events are filtered before
+    // locking the subscriber.
+    //
+    EventDataSeq filtered;
+    if(_filter)
+    {
+        for(EventDataSeq::const_iterator p = allEvents.begin(); p != allEvents.end(); ++p)
+        {
+            if(_filter->matches(*p))
+            {
+                filtered.push_back(*p);
+            }
+        }
+        if(filtered.empty())
+        {
+            return !errored();
+        }
+    }
+    const EventDataSeq& events = _filter ? filtered : allEvents;
+
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
     switch(_state)
     {
     case SubscriberStateOffline:
@@ -682,11 +833,14 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
     }
     
     case SubscriberStateOnline:
-        copy(events.begin(), events.end(), back_inserter(_events));
         if(_observer)
         {
             _observer->queued(static_cast<Ice::Int>(events.size()));
         }
+        if(!enqueue(events))
+        {
+            return false;
+        }
         flush();
         break;
 
@@ -700,6 +854,109 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
     return true;
 }
 
+bool
+Subscriber::enqueue(const EventDataSeq& events)
+{
+    int dropped = 0;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        const Ice::Long size = static_cast<Ice::Long>((*p)->data.size());
+        if(queueFull(size))
+        {
+            if(_overflowPolicy == OverflowUnsubscribe)
+            {
+                if(_observer)
+                {
+                    _observer->dropped(static_cast<Ice::Int>(_events.size() + (events.end() - p)));
+                }
+                _events.clear();
+                _queuedBytes = 0;
+                setState(SubscriberStateError);
+
+                TraceLevelsPtr traceLevels = _instance->traceLevels();
+                if(traceLevels->subscriber > 0)
+                {
+                    Ice::Trace out(traceLevels->logger, traceLevels->subscriberCat);
+                    out << _instance->communicator()->identityToString(_rec.id);
+                    if(traceLevels->subscriber > 1)
+                    {
+                        out << " endpoints: " << IceStormInternal::describeEndpoints(_rec.obj);
+                    }
+                    out << " subscriber errored out: event queue limit reached";
+                }
+                return false;
+            }
+            else if(_overflowPolicy == OverflowDropNewest)
+            {
+                ++dropped;
+                continue;
+            }
+            else if(_overflowPolicy == OverflowCoalesce)
+            {
+                //
+                // The new event supersedes the most recent queued
+                // event with the same key.
+                //
+                for(EventDataSeq::iterator q = _events.end(); q != _events.begin();)
+                {
+                    --q;
+                    if(coalesces(*q, *p))
+                    {
+                        _queuedBytes -= static_cast<Ice::Long>((*q)->data.size());
+                        _events.erase(q);
+                        ++dropped;
+                        break;
+                    }
+                }
+            }
+
+            while(!_events.empty() && queueFull(size))
+            {
+                _queuedBytes -= static_cast<Ice::Long>(_events.front()->data.size());
+                _events.erase(_events.begin());
+                ++dropped;
+            }
+        }
+
+        _events.push_back(*p);
+        _queuedBytes += size;
+    }
+
+    if(dropped > 0 && _observer)
+    {
+        _observer->dropped(dropped);
+    }
+    return true;
+}
+
+bool
+Subscriber::queueFull(Ice::Long size) const
+{
+    return (_maxQueuedEvents > 0 && static_cast<int>(_events.size()) >= _maxQueuedEvents) ||
+           (_maxQueuedBytes > 0 && _queuedBytes + size > _maxQueuedBytes);
+}
+
+bool
+Subscriber::coalesces(const EventDataPtr& queued, const EventDataPtr& event) const
+{
+    if(queued->op != event->op)
+    {
+        return false;
+    }
+    if(_coalesceKey.empty())
+    {
+        return true;
+    }
+
+    Ice::Context::const_iterator p = event->context.find(_coalesceKey);
+    if(p == event->context.end())
+    {
+        return false;
+    }
+    Ice::Context::const_iterator q = queued->context.find(_coalesceKey);
+    return q != queued->context.end() && q->second == p->second;
+}
+
 bool
 Subscriber::reap()
 {
@@ -827,12 +1084,14 @@ Subscriber::error(bool dec, const Ice::Exception& e)
         _next = now + _instance->discardInterval();
         ++_currentRetry;
         _events.clear();
+        _queuedBytes = 0;
         setState(SubscriberStateOffline);
     }
     // Errored out.
     else if(_state < SubscriberStateError)
     {
         _events.clear();
+        _queuedBytes = 0;
         setState(SubscriberStateError);
         
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -936,10 +1195,15 @@ Subscriber::Subscriber(
     _maxOutstanding(maxOutstanding),
     _proxy(proxy),
     _proxyReplica(proxy),
+    _filter(EventFilter::create(rec.theQoS)),
+    _maxQueuedEvents(0),
+    _maxQueuedBytes(0),
+    _overflowPolicy(OverflowDropOldest),
     _shutdown(false),
     _state(SubscriberStateOnline),
     _outstanding(0),
     _outstandingCount(1),
+    _queuedBytes(0),
     _currentRetry(0)
 {
     if(_proxy && _instance->publisherReplicaProxy())
@@ -948,6 +1212,39 @@ Subscriber::Subscriber(
             _instance->publisherReplicaProxy()->ice_identity(_proxy->ice_getIdentity());
     }
 
+    //
+    // The event queue limits are given by the subscriber QoS, or else
+    // by the topic or the service configuration.
+    //
+    Ice::PropertiesPtr properties = _instance->communicator()->getProperties();
+    const string topicPrefix = _instance->serviceName() + ".Topic." + rec.topicName + ".";
+    const string defaultPrefix = _instance->serviceName() + ".Subscriber.";
+
+    //
+    // An invalid QoS is rejected. An invalid property is ignored, it
+    // is reported when the service starts.
+    //
+    bool fromQoS;
+    string s = getQueueSetting(properties, rec.theQoS, topicPrefix, defaultPrefix, "MaxQueuedEvents", fromQoS);
+    if(!s.empty() && !parseQueueLimit(s, _maxQueuedEvents) && fromQoS)
+    {
+        throw BadQoS("invalid maxQueuedEvents: " + s);
+    }
+
+    s = getQueueSetting(properties, rec.theQoS, topicPrefix, defaultPrefix, "MaxQueuedBytes", fromQoS);
+    if(!s.empty() && !parseQueueLimit(s, _maxQueuedBytes) && fromQoS)
+    {
+        throw BadQoS("invalid maxQueuedBytes: " + s);
+    }
+
+    s = getQueueSetting(properties, rec.theQoS, topicPrefix, defaultPrefix, "OverflowPolicy", fromQoS);
+    if(!s.empty() && !parseOverflowPolicy(s, _overflowPolicy) && fromQoS)
+    {
+        throw BadQoS("invalid overflowPolicy: " + s);
+    }
+
+    _coalesceKey = getQueueSetting(properties, rec.theQoS, topicPrefix, defaultPrefix, "CoalesceKey", fromQoS);
+
     if(_instance->observer())
     {
         _observer.attach(_instance->observer()->getSubscriberObserver(_instance->serviceName(),
@@ -1010,6 +1307,83 @@ Subscriber::setState(Subscriber::SubscriberState state)
     }
 }
 
+EventFilterPtr
+EventFilter::create(const QoS& qos)
+{
+    const string operationsKey = "filter.operations";
+    const string contextPrefix = "filter.context.";
+
+    EventFilterPtr filter;
+    for(QoS::const_iterator p = qos.begin(); p != qos.end(); ++p)
+    {
+        bool operations = p->first == operationsKey;
+        if(!operations && p->first.compare(0, contextPrefix.size(), contextPrefix) != 0)
+        {
+            continue;
+        }
+
+        vector<string> values;
+        if(!IceUtilInternal::splitString(p->second, ",", values) || values.empty())
+        {
+            throw BadQoS("invalid " + p->first + ": " + p->second);
+        }
+        sort(values.begin(), values.end());
+        values.erase(unique(values.begin(), values.end()), values.end());
+
+        if(!filter)
+        {
+            filter = new EventFilter();
+        }
+
+        if(operations)
+        {
+            filter->_allOperations = false;
+            filter->_operations.swap(values);
+        }
+        else
+        {
+            if(p->first.size() == contextPrefix.size())
+            {
+                throw BadQoS("missing context key in " + p->first);
+            }
+            if(find(values.begin(), values.end(), "*") != values.end())
+            {
+                values.clear();
+            }
+            filter->_context.push_back(make_pair(p->first.substr(contextPrefix.size()), values));
+        }
+    }
+    return filter;
+}
+
+bool
+EventFilter::matches(const EventDataPtr& event) const
+{
+    if(!_allOperations && !binary_search(_operations.begin(), _operations.end(), event->op))
+    {
+        return false;
+    }
+
+    for(vector<pair<string, vector<string> > >::const_iterator p = _context.begin(); p != _context.end(); ++p)
+    {
+        Ice::Context::const_iterator q = event->context.find(p->first);
+        if(q == event->context.end())
+        {
+            return false;
+        }
+        if(!p->second.empty() && !binary_search(p->second.begin(), p->second.end(), q->second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+EventFilter::EventFilter() :
+    _allOperations(true)
+{
+}
+
 bool
 IceStorm::operator==(const SubscriberPtr& subscriber, const Ice::Identity& id)
 {
@@ -14,6 +14,8 @@
 #include <IceStorm/SubscriberRecord.h>
 #include <IceStorm/Instrumentation.h>
 #include <Ice/ObserverHelper.h>
+#include <Ice/PropertiesF.h>
+#include <Ice/LoggerF.h>
 #include <IceUtil/RecMutex.h>
 
 namespace IceStorm
@@ -25,12 +27,45 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class EventFilter;
+typedef IceUtil::Handle<EventFilter> EventFilterPtr;
+
+//
+// A subscription filter compiled from the subscriber QoS. The
+// filter.operations QoS lists the accepted operations and each
+// filter.context.<key> QoS lists the accepted values of a context
+// entry, or * to only require the entry. Lists are comma separated.
+//
+class EventFilter : public IceUtil::Shared
+{
+public:
+
+    // Returns null if the QoS doesn't specify a filter.
+    static EventFilterPtr create(const IceStorm::QoS&);
+
+    bool matches(const EventDataPtr&) const;
+
+private:
+
+    EventFilter();
+
+    bool _allOperations;
+    std::vector<std::string> _operations; // Sorted.
+
+    // The required context entries, with their sorted accepted
+    // values. No values means any value is accepted.
+    std::vector<std::pair<std::string, std::vector<std::string> > > _context;
+};
+
 class Subscriber : public IceUtil::Shared
 {
 public:
 
     static SubscriberPtr create(const InstancePtr&, const IceStorm::SubscriberRecord&);
 
+    // Warns about invalid event queue properties of the given service.
+    static void validateProperties(const std::string&, const Ice::PropertiesPtr&, const Ice::LoggerPtr&);
+
     ~Subscriber();
 
     Ice::ObjectPrx proxy() const; // Get the per subscriber object.
@@ -61,11 +96,23 @@ public:
         SubscriberStateReaped // Reaped.
     };
 
+    // What to do with new events once the event queue is full.
+    enum OverflowPolicy
+    {
+        OverflowDropOldest, // Discard the oldest queued events.
+        OverflowDropNewest, // Discard the new events.
+        OverflowCoalesce, // Replace the queued event with the same key, or else discard the oldest.
+        OverflowUnsubscribe // Put the subscriber in the error state so that it gets reaped.
+    };
+
     virtual void flush() = 0;
 
 protected:
 
     void setState(SubscriberState);
+    bool enqueue(const EventDataSeq&);
+    bool queueFull(Ice::Long) const;
+    bool coalesces(const EventDataPtr&, const EventDataPtr&) const;
 
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
@@ -76,6 +123,13 @@ protected:
     const int _maxOutstanding; // The maximum number of oustanding events.
     const Ice::ObjectPrx _proxy; // The per subscriber object proxy, if any.
     const Ice::ObjectPrx _proxyReplica; // The replicated per subscriber object proxy, if any.
+    const EventFilterPtr _filter; // The subscription filter, if any.
+
+    // The event queue limits (0 if unbounded) and overflow policy.
+    int _maxQueuedEvents;
+    Ice::Long _maxQueuedBytes;
+    OverflowPolicy _overflowPolicy;
+    std::string _coalesceKey; // The context entry identifying events to coalesce.
 
     IceUtil::Monitor<IceUtil::RecMutex> _lock;
 
@@ -86,6 +140,7 @@ protected:
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
     EventDataSeq _events; // The queue of events to send.
+    Ice::Long _queuedBytes; // The size of the queued event data.
 
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
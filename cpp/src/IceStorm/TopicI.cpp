@@ -600,6 +600,7 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     }
 
     _subscribers.push_back(subscriber);
+    _publishSubscribers = 0;
 
     _instance->observers()->addSubscriber(llu, _name, record);
 
@@ -722,6 +723,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
     }
 
     _subscribers.push_back(subscriber);
+    _publishSubscribers = 0;
 
     _instance->observers()->addSubscriber(llu, _name, record);
 }
@@ -910,6 +912,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
             {
                 (*p)->destroy();
                 p = _subscribers.erase(p);
+                _publishSubscribers = 0;
             }
             else
             {
@@ -934,6 +937,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
         {
             SubscriberPtr subscriber = Subscriber::create(_instance, *p);
             _subscribers.push_back(subscriber);
+            _publishSubscribers = 0;
         }
     }
 }
@@ -1010,10 +1014,11 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
         //
-        // Copy of the subscriber list so that event publishing can occur
-        // in parallel.
+        // Snapshot of the subscriber list so that event publishing can
+        // occur in parallel. The snapshot is shared by all publishers
+        // until the subscriber list changes.
         //
-        vector<SubscriberPtr> copy;
+        SubscriberListPtr subscribers;
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -1027,13 +1032,18 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                     _observer->published();
                 }
             }
-            copy = _subscribers;
+            if(!_publishSubscribers)
+            {
+                _publishSubscribers = new SubscriberList(_subscribers);
+            }
+            subscribers = _publishSubscribers;
         }
 
         //
         // Queue each event, gathering a list of those subscribers that
         // must be reaped.
         //
+        const vector<SubscriberPtr>& copy = subscribers->subscribers;
         for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
         {
             if(!(*p)->queue(forwarded, events) && (*p)->reap())
@@ -1143,6 +1153,7 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
     }
 
     _subscribers.push_back(subscriber);
+    _publishSubscribers = 0;
 }
 
 void
@@ -1176,6 +1187,7 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
         {
             (*p)->destroy();
             _subscribers.erase(p);
+            _publishSubscribers = 0;
         }
     }
 
@@ -1269,6 +1281,7 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _publishSubscribers = 0;
 
     // Clear out the database records related to this topic.
     LogUpdate llu;
@@ -1339,6 +1352,7 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
         {
             (*p)->destroy();
             _subscribers.erase(p);
+            _publishSubscribers = 0;
             removed.push_back(*id);
         }
     }
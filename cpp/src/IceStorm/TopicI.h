@@ -27,6 +27,22 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+//
+// An immutable copy of a topic's subscribers.
+//
+class SubscriberList : public IceUtil::Shared
+{
+public:
+
+    SubscriberList(const std::vector<SubscriberPtr>& s) :
+        subscribers(s)
+    {
+    }
+
+    const std::vector<SubscriberPtr> subscribers;
+};
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
 class TopicImpl : public IceUtil::Shared
 {
 public:
@@ -102,6 +118,12 @@ private:
     //
     std::vector<SubscriberPtr> _subscribers;
 
+    //
+    // The subscribers used by publish(), rebuilt on the next publish
+    // once _subscribers is modified.
+    //
+    SubscriberListPtr _publishSubscribers;
+
     bool _destroyed; // Has this Topic been destroyed?
 };
 
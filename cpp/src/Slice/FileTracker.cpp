@@ -72,7 +72,11 @@ Slice::FileTracker::~FileTracker()
 {
 }
 
-// The file tracker is not supposed to be thread safe.
+//
+// The instance is not created in a thread safe manner, it must be
+// retrieved before threads are started. Generated files can however
+// be added concurrently.
+//
 Slice::FileTrackerPtr
 Slice::FileTracker::instance()
 {
@@ -106,6 +110,7 @@ Slice::FileTracker::setOutput(const string& output, bool error)
 void
 Slice::FileTracker::addFile(const string& file)
 {
+    IceUtil::Mutex::Lock sync(*this);
     _files.push_front(make_pair(file, false));
     if(_curr != _generated.end())
     {
@@ -116,12 +121,14 @@ Slice::FileTracker::addFile(const string& file)
 void
 Slice::FileTracker::addDirectory(const string& dir)
 {
+    IceUtil::Mutex::Lock sync(*this);
     _files.push_front(make_pair(dir, true));
 }
 
 void
 Slice::FileTracker::cleanup()
 {
+    IceUtil::Mutex::Lock sync(*this);
     for(list<pair<string, bool> >::const_iterator p = _files.begin(); p != _files.end(); ++p)
     {
         if(!p->second)
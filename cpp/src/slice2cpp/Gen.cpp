@@ -20,6 +20,7 @@
 
 #include <sys/stat.h>
 #include <string.h>
+#include <fstream>
 
 using namespace std;
 using namespace Slice;
@@ -191,12 +192,56 @@ writeDataMemberInitializers(IceUtilInternal::Output& C, const DataMemberList& me
     }
 }
 
+//
+// Write the generated contents to the given file. If update is true
+// and the file already contains the same contents, the file is not
+// rewritten to preserve its modification time.
+//
+void
+writeFile(const string& file, const string& contents, bool update)
+{
+    if(update)
+    {
+        ifstream in(file.c_str());
+        if(in)
+        {
+            ostringstream os;
+            os << in.rdbuf();
+            if(os.str() == contents)
+            {
+                return;
+            }
+        }
+    }
+
+    Output out;
+    out.open(file);
+    if(!out)
+    {
+        ostringstream os;
+        os << "cannot open `" << file << "': " << strerror(errno);
+        throw FileException(__FILE__, __LINE__, os.str());
+    }
+    FileTracker::instance()->addFile(file);
+
+    out.print(contents);
+    out.close();
+    if(!out)
+    {
+        ostringstream os;
+        os << "cannot write `" << file << "'";
+        throw FileException(__FILE__, __LINE__, os.str());
+    }
+}
+
 }
 
 Slice::Gen::Gen(const string& base, const string& headerExtension, const string& sourceExtension,
                 const vector<string>& extraHeaders, const string& include,
                 const vector<string>& includePaths, const string& dllExport, const string& dir,
-                bool imp, bool checksum, bool stream, bool ice) :
+                bool imp, bool checksum, bool stream, bool ice, bool update) :
+    H(_headerContents),
+    C(_sourceContents),
     _base(base),
     _headerExtension(headerExtension),
     _implHeaderExtension(headerExtension),
@@ -209,7 +254,8 @@ Slice::Gen::Gen(const string& base, const string& headerExtension, const string&
     _impl(imp),
     _checksum(checksum),
     _stream(stream),
-    _ice(ice)
+    _ice(ice),
+    _update(update)
 {
     for(vector<string>::iterator p = _includePaths.begin(); p != _includePaths.end(); ++p)
     {
@@ -223,19 +269,6 @@ Slice::Gen::Gen(const string& base, const string& headerExtension, const string&
     }
 }
 
-Slice::Gen::~Gen()
-{
-    H << "\n\n#include <IceUtil/PopDisableWarnings.h>";
-    H << "\n#endif\n";
-    C << '\n';
-
-    if(_impl)
-    {
-        implH << "\n\n#endif\n";
-        implC << '\n';
-    }
-}
-
 void
 Slice::Gen::generate(const UnitPtr& p)
 {
@@ -311,24 +344,10 @@ Slice::Gen::generate(const UnitPtr& p)
         fileC = _dir + '/' + fileC;
     }
 
-    H.open(fileH.c_str());
-    if(!H)
-    {
-        ostringstream os;
-        os << "cannot open `" << fileH << "': " << strerror(errno);
-        throw FileException(__FILE__, __LINE__, os.str());
-    }
-    FileTracker::instance()->addFile(fileH);
-
-    C.open(fileC.c_str());
-    if(!C)
-    {
-        ostringstream os;
-        os << "cannot open `" << fileC << "': " << strerror(errno);
-        throw FileException(__FILE__, __LINE__, os.str());
-    }
-    FileTracker::instance()->addFile(fileC);
-
+    //
+    // The header and source files are generated in memory and written
+    // once the generation completes, see writeFile().
+    //
     printHeader(H);
     printGeneratedHeader(H, _base + ".ice");
     printHeader(C);
@@ -572,6 +591,19 @@ Slice::Gen::generate(const UnitPtr& p)
             C << sp << nl << "}";
         }
     }
+
+    H << "\n\n#include <IceUtil/PopDisableWarnings.h>";
+    H << "\n#endif\n";
+    C << '\n';
+
+    if(_impl)
+    {
+        implH << "\n\n#endif\n";
+        implC << '\n';
+    }
+
+    writeFile(fileH, _headerContents.str(), _update);
+    writeFile(fileC, _sourceContents.str(), _update);
 }
 
 void
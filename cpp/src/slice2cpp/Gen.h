@@ -31,8 +31,8 @@ public:
         bool,
         bool,
         bool,
+        bool,
         bool);
-    ~Gen();
 
     void generate(const UnitPtr&);
     void closeOutput();
@@ -51,6 +51,9 @@ private:
     //
     std::string getHeaderExt(const std::string& file, const UnitPtr& unit);
 
+    std::ostringstream _headerContents;
+    std::ostringstream _sourceContents;
+
     ::IceUtilInternal::Output H;
     ::IceUtilInternal::Output C;
 
@@ -70,6 +73,7 @@ private:
     bool _checksum;
     bool _stream;
     bool _ice;
+    bool _update;
 
     class TypesVisitor : private ::IceUtil::noncopyable, public ParserVisitor
     {
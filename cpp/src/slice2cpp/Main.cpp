@@ -11,11 +11,15 @@
 #include <IceUtil/CtrlCHandler.h>
 #include <IceUtil/Mutex.h>
 #include <IceUtil/MutexPtrLock.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Thread.h>
 #include <Slice/Preprocessor.h>
 #include <Slice/FileTracker.h>
 #include <Slice/Util.h>
 #include "Gen.h"
 
+#include <deque>
+
 using namespace std;
 using namespace Slice;
 
@@ -43,6 +47,188 @@ public:
 
 Init init;
 
+//
+// The Slice preprocessor and parser are not reentrant so the Slice
+// files are always parsed sequentially. With --jobs, the code for the
+// parsed units is generated by a pool of threads.
+//
+class GeneratePool : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    GeneratePool(int);
+    ~GeneratePool();
+
+    bool empty() const
+    {
+        return _threads.empty();
+    }
+
+    bool push(Gen*, const UnitPtr&);
+    string join();
+
+private:
+
+    struct Job
+    {
+        Gen* gen;
+        UnitPtr unit;
+    };
+
+    bool pop(Job&);
+    void failed(const string&);
+
+    class GenerateThread : public IceUtil::Thread
+    {
+    public:
+
+        GenerateThread(GeneratePool& pool) :
+            IceUtil::Thread("slice2cpp generate thread"),
+            _pool(pool)
+        {
+        }
+
+        virtual void run()
+        {
+            Job job;
+            while(_pool.pop(job))
+            {
+                try
+                {
+                    job.gen->generate(job.unit);
+                }
+                catch(const Slice::FileException& ex)
+                {
+                    _pool.failed(ex.reason());
+                }
+                catch(const std::exception& ex)
+                {
+                    _pool.failed(ex.what());
+                }
+                delete job.gen;
+                job.unit->destroy();
+            }
+        }
+
+    private:
+
+        GeneratePool& _pool;
+    };
+    typedef IceUtil::Handle<GenerateThread> GenerateThreadPtr;
+
+    vector<GenerateThreadPtr> _threads;
+    deque<Job> _jobs;
+    const size_t _size;
+    bool _finished;
+    string _error;
+};
+
+GeneratePool::GeneratePool(int size) :
+    _size(static_cast<size_t>(size) * 2),
+    _finished(false)
+{
+    if(size > 1)
+    {
+        //
+        // Create the file tracker before the threads use it.
+        //
+        FileTracker::instance();
+        for(int i = 0; i < size; ++i)
+        {
+            GenerateThreadPtr thread = new GenerateThread(*this);
+            thread->start();
+            _threads.push_back(thread);
+        }
+    }
+}
+
+GeneratePool::~GeneratePool()
+{
+    join();
+}
+
+bool
+GeneratePool::push(Gen* gen, const UnitPtr& unit)
+{
+    Lock sync(*this);
+    while(_error.empty() && _jobs.size() >= _size)
+    {
+        wait();
+    }
+    if(!_error.empty())
+    {
+        delete gen;
+        unit->destroy();
+        return false;
+    }
+
+    Job job;
+    job.gen = gen;
+    job.unit = unit;
+    _jobs.push_back(job);
+    notifyAll();
+    return true;
+}
+
+string
+GeneratePool::join()
+{
+    {
+        Lock sync(*this);
+        _finished = true;
+        notifyAll();
+    }
+
+    for(vector<GenerateThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    _threads.clear();
+
+    Lock sync(*this);
+    return _error;
+}
+
+bool
+GeneratePool::pop(Job& job)
+{
+    Lock sync(*this);
+    while(!_finished && _jobs.empty())
+    {
+        wait();
+    }
+    if(_jobs.empty())
+    {
+        return false;
+    }
+    job = _jobs.front();
+    _jobs.pop_front();
+    notifyAll();
+    return true;
+}
+
+void
+GeneratePool::failed(const string& error)
+{
+    Lock sync(*this);
+    if(_error.empty())
+    {
+        _error = error;
+    }
+
+    //
+    // Discard the pending jobs, the generated files are removed once
+    // the threads are joined.
+    //
+    for(deque<Job>::const_iterator p = _jobs.begin(); p != _jobs.end(); ++p)
+    {
+        delete p->gen;
+        p->unit->destroy();
+    }
+    _jobs.clear();
+    notifyAll();
+}
+
 }
 
 void
@@ -76,6 +262,9 @@ usage(const char* n)
         "--depend                 Generate Makefile dependencies.\n"
         "--depend-xml             Generate dependencies in XML format.\n"
         "--depend-file FILE       Write dependencies to FILE instead of standard output.\n"
+        "--depend-manifest FILE   Generate code and write Makefile dependencies to FILE.\n"
+        "--update                 Only rewrite the generated files whose contents changed.\n"
+        "-j, --jobs N             Generate code for up to N Slice files in parallel.\n"
         "-d, --debug              Print debug messages.\n"
         "--ice                    Allow reserved Ice prefix in Slice identifiers.\n"
         "--underscore             Allow underscores in Slice identifiers.\n"
@@ -104,6 +293,9 @@ compile(int argc, char* argv[])
     opts.addOpt("", "depend");
     opts.addOpt("", "depend-xml");
     opts.addOpt("", "depend-file", IceUtilInternal::Options::NeedArg, "");
+    opts.addOpt("", "depend-manifest", IceUtilInternal::Options::NeedArg, "");
+    opts.addOpt("", "update");
+    opts.addOpt("j", "jobs", IceUtilInternal::Options::NeedArg, "1");
     opts.addOpt("d", "debug");
     opts.addOpt("", "ice");
     opts.addOpt("", "underscore");
@@ -175,6 +367,21 @@ compile(int argc, char* argv[])
 
     string dependFile = opts.optArg("depend-file");
 
+    string dependManifest = opts.optArg("depend-manifest");
+
+    bool update = opts.isSet("update");
+
+    int jobs = 0;
+    {
+        istringstream is(opts.optArg("jobs"));
+        if(!(is >> jobs) || !is.eof() || jobs < 1)
+        {
+            getErrorStream() << argv[0] << ": error: invalid value for --jobs: " << opts.optArg("jobs") << endl;
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
     bool debug = opts.isSet("debug");
 
     bool ice = opts.isSet("ice");
@@ -199,17 +406,27 @@ compile(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    if((depend || dependxml) && !dependManifest.empty())
+    {
+        getErrorStream() << argv[0] << ": error: cannot specify both --depend-manifest and --depend or --depend-xml"
+                         << endl;
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
     int status = EXIT_SUCCESS;
 
     IceUtil::CtrlCHandler ctrlCHandler;
     ctrlCHandler.setCallback(interruptedCallback);
 
-    DependOutputUtil out(dependFile);
+    DependOutputUtil out(dependManifest.empty() ? dependFile : dependManifest);
     if(dependxml)
     {
         out.os() << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<dependencies>" << endl;
     }
 
+    GeneratePool pool(depend || dependxml || preprocess ? 1 : jobs);
+
     for(vector<string>::const_iterator i = args.begin(); i != args.end(); ++i)
     {
         //
@@ -285,8 +502,23 @@ compile(int argc, char* argv[])
                 UnitPtr u = Unit::createUnit(false, false, ice, underscore);
                 int parseStatus = u->parse(*i, cppHandle, debug);
 
+                //
+                // Write the dependencies of the Slice file to the
+                // manifest, this saves a separate --depend pass which
+                // would preprocess and parse all the files again.
+                //
+                if(parseStatus != EXIT_FAILURE && !dependManifest.empty() &&
+                   !icecpp->printMakefileDependencies(out.os(), Preprocessor::CPlusPlus, includePaths,
+                                                      "-D__SLICE2CPP__", sourceExtension, headerExtension))
+                {
+                    out.cleanup();
+                    u->destroy();
+                    return EXIT_FAILURE;
+                }
+
                 if(!icecpp->close())
                 {
+                    out.cleanup();
                     u->destroy();
                     return EXIT_FAILURE;
                 }
@@ -294,13 +526,24 @@ compile(int argc, char* argv[])
                 if(parseStatus == EXIT_FAILURE)
                 {
                     status = EXIT_FAILURE;
+                    u->destroy();
+                }
+                else if(!pool.empty())
+                {
+                    Gen* gen = new Gen(icecpp->getBaseName(), headerExtension, sourceExtension, extraHeaders,
+                                       include, includePaths, dllExport, output, impl, checksum, stream, ice,
+                                       update);
+                    if(!pool.push(gen, u))
+                    {
+                        break; // Generation failed, the error is reported below.
+                    }
                 }
                 else
                 {
                     try
                     {
                         Gen gen(icecpp->getBaseName(), headerExtension, sourceExtension, extraHeaders, include,
-                                includePaths, dllExport, output, impl, checksum, stream, ice);
+                                includePaths, dllExport, output, impl, checksum, stream, ice, update);
                         gen.generate(u);
                     }
                     catch(const Slice::FileException& ex)
@@ -308,13 +551,13 @@ compile(int argc, char* argv[])
                         // If a file could not be created, then
                         // cleanup any created files.
                         FileTracker::instance()->cleanup();
+                        out.cleanup();
                         u->destroy();
                         getErrorStream() << argv[0] << ": error: " << ex.reason() << endl;
                         return EXIT_FAILURE;
                     }
+                    u->destroy();
                 }
-
-                u->destroy();
             }
         }
 
@@ -323,6 +566,7 @@ compile(int argc, char* argv[])
 
             if(interrupted)
             {
+                pool.join();
                 out.cleanup();
                 FileTracker::instance()->cleanup();
                 return EXIT_FAILURE;
@@ -330,6 +574,17 @@ compile(int argc, char* argv[])
         }
     }
 
+    string error = pool.join();
+    if(!error.empty())
+    {
+        // If a file could not be created, then
+        // cleanup any created files.
+        FileTracker::instance()->cleanup();
+        out.cleanup();
+        getErrorStream() << argv[0] << ": error: " << error << endl;
+        return EXIT_FAILURE;
+    }
+
     if(dependxml)
     {
         out.os() << "</dependencies>\n";
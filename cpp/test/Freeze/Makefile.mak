@@ -12,6 +12,7 @@ top_srcdir	= ..\..
 !include $(top_srcdir)\config\Make.rules.mak
 
 SUBDIRS		= dbmap \
+		  bulk \
 		  complex \
 		  evictor \
 		  fileLock
@@ -0,0 +1,276 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceUtil/IceUtil.h>
+#include <Freeze/Freeze.h>
+#include <TestCommon.h>
+#include <IntIdentityMap.h>
+#include <Freeze/TransactionHolder.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace Ice;
+using namespace Freeze;
+using namespace Test;
+
+//
+// Number of records in the synthetic map used by the test and by the
+// timings reported at the end.
+//
+const int recordCount = 20000;
+const int scanThreads = 4;
+
+namespace
+{
+
+class CollectCallback : public IceUtil::Mutex
+{
+public:
+
+    void operator()(const int& key, const Identity& value)
+    {
+        Lock sync(*this);
+        test(records.insert(make_pair(key, value)).second);
+    }
+
+    map<int, Identity> records;
+};
+
+class CountCallback : public IceUtil::Mutex
+{
+public:
+
+    CountCallback() :
+        count(0)
+    {
+    }
+
+    void operator()(const int&, const Identity&)
+    {
+        Lock sync(*this);
+        ++count;
+    }
+
+    int count;
+};
+
+class FailCallback
+{
+public:
+
+    void operator()(const int& key, const Identity&)
+    {
+        if(key == recordCount / 2)
+        {
+            throw DatabaseException(__FILE__, __LINE__, "scan failure");
+        }
+    }
+};
+
+Identity
+makeIdentity(int i)
+{
+    ostringstream os;
+    os << "record-" << i << "-" << string(static_cast<size_t>(i % 64), 'x');
+    Identity id;
+    id.name = os.str();
+    id.category = i % 2 == 0 ? "even" : "odd";
+    return id;
+}
+
+void
+populate(const Freeze::ConnectionPtr& connection, IntIdentityMap& m)
+{
+    const int batch = 1000;
+    for(int i = 0; i < recordCount; i += batch)
+    {
+        TransactionHolder txHolder(connection);
+        for(int j = i; j < i + batch && j < recordCount; ++j)
+        {
+            m.put(IntIdentityMap::value_type(j, makeIdentity(j)));
+        }
+        txHolder.commit();
+    }
+}
+
+}
+
+int
+run(const CommunicatorPtr& communicator, const string& envName)
+{
+    const string dbName = "bulk";
+    Freeze::ConnectionPtr connection = createConnection(communicator, envName);
+
+    //
+    // The first map reads one record at a time, the second one in bulk.
+    //
+    IntIdentityMap standardMap(connection, dbName);
+    populate(connection, standardMap);
+
+    communicator->getProperties()->setProperty("Freeze.Map." + dbName + ".BulkReadSize", "16");
+    Freeze::ConnectionPtr bulkConnection = createConnection(communicator, envName);
+    const IntIdentityMap bulkMap(bulkConnection, dbName);
+
+    cout << "testing bulk iteration... " << flush;
+    {
+        int i = 0;
+        for(IntIdentityMap::const_iterator p = bulkMap.begin(); p != bulkMap.end(); ++p, ++i)
+        {
+            test(p->first == i);
+            test(p->second == makeIdentity(i));
+        }
+        test(i == recordCount);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing bulk iterator copy and lookup... " << flush;
+    {
+        IntIdentityMap::const_iterator p = bulkMap.begin();
+        for(int i = 0; i < 100; ++i)
+        {
+            ++p;
+        }
+        IntIdentityMap::const_iterator q = p;
+        test(q == p);
+        test(q->first == 100);
+        ++p;
+        test(p->first == 101);
+        test(q->first == 100);
+        ++q;
+        test(q == p);
+        for(int i = 0; i < 1000; ++i)
+        {
+            ++q;
+        }
+        test(q->first == 1101);
+        test(q->second == makeIdentity(1101));
+
+        p = bulkMap.find(5000);
+        test(p != bulkMap.end());
+        test(p->second == makeIdentity(5000));
+        ++p;
+        test(p->first == 5001);
+
+        p = bulkMap.upper_bound(recordCount - 2);
+        test(p != bulkMap.end());
+        test(p->first == recordCount - 1);
+        ++p;
+        test(p == bulkMap.end());
+    }
+    cout << "ok" << endl;
+
+    cout << "testing scan... " << flush;
+    {
+        CollectCallback cb;
+        bulkMap.scan(cb);
+        test(static_cast<int>(cb.records.size()) == recordCount);
+
+        CollectCallback parallelCb;
+        bulkMap.scan(parallelCb, scanThreads);
+        test(parallelCb.records == cb.records);
+
+        //
+        // Scan also works when bulk iteration isn't enabled
+        //
+        CountCallback countCb;
+        standardMap.scan(countCb, scanThreads);
+        test(countCb.count == recordCount);
+
+        FailCallback failCb;
+        try
+        {
+            bulkMap.scan(failCb, scanThreads);
+            test(false);
+        }
+        catch(const DatabaseException& ex)
+        {
+            test(ex.message == "scan failure");
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "timing iteration over " << recordCount << " records... " << flush;
+    {
+        const IntIdentityMap& constStandardMap = standardMap;
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        int count = 0;
+        for(IntIdentityMap::const_iterator p = constStandardMap.begin(); p != constStandardMap.end(); ++p)
+        {
+            count += p->second.name.empty() ? 0 : 1;
+        }
+        IceUtil::Time standardTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        test(count == recordCount);
+
+        start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        count = 0;
+        for(IntIdentityMap::const_iterator p = bulkMap.begin(); p != bulkMap.end(); ++p)
+        {
+            count += p->second.name.empty() ? 0 : 1;
+        }
+        IceUtil::Time bulkTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        test(count == recordCount);
+
+        start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        CountCallback countCb;
+        bulkMap.scan(countCb, scanThreads);
+        IceUtil::Time scanTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        test(countCb.count == recordCount);
+
+        cout << "ok" << endl;
+        cout << "  standard: " << standardTime.toMilliSecondsDouble() << "ms, bulk: "
+             << bulkTime.toMilliSecondsDouble() << "ms, scan (" << scanThreads << " threads): "
+             << scanTime.toMilliSecondsDouble() << "ms" << endl;
+    }
+
+    standardMap.clear();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    Ice::CommunicatorPtr communicator;
+
+    string envName = "db";
+
+    try
+    {
+        communicator = Ice::initialize(argc, argv);
+        if(argc != 1)
+        {
+            envName = argv[1];
+            envName += "/";
+            envName += "db";
+        }
+
+        status = run(communicator, envName);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,41 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+top_srcdir	= ..\..\..
+
+CLIENT		= client.exe
+
+TARGETS		= $(CLIENT)
+
+OBJS		= .\IntIdentityMap.obj \
+		  .\Client.obj
+
+all:: 		  IntIdentityMap.cpp IntIdentityMap.h
+
+!include $(top_srcdir)\config\Make.rules.mak
+
+CPPFLAGS	= -I. -I..\..\include $(CPPFLAGS) -DWIN32_LEAN_AND_MEAN
+
+!if "$(GENERATE_PDB)" == "yes"
+CPDBFLAGS        = /pdb:$(CLIENT:.exe=.pdb)
+!endif
+
+$(CLIENT): $(OBJS)
+	$(LINK) $(LD_EXEFLAGS) $(PDBFLAGS) $(SETARGV) $(OBJS) $(PREOUT)$@ $(PRELIBS)$(LIBS) 
+	@if exist $@.manifest echo ^ ^ ^ Embedding manifest using $(MT) && \
+	    $(MT) -nologo -manifest $@.manifest -outputresource:$@;#1 && del /q $@.manifest
+
+IntIdentityMap.h IntIdentityMap.cpp: "$(slicedir)\Ice\Identity.ice" "$(SLICE2FREEZE)" "$(SLICEPARSERLIB)"
+	del /q IntIdentityMap.h IntIdentityMap.cpp
+	"$(SLICE2FREEZE)" --ice $(SLICE2CPPFLAGS)  --dict Test::IntIdentityMap,int,Ice::Identity IntIdentityMap "$(slicedir)\Ice\Identity.ice"
+
+clean::
+	del /q IntIdentityMap.h IntIdentityMap.cpp
+	-if exist db\__Freeze rmdir /q /s db\__Freeze
+	-for %f in (db\*) do if not %f == db\.gitignore del /q %f
@@ -25,4 +25,10 @@ TestUtil.cleanDbDir(dbdir)
 
 testOptions = ' --Freeze.DbEnv.db.DbHome="%s" --Ice.Config="%s"' % (dbdir, os.path.join(os.getcwd(), "config"))
 
+print("Running test with default save thread.")
 TestUtil.clientServerTest(additionalServerOptions= testOptions, additionalClientOptions= testOptions)
+
+print("Running test with stream and save threads.")
+TestUtil.cleanDbDir(dbdir)
+threadOptions = ' --Freeze.Evictor.db.Test.StreamThreads=3 --Freeze.Evictor.db.Test.SaveThreads=2'
+TestUtil.clientServerTest(additionalServerOptions= testOptions + threadOptions, additionalClientOptions= testOptions)
@@ -39,3 +39,5 @@ clean::
 	del /q db\*.db db\log.* db\__catalog db\__catalogIndexList
 	if exist db_check rmdir /s /q db_check
 	if exist db_tmp rmdir /s /q db_tmp
+	if exist db_pipeline rmdir /s /q db_pipeline
+	if exist db_pipeline_tmp rmdir /s /q db_pipeline_tmp
@@ -38,6 +38,16 @@ if os.path.exists(tmp_dbdir):
     shutil.rmtree(tmp_dbdir)
 os.mkdir(tmp_dbdir)
 
+pipeline_dbdir = os.path.join(os.getcwd(), "db_pipeline")
+if os.path.exists(pipeline_dbdir):
+    shutil.rmtree(pipeline_dbdir)
+os.mkdir(pipeline_dbdir)
+
+pipeline_tmp_dbdir = os.path.join(os.getcwd(), "db_pipeline_tmp")
+if os.path.exists(pipeline_tmp_dbdir):
+    shutil.rmtree(pipeline_tmp_dbdir)
+os.mkdir(pipeline_tmp_dbdir)
+
 sys.stdout.write("creating test database... ")
 sys.stdout.flush()
 
@@ -69,5 +79,23 @@ proc = TestUtil.spawn(command)
 proc.waitTestSuccess()
 print("ok")
 
+sys.stdout.write("executing evictor transformations with pipeline... ")
+sys.stdout.flush()
+
+command = '"' + transformdb + '" -e -p --pipeline --progress --old "' + testold + '" --new "' + testnew + '" -f "' + \
+    transformxml + '" "' + dbdir + '" evictor.db "' + pipeline_dbdir + '" '
+proc = TestUtil.spawn(command)
+proc.waitTestSuccess()
+print("ok")
+
+sys.stdout.write("validating database... ")
+sys.stdout.flush()
+
+command = '"' + transformdb + '" -e --old "' + testnew + '" --new "' + testnew + '" -f "' + checkxml + '" "' + \
+    pipeline_dbdir + '" evictor.db "' + pipeline_tmp_dbdir + '"'
+proc = TestUtil.spawn(command)
+proc.waitTestSuccess()
+print("ok")
+
 if TestUtil.appverifier:
     TestUtil.appVerifierAfterTestEnd([transformdb])
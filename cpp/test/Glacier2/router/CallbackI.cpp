@@ -320,6 +320,12 @@ CallbackI::initiateCallbackWithPayload_async(const AMD_Callback_initiateCallback
         newCookie(cb));
 }
 
+Ice::ByteSeq
+CallbackI::echoPayload(const Ice::ByteSeq& payload, const Ice::Current&)
+{
+    return payload;
+}
+
 void
 CallbackI::shutdown(const Ice::Current& current)
 {
@@ -67,6 +67,8 @@ public:
                                                    const ::Test::CallbackReceiverPrx&,
                                                    const ::Ice::Current&);
 
+    virtual Ice::ByteSeq echoPayload(const Ice::ByteSeq&, const Ice::Current&);
+
     virtual void shutdown(const Ice::Current&);
 };
 
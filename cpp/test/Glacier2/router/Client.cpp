@@ -621,6 +621,35 @@ CallbackClient::run(int argc, char* argv[])
         cout << "ok" << endl;
     }
 
+    {
+        cout << "testing forwarding of request and reply parameters... " << flush;
+
+        //
+        // Without context, the router forwards the received request
+        // message with its header re-marshaled. The router doesn't
+        // forward contexts, with a context the header of the forwarded
+        // request is smaller and the router copies the parameters. The
+        // reply message is forwarded the same way.
+        //
+        Context context;
+        context["_fwd"] = "t";
+        context["abc"] = "def";
+        CallbackPrx compressed = CallbackPrx::uncheckedCast(twoway->ice_compress(true));
+        const int sizes[] = { 0, 1, 1024, 100 * 1024 };
+        for(unsigned int i = 0; i < sizeof(sizes) / sizeof(int); ++i)
+        {
+            ByteSeq payload(sizes[i]);
+            for(unsigned int j = 0; j < payload.size(); ++j)
+            {
+                payload[j] = static_cast<Ice::Byte>(j);
+            }
+            test(twoway->echoPayload(payload) == payload);
+            test(twoway->echoPayload(payload, context) == payload);
+            test(compressed->echoPayload(payload) == payload);
+        }
+        cout << "ok" << endl;
+    }
+
     //
     // Send 3 twoway request to callback the receiver. The callback
     // receiver only reply to the callback once it received the 3
@@ -25,7 +25,7 @@ router = TestUtil.getGlacier2Router()
 if TestUtil.appverifier:
     TestUtil.setAppVerifierSettings([router])
 
-def startRouter(buffered):
+def startRouter(buffered, coalesce = False):
 
     args = ' --Ice.Warn.Dispatch=0' + \
            ' --Ice.Warn.Connections=0' + \
@@ -38,7 +38,12 @@ def startRouter(buffered):
            ' --Ice.Admin.InstanceName="Glacier2"' + \
            ' --Glacier2.CryptPasswords="%s"' % os.path.join(os.getcwd(), "passwords")
 
-    if buffered:
+    if buffered and coalesce:
+        args += ' --Glacier2.Client.Buffered=1 --Glacier2.Server.Buffered=1' + \
+                ' --Glacier2.Client.Coalesce=1 --Glacier2.Client.CoalesceSize=1024'
+        sys.stdout.write("starting router in buffered mode with coalescing... ")
+        sys.stdout.flush()
+    elif buffered:
         args += ' --Glacier2.Client.Buffered=1 --Glacier2.Server.Buffered=1' 
         sys.stdout.write("starting router in buffered mode... ")
         sys.stdout.flush()
@@ -82,5 +87,13 @@ TestUtil.clientServerTest(name, additionalClientOptions = " --shutdown")
 
 starterProc.waitTestSuccess()
 
+#
+# Finally we run the test in buffered mode with oneway requests
+# coalesced into batches on the back-end connections.
+#
+starterProc = startRouter(True, True)
+TestUtil.clientServerTest(name, additionalClientOptions = " --shutdown")
+starterProc.waitTestSuccess()
+
 if TestUtil.appverifier:
     TestUtil.appVerifierAfterTestEnd([router])
@@ -45,6 +45,7 @@ SUBDIRS		= $(SUBDIRS) \
 		  faultTolerance \
 		  checksum \
 		  stringConverter \
+		  internTable \
 		  background \
 		  threadPoolPriority \
 		  custom \
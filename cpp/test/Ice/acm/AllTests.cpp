@@ -11,6 +11,8 @@
 #include <TestCommon.h>
 #include <Test.h>
 
+#include <ctime>
+
 using namespace std;
 using namespace Test;
 namespace
@@ -265,6 +267,46 @@ protected:
 };
 typedef IceUtil::Handle<TestCase> TestCasePtr;
 
+#ifndef _WIN32
+void
+idleConnectionsBenchmark(const RemoteCommunicatorPrx& com)
+{
+    //
+    // Measure the CPU time used by the client while it keeps idle
+    // connections open. The ACM monitor doesn't check idle connections
+    // which can neither send heartbeats nor be closed, the CPU time
+    // must not depend on the number of idle connections.
+    //
+    const int connectionCount = 500;
+    cout << "measuring CPU time with " << connectionCount << " idle connections... " << flush;
+
+    RemoteObjectAdapterPrx adapter = com->createObjectAdapter(-1, -1, -1);
+
+    Ice::InitializationData initData;
+    initData.properties = com->ice_getCommunicator()->getProperties()->clone();
+    initData.properties->setProperty("Ice.ACM.Client.Timeout", "1");
+    initData.properties->setProperty("Ice.ACM.Client.Close", "0"); // CloseOff
+    initData.properties->setProperty("Ice.ACM.Client.Heartbeat", "0"); // HeartbeatOff
+    Ice::CommunicatorPtr communicator = Ice::initialize(initData);
+
+    TestIntfPrx proxy = TestIntfPrx::uncheckedCast(communicator->stringToProxy(
+                                                       adapter->getTestIntf()->ice_toString()));
+    for(int i = 0; i < connectionCount; ++i)
+    {
+        proxy->ice_connectionId(toString(i))->ice_ping();
+    }
+
+    clock_t start = clock();
+    IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(3));
+    clock_t cpu = clock() - start;
+
+    communicator->destroy();
+    adapter->deactivate();
+
+    cout << "ok (" << static_cast<double>(cpu) * 1000 / CLOCKS_PER_SEC << "ms in 3s)" << endl;
+}
+#endif
+
 }
 
 void
@@ -542,6 +584,78 @@ allTests(const Ice::CommunicatorPtr& communicator)
         }
     };
 
+    class ParkedConnectionActivityTest : public TestCase
+    {
+    public:
+
+        ParkedConnectionActivityTest(const RemoteCommunicatorPrx& com) :
+            TestCase("activity on parked connection", com)
+        {
+            setClientACM(1, 2, 0); // Only close on invocation, no heartbeat.
+            setServerACM(1, 2, 0); // Disable heartbeat on invocations.
+        }
+
+        virtual void runTestCase(const RemoteObjectAdapterPrx& adapter, const TestIntfPrx& proxy)
+        {
+            //
+            // The idle connection is no longer checked by the monitor
+            // until it's used again. The invocation must wake it up
+            // and the connection must be closed once the invocation
+            // didn't receive heartbeats for the ACM timeout.
+            //
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1500)); // Idle for 1.5 seconds
+
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            try
+            {
+                proxy->sleep(10);
+                test(false);
+            }
+            catch(const Ice::ConnectionTimeoutException&)
+            {
+                IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+                test(elapsed >= IceUtil::Time::seconds(1));
+                test(elapsed < IceUtil::Time::seconds(3));
+
+                proxy->interruptSleep();
+
+                waitForClosed();
+            }
+        }
+    };
+
+    class CloseOnIdleDeadlineTest : public TestCase
+    {
+    public:
+
+        CloseOnIdleDeadlineTest(const RemoteCommunicatorPrx& com) :
+            TestCase("close on idle deadline", com)
+        {
+            setClientACM(1, 1, 0); // Only close on idle
+        }
+
+        virtual void runTestCase(const RemoteObjectAdapterPrx& adapter, const TestIntfPrx& proxy)
+        {
+            //
+            // The connection is used for longer than the ACM timeout,
+            // it must only be closed once idle for the ACM timeout.
+            //
+            for(int i = 0; i < 8; ++i)
+            {
+                proxy->ice_ping();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+            }
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(800)); // Idle for 0.8 seconds
+
+            {
+                Lock sync(*this);
+                test(!_closed);
+            }
+
+            waitForClosed();
+        }
+    };
+
     tests.push_back(new InvocationHeartbeatTest(com));
     tests.push_back(new InvocationHeartbeatOnHoldTest(com));
     tests.push_back(new InvocationNoHeartbeatTest(com));
@@ -556,6 +670,9 @@ allTests(const Ice::CommunicatorPtr& communicator)
     tests.push_back(new HeartbeatAlwaysTest(com));
     tests.push_back(new SetACMTest(com));
 
+    tests.push_back(new ParkedConnectionActivityTest(com));
+    tests.push_back(new CloseOnIdleDeadlineTest(com));
+
     for(vector<TestCasePtr>::const_iterator p = tests.begin(); p != tests.end(); ++p)
     {
         (*p)->init();
@@ -573,6 +690,10 @@ allTests(const Ice::CommunicatorPtr& communicator)
         (*p)->destroy();
     }
 
+#ifndef _WIN32
+    idleConnectionsBenchmark(com);
+#endif
+
     cout << "shutting down... " << flush;
     com->shutdown();
     cout << "ok" << endl;
@@ -0,0 +1,174 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+DEFINE_TEST("client")
+
+namespace
+{
+
+//
+// Number of allocations made by the process. This isn't protected
+// against concurrent allocations from other threads, it's only used
+// to measure the allocations of many requests.
+//
+volatile long allocations = 0;
+
+}
+
+void*
+operator new(size_t sz) throw(std::bad_alloc)
+{
+    ++allocations;
+    void* p = malloc(sz > 0 ? sz : 1);
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void
+operator delete(void* p) throw()
+{
+    free(p);
+}
+
+namespace
+{
+
+class BlobjectI : public Ice::Blobject
+{
+public:
+
+    virtual bool
+    ice_invoke(const vector<Ice::Byte>&, vector<Ice::Byte>&, const Ice::Current&)
+    {
+        return true;
+    }
+};
+
+//
+// Returns the smallest number of allocations per request made by
+// several series of requests.
+//
+long
+allocationsPerRequest(const Ice::ObjectPrx& prx, const string& operation)
+{
+    const int requestCount = 1000;
+    const vector<Ice::Byte> inParams;
+    vector<Ice::Byte> outParams;
+
+    //
+    // Warm up the proxy, the connection and the strings of the
+    // dispatch thread.
+    //
+    for(int i = 0; i < 100; ++i)
+    {
+        prx->ice_invoke(operation, Ice::Normal, inParams, outParams);
+    }
+
+    long result = -1;
+    for(int i = 0; i < 5; ++i)
+    {
+        long start = allocations;
+        for(int j = 0; j < requestCount; ++j)
+        {
+            prx->ice_invoke(operation, Ice::Normal, inParams, outParams);
+        }
+        long count = (allocations - start) / requestCount;
+        if(result < 0 || count < result)
+        {
+            result = count;
+        }
+    }
+    return result;
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", "default -p 12010");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+
+    //
+    // Strings longer than the small string buffer of std::string
+    // implementations.
+    //
+    Ice::Identity longId;
+    longId.name = "a-rather-long-identity-name";
+    longId.category = "a-rather-long-identity-category";
+    const string longFacet = "a-rather-long-facet-name";
+    const string longOperation = "aRatherLongOperationName";
+
+    Ice::Identity shortId;
+    shortId.name = "a";
+
+    adapter->add(new BlobjectI, shortId);
+    adapter->addFacet(new BlobjectI, longId, longFacet);
+    adapter->activate();
+
+    cout << "testing allocations of dispatched requests... " << flush;
+    long shortCount = allocationsPerRequest(adapter->createProxy(shortId), "op");
+    long longCount = allocationsPerRequest(adapter->createProxy(longId)->ice_facet(longFacet), longOperation);
+
+    //
+    // The identity, facet and operation strings of a request reuse
+    // the strings of the previous request dispatched by the thread,
+    // their length doesn't change the number of allocations.
+    //
+    test(longCount <= shortCount);
+    cout << "ok (" << longCount << " allocations per request)" << endl;
+
+    return EXIT_SUCCESS;
+}
+
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    Ice::CommunicatorPtr communicator;
+
+    try
+    {
+        Ice::InitializationData initData;
+        initData.properties = Ice::createProperties(argc, argv);
+        communicator = Ice::initialize(argc, argv, initData);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
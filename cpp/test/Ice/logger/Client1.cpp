@@ -10,6 +10,7 @@
 #include <Ice/Ice.h>
 #include <TestCommon.h>
 #include <fstream>
+#include <sstream>
 
 using namespace std;
 
@@ -27,6 +28,44 @@ public:
     };
 };
 
+Ice::CommunicatorPtr
+createCommunicator(const string& async, const string& overflow = "block", const string& queueSize = "",
+                   const string& sizeMax = "")
+{
+    Ice::InitializationData id;
+    id.properties = Ice::createProperties();
+    id.properties->setProperty("Ice.LogFile", "log.txt");
+    id.properties->setProperty("Ice.LogFile.Async", async);
+    id.properties->setProperty("Ice.LogFile.Overflow", overflow);
+    id.properties->setProperty("Ice.LogFile.QueueSize", queueSize);
+    id.properties->setProperty("Ice.LogFile.SizeMax", sizeMax);
+    return Ice::initialize(id);
+}
+
+vector<string>
+readLog()
+{
+    vector<string> lines;
+    ifstream in("log.txt");
+    test(in);
+    string s;
+    while(getline(in, s))
+    {
+        lines.push_back(s);
+    }
+    in.close();
+    remove("log.txt");
+    return lines;
+}
+
+string
+message(int i)
+{
+    ostringstream os;
+    os << "message " << i;
+    return os.str();
+}
+
 }
 
 int
@@ -56,5 +95,118 @@ main(int argc, char* argv[])
     in.close();
     remove("log.txt");
     cout << "ok" << endl;
+
+    cout << "testing asynchronous logger with Ice.LogFile... " << flush;
+    {
+        Ice::CommunicatorPtr communicator = createCommunicator("1");
+        Ice::LoggerPtr logger = communicator->getLogger();
+        for(int i = 0; i < 1000; ++i)
+        {
+            logger->trace("info", message(i));
+        }
+        logger->cloneWithPrefix("clone")->warning("first line\nsecond line");
+        communicator->destroy();
+
+        //
+        // Messages logged after the communicator destruction are
+        // written directly.
+        //
+        logger->print("after destroy");
+
+        vector<string> lines = readLog();
+        test(lines.size() == 1003);
+        for(int i = 0; i < 1000; ++i)
+        {
+            test(lines[i].find("-- ") == 0);
+            test(lines[i].find("info: " + message(i)) == lines[i].size() - message(i).size() - 6);
+        }
+        test(lines[1000].find("clone: warning: first line") != string::npos);
+        test(lines[1001] == "   second line");
+        test(lines[1002] == "after destroy");
+    }
+    cout << "ok" << endl;
+
+    cout << "testing asynchronous logger overflow... " << flush;
+    {
+        const int count = 10000;
+        Ice::CommunicatorPtr communicator = createCommunicator("1", "drop", "1");
+        Ice::LoggerPtr logger = communicator->getLogger();
+        for(int i = 0; i < count; ++i)
+        {
+            logger->print(message(i));
+        }
+        communicator->destroy();
+
+        vector<string> lines = readLog();
+        int received = 0;
+        int dropped = 0;
+        for(vector<string>::const_iterator p = lines.begin(); p != lines.end(); ++p)
+        {
+            if(p->find("-! ") == 0)
+            {
+                test(p->find("log messages were dropped") != string::npos);
+                istringstream is(p->substr(p->find("warning: ") + 9));
+                int n;
+                is >> n;
+                dropped += n;
+            }
+            else
+            {
+                test(*p == message(received + dropped));
+                ++received;
+            }
+        }
+        test(received + dropped == count);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing asynchronous logger rotation... " << flush;
+    {
+        const int count = 1000;
+        Ice::CommunicatorPtr communicator = createCommunicator("1", "block", "", "1");
+        Ice::LoggerPtr logger = communicator->getLogger();
+        for(int i = 0; i < count; ++i)
+        {
+            logger->print(message(i));
+        }
+        communicator->destroy();
+
+        //
+        // The rotated files are removed by run.py.
+        //
+        vector<string> lines = readLog();
+        test(!lines.empty() && lines.size() < static_cast<size_t>(count));
+        test(lines.back() == message(count - 1));
+        size_t size = 0;
+        for(vector<string>::const_iterator p = lines.begin(); p != lines.end(); ++p)
+        {
+            size += p->size() + 1;
+        }
+        test(size <= 1024);
+    }
+    cout << "ok" << endl;
+
+    cout << "timing synchronous and asynchronous loggers... " << flush;
+    {
+        const int count = 50000;
+        IceUtil::Time times[2];
+        for(int i = 0; i < 2; ++i)
+        {
+            Ice::CommunicatorPtr communicator = createCommunicator(i == 0 ? "0" : "1");
+            Ice::LoggerPtr logger = communicator->getLogger();
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            for(int j = 0; j < count; ++j)
+            {
+                logger->trace("Protocol", message(j));
+            }
+            times[i] = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+            communicator->destroy();
+            test(readLog().size() == static_cast<size_t>(count));
+        }
+        cout << "ok" << endl;
+        cout << "  " << count << " traces, synchronous: " << times[0].toMilliSecondsDouble()
+             << "ms, asynchronous: " << times[1].toMilliSecondsDouble() << "ms" << endl;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -9,7 +9,7 @@
 #
 # **********************************************************************
 
-import os, sys, subprocess
+import os, sys, subprocess, glob
 
 path = [ ".", "..", "../..", "../../..", "../../../..", "../../../../.." ]
 head = os.path.dirname(sys.argv[0])
@@ -31,6 +31,8 @@ def test(cmd, match, enc):
         raise RuntimeError("test failed")
 
 TestUtil.simpleTest(os.path.join(os.getcwd(), "client1"))
+for f in glob.glob("log-*.txt"):
+    os.remove(f)
 env = TestUtil.getTestEnv("cpp", os.getcwd())
 
 sys.stdout.write("testing logger ISO-8859-15 output... ")
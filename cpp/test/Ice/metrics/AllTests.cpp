@@ -382,6 +382,21 @@ toMap(const IceMX::MetricsMap& mmap)
     return m;
 }
 
+#if !defined(ICE_OS_WINRT) && TARGET_OS_IPHONE==0
+Ice::Long
+getEndpointLookupCount(const IceMX::MetricsAdminPtr& metrics)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsMap mmap = metrics->getMetricsView("View", timestamp)["EndpointLookup"];
+    Ice::Long count = 0;
+    for(IceMX::MetricsMap::const_iterator p = mmap.begin(); p != mmap.end(); ++p)
+    {
+        count += (*p)->total;
+    }
+    return count;
+}
+#endif
+
 }
 
 MetricsPrx
@@ -763,6 +778,68 @@ allTests(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPt
         testAttribute(clientMetrics, clientProps, update, "EndpointLookup", "endpointPort", "12010", c);
 
         cout << "ok" << endl;
+
+        cout << "testing endpoint lookup cache... " << flush;
+        {
+            Ice::InitializationData initData;
+            initData.properties = Ice::createProperties();
+            initData.properties->setProperty("Ice.Admin.Enabled", "1");
+            initData.properties->setProperty("IceMX.Metrics.View.Map.EndpointLookup.GroupBy", "id");
+            initData.properties->setProperty("Ice.HostResolver.Size", "4");
+            initData.properties->setProperty("Ice.HostResolver.CacheTimeout", "60");
+            initData.properties->setProperty("Ice.HostResolver.NegativeCacheTimeout", "60");
+            Ice::CommunicatorPtr com = Ice::initialize(initData);
+            IceMX::MetricsAdminPtr comMetrics = IceMX::MetricsAdminPtr::dynamicCast(com->findAdminFacet("Metrics"));
+            test(comMetrics);
+
+            //
+            // The host is only looked up once, the other endpoints with
+            // the same host use the cached addresses.
+            //
+            com->stringToProxy("metrics:tcp -h localhost -p 12010")->ice_ping();
+            test(getEndpointLookupCount(comMetrics) == 1);
+            com->stringToProxy("metrics:tcp -h localhost -p 12010 -t 10000")->ice_ping();
+            com->stringToProxy("metrics:tcp -h localhost -p 12010 -t 20000")->ice_ping();
+            test(getEndpointLookupCount(comMetrics) == 1);
+
+            //
+            // Concurrent lookups of the same host are coalesced and
+            // failures are cached as well.
+            //
+            vector<Ice::AsyncResultPtr> results;
+            for(int i = 0; i < 10; ++i)
+            {
+                ostringstream os;
+                os << "test:tcp -t 500 -h unknownfoo.zeroc.com -p " << 12100 + i;
+                results.push_back(com->stringToProxy(os.str())->begin_ice_ping());
+            }
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                try
+                {
+                    (*p)->getProxy()->end_ice_ping(*p);
+                    test(false);
+                }
+                catch(const Ice::LocalException&)
+                {
+                    // Some DNS servers don't fail on unknown DNS names.
+                }
+            }
+            Ice::Long count = getEndpointLookupCount(comMetrics);
+            test(count > 1 && count <= 11);
+            try
+            {
+                com->stringToProxy("test:tcp -t 500 -h unknownfoo.zeroc.com -p 12200")->ice_ping();
+                test(false);
+            }
+            catch(const Ice::LocalException&)
+            {
+            }
+            test(getEndpointLookupCount(comMetrics) == count);
+
+            com->destroy();
+        }
+        cout << "ok" << endl;
 #endif
     }
 
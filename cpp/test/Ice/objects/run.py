@@ -31,5 +31,9 @@ print("Running test with 1.0 encoding.")
 TestUtil.clientServerTest(additionalClientOptions="--Ice.Default.EncodingVersion=1.0", 
                           additionalServerOptions="--Ice.Default.EncodingVersion=1.0")
 
+print("Running test with object collection.")
+TestUtil.clientServerTest(additionalClientOptions="--Ice.CollectObjects=1", 
+                          additionalServerOptions="--Ice.CollectObjects=1")
+
 print("Running collocated test.")
 TestUtil.collocatedTest()
@@ -24,5 +24,8 @@ print("tests with regular server.")
 TestUtil.clientServerTest(additionalClientOptions = "--Ice.Warn.AMICallback=0")
 print("tests with AMD server.")
 TestUtil.clientServerTest(additionalClientOptions = "--Ice.Warn.AMICallback=0", server = "serveramd")
+print("tests with read-ahead.")
+TestUtil.clientServerTest(additionalClientOptions = "--Ice.Warn.AMICallback=0 --Ice.ReadAheadSize=64",
+                          additionalServerOptions = "--Ice.ReadAheadSize=64")
 print("tests with collocated server.")
 TestUtil.collocatedTest()
@@ -11,6 +11,8 @@
 #include <TestCommon.h>
 #include <Test.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace Test;
 
@@ -67,6 +69,29 @@ allTests(const Ice::CommunicatorPtr& communicator)
         test(service4->getArgs() == args4);
 
         cout << "ok" << endl;
+
+        cout << "testing service start order... " << flush;
+
+        //
+        // Service2 depends on Service1 and Service4 depends on Service1
+        // and Service3, either through the load order or through the
+        // dependencies when the services are started in parallel.
+        //
+        Ice::StringSeq started = service2->getStartedServices();
+        test(find(started.begin(), started.end(), "Service1") != started.end());
+
+        started = service4->getStartedServices();
+        test(find(started.begin(), started.end(), "Service1") != started.end());
+        test(find(started.begin(), started.end(), "Service3") != started.end());
+
+        started = service1->getStartedServices();
+        test(find(started.begin(), started.end(), "Service2") == started.end());
+        test(find(started.begin(), started.end(), "Service4") == started.end());
+
+        started = service3->getStartedServices();
+        test(find(started.begin(), started.end(), "Service4") == started.end());
+
+        cout << "ok" << endl;
     }
     else
     {
@@ -14,6 +14,18 @@
 using namespace std;
 using namespace Ice;
 
+namespace
+{
+
+//
+// The services of the IceBox server which are started, in the order
+// they were started.
+//
+IceUtil::Mutex startedMutex;
+StringSeq startedServices;
+
+}
+
 class ServiceI : public ::IceBox::Service
 {
 public:
@@ -53,9 +65,24 @@ ServiceI::~ServiceI()
 void
 ServiceI::start(const string& name, const CommunicatorPtr& communicator, const StringSeq& args)
 {
+    StringSeq started;
+    {
+        IceUtil::Mutex::Lock sync(startedMutex);
+        started = startedServices;
+    }
+
+    //
+    // Take some time to start, a service started without waiting for
+    // its dependencies would see them as not started yet.
+    //
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+
     Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter(name + "OA");
-    adapter->add(new TestI(args), communicator->stringToIdentity("test"));
+    adapter->add(new TestI(args, started), communicator->stringToIdentity("test"));
     adapter->activate();
+
+    IceUtil::Mutex::Lock sync(startedMutex);
+    startedServices.push_back(name);
 }
 
 void
@@ -12,7 +12,9 @@
 
 using namespace Test;
 
-TestI::TestI(const Ice::StringSeq& args) : _args(args)
+TestI::TestI(const Ice::StringSeq& args, const Ice::StringSeq& startedServices) :
+    _args(args),
+    _startedServices(startedServices)
 {
 }
 
@@ -27,3 +29,9 @@ TestI::getArgs(const Ice::Current&)
 {
     return _args;
 }
+
+Ice::StringSeq
+TestI::getStartedServices(const Ice::Current&)
+{
+    return _startedServices;
+}
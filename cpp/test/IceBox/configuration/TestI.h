@@ -16,14 +16,16 @@ class TestI : public ::Test::TestIntf
 {
 public:
 
-    TestI(const Ice::StringSeq&);
+    TestI(const Ice::StringSeq&, const Ice::StringSeq&);
     
     virtual std::string getProperty(const std::string&, const Ice::Current&);
     virtual Ice::StringSeq getArgs(const Ice::Current&);
+    virtual Ice::StringSeq getStartedServices(const Ice::Current&);
 
 private:
 
     const Ice::StringSeq _args;
+    const Ice::StringSeq _startedServices;
 };
 
 #endif
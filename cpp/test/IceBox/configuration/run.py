@@ -27,3 +27,7 @@ config2 = os.path.join(os.getcwd(), "config.icebox2")
 
 TestUtil.clientServerTest(additionalServerOptions= '--Ice.Config="%s"' % config, server = icebox)
 TestUtil.clientServerTest(additionalServerOptions= '--Ice.Config="%s"' % config2, server = icebox)
+print("tests with parallel service startup.")
+TestUtil.clientServerTest(additionalServerOptions= '--Ice.Config="%s" --IceBox.ServiceThreads=4 '
+                          '--IceBox.DependsOn.Service2=Service1 --IceBox.DependsOn.Service4="Service1 Service3"' %
+                          config, server = icebox)
@@ -194,6 +194,85 @@ allTests(const CommunicatorPtr& communicator, int num)
     }
     cout << "ok" << endl;
 
+    cout << "testing batched lookups and adaptive retries... " << flush;
+    {
+        //
+        // Batching and adaptive retries are disabled by default. With
+        // batching enabled, concurrent lookups are coalesced into
+        // batched requests.
+        //
+        InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("IceDiscovery.BatchSize", "100");
+        initData.properties->setProperty("IceDiscovery.AdaptiveRetry", "1");
+        CommunicatorPtr com = initialize(initData);
+
+        vector<AsyncResultPtr> results;
+        for(int i = 0; i < 3; ++i)
+        {
+            for(vector<ControllerPrx>::const_iterator p = indirectProxies.begin(); p != indirectProxies.end(); ++p)
+            {
+                ObjectPrx prx = com->stringToProxy(communicator->proxyToString(*p));
+                results.push_back(prx->ice_locatorCacheTimeout(0)->begin_ice_ping());
+            }
+            for(vector<ControllerPrx>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+            {
+                ObjectPrx prx = com->stringToProxy(communicator->proxyToString(*p));
+                results.push_back(prx->ice_locatorCacheTimeout(0)->begin_ice_ping());
+            }
+        }
+        for(vector<AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            (*p)->getProxy()->end_ice_ping(*p);
+        }
+        com->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing negative cache... " << flush;
+    {
+        InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("IceDiscovery.NegativeCacheTimeout", "500");
+        CommunicatorPtr com = initialize(initData);
+        ObjectPrx prx = com->stringToProxy("object @ oa1")->ice_locatorCacheTimeout(0);
+        try
+        {
+            prx->ice_ping();
+            test(false);
+        }
+        catch(const Ice::NoEndpointException&)
+        {
+        }
+
+        proxies[0]->activateObjectAdapter("oa", "oa1", "");
+
+        //
+        // The miss is cached until it expires.
+        //
+        try
+        {
+            prx->ice_ping();
+            test(false);
+        }
+        catch(const Ice::NoEndpointException&)
+        {
+        }
+
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(600));
+        try
+        {
+            prx->ice_ping();
+        }
+        catch(const Ice::ObjectNotExistException&)
+        {
+        }
+
+        proxies[0]->deactivateObjectAdapter("oa");
+        com->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "shutting down... " << flush;
     for(vector<ControllerPrx>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
     {
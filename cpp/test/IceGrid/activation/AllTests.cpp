@@ -683,7 +683,145 @@ allTests(const Ice::CommunicatorPtr& communicator)
     }
     cout << "ok" << endl;
 
-    admin->stopServer("node-1");
+    cout << "testing concurrent activations... " << flush;
+    {
+        IceGrid::ApplicationInfo info = admin->getApplicationInfo("Test");
+        IceGrid::ApplicationDescriptor testApp;
+        testApp.name = "TestApp";
+        testApp.serverTemplates = info.descriptor.serverTemplates;
+        testApp.variables = info.descriptor.variables;
+        const int nServers = 20;
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "server-" << i;
+            IceGrid::ServerInstanceDescriptor server;
+            server._cpp_template = "Server";
+            server.parameterValues["id"] = id.str();
+            testApp.nodes["localnode"].serverInstances.push_back(server);
+        }
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "invalid-" << i;
+            IceGrid::ServerInstanceDescriptor server;
+            server._cpp_template = "InvalidServer";
+            server.parameterValues["id"] = id.str();
+            testApp.nodes["localnode"].serverInstances.push_back(server);
+        }
+        try
+        {
+            admin->addApplication(testApp);
+        }
+        catch(const IceGrid::DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        //
+        // Start the valid and invalid servers concurrently, the
+        // failed activations must not prevent the other servers
+        // from being activated.
+        //
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "server-" << i;
+            results.push_back(admin->begin_startServer(id.str()));
+            ostringstream invalid;
+            invalid << "invalid-" << i;
+            results.push_back(admin->begin_startServer(invalid.str()));
+        }
+        for(vector<Ice::AsyncResultPtr>::size_type i = 0; i < results.size(); ++i)
+        {
+            try
+            {
+                admin->end_startServer(results[i]);
+                test(i % 2 == 0);
+            }
+            catch(const IceGrid::ServerStartException& ex)
+            {
+                test(i % 2 == 1);
+                test(!ex.reason.empty());
+            }
+        }
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "server-" << i;
+            test(admin->getServerState(id.str()) == IceGrid::Active);
+            communicator->stringToProxy(id.str())->ice_ping();
+            admin->stopServer(id.str());
+        }
+        admin->removeApplication("TestApp");
+    }
+    cout << "ok" << endl;
+
+    cout << "testing node shutdown with failed activations... " << flush;
+    {
+        IceGrid::ApplicationInfo info = admin->getApplicationInfo("Test");
+        IceGrid::ApplicationDescriptor testApp;
+        testApp.name = "TestApp";
+        testApp.serverTemplates = info.descriptor.serverTemplates;
+        testApp.variables = info.descriptor.variables;
+        const int nServers = 20;
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "invalid-" << i;
+            IceGrid::ServerInstanceDescriptor server;
+            server._cpp_template = "InvalidServer";
+            server.parameterValues["id"] = id.str();
+            testApp.nodes["node-1"].serverInstances.push_back(server);
+        }
+        try
+        {
+            admin->addApplication(testApp);
+        }
+        catch(const IceGrid::DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        //
+        // Shutdown the node while the failing activations are in
+        // progress, the node must shutdown promptly rather than
+        // wait for its deactivation timeout.
+        //
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < nServers; ++i)
+        {
+            ostringstream id;
+            id << "invalid-" << i;
+            results.push_back(admin->begin_startServer(id.str()));
+        }
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        admin->stopServer("node-1");
+        test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(30));
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            try
+            {
+                admin->end_startServer(*p);
+                test(false);
+            }
+            catch(const IceGrid::ServerStartException&)
+            {
+            }
+            catch(const IceGrid::NodeUnreachableException&)
+            {
+            }
+            catch(const IceGrid::DeploymentException&)
+            {
+            }
+        }
+        admin->removeApplication("TestApp");
+    }
+    cout << "ok" << endl;
+
     admin->stopServer("node-2");
 
     session->destroy();
@@ -10,15 +10,52 @@
 #include <IceUtil/Thread.h>
 #include <Ice/Ice.h>
 #include <IceGrid/IceGrid.h>
+#include <IcePatch2/FileServer.h>
 #include <TestCommon.h>
 #include <Test.h>
 
 #include <iterator>
+#include <fstream>
+#include <cstdio>
 
 using namespace std;
 using namespace Test;
 using namespace IceGrid;
 
+namespace
+{
+
+Ice::ByteSeq
+readFile(const string& path)
+{
+    ifstream is(path.c_str(), ios::in | ios::binary);
+    test(is);
+    return Ice::ByteSeq(istreambuf_iterator<char>(is), istreambuf_iterator<char>());
+}
+
+void
+replaceFile(const string& path, const Ice::ByteSeq& data)
+{
+#ifdef _WIN32
+    //
+    // An open file can't be replaced on Windows, rewrite it instead.
+    //
+    const string tmp = path;
+#else
+    const string tmp = path + ".tmp";
+#endif
+    {
+        ofstream os(tmp.c_str(), ios::out | ios::binary | ios::trunc);
+        test(os);
+        os.write(reinterpret_cast<const char*>(&data[0]), data.size());
+    }
+#ifndef _WIN32
+    test(::rename(tmp.c_str(), path.c_str()) == 0);
+#endif
+}
+
+}
+
 void 
 allTests(const Ice::CommunicatorPtr& communicator)
 {
@@ -328,5 +365,39 @@ allTests(const Ice::CommunicatorPtr& communicator)
     }
     cout << "ok" << endl;
 
+    cout << "testing replacement of a file served by IcePatch2... " << flush;
+    {
+        admin->startServer("IcePatch2-Direct");
+
+        IcePatch2::FileServerPrx server = IcePatch2::FileServerPrx::checkedCast(
+            communicator->stringToProxy("IcePatch2-Direct/server:default -p 12001"));
+        test(server);
+
+        const string path = "data/original/rootfile.bz2";
+        const Ice::ByteSeq original = readFile(path);
+        const Ice::ByteSeq updated = readFile("data/updated/rootfile.bz2");
+        test(original != updated);
+
+        //
+        // The first request opens and caches the file.
+        //
+        test(server->getLargeFileCompressed("rootfile", 0, 1024 * 1024) == original);
+
+        //
+        // The server checks the cached files at most once per second,
+        // the replaced file must be served once this delay elapsed.
+        //
+        replaceFile(path, updated);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(2));
+        test(server->getLargeFileCompressed("rootfile", 0, 1024 * 1024) == updated);
+
+        replaceFile(path, original);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(2));
+        test(server->getLargeFileCompressed("rootfile", 0, 1024 * 1024) == original);
+
+        admin->stopServer("IcePatch2-Direct");
+    }
+    cout << "ok" << endl;
+
     session->destroy();
 }
@@ -20,11 +20,17 @@ if len(path) == 0:
 sys.path.append(os.path.join(path[0], "scripts"))
 import TestUtil, IceGridAdmin
 
-def icepatch2Calc(datadir, dirname):
+def icepatch2Calc(datadir, dirname, args = ""):
     icePatch2Calc = os.path.join(TestUtil.getCppBinDir(), "icepatch2calc")
-    commandProc = TestUtil.spawn('"%s" "%s"' % (icePatch2Calc, os.path.join(datadir, dirname)))
+    commandProc = TestUtil.spawn('"%s" %s "%s"' % (icePatch2Calc, args, os.path.join(datadir, dirname)))
     commandProc.waitTestSuccess()
 
+def readSum(datadir, dirname):
+    f = open(os.path.join(datadir, dirname, "IcePatch2.sum"), 'rb')
+    data = f.read()
+    f.close()
+    return data
+
 datadir = os.path.join(os.getcwd(), "data")
  
 files = [ 
@@ -58,6 +64,24 @@ icepatch2Calc(datadir, "original")
 icepatch2Calc(datadir, "updated")
 print("ok")
 
+sys.stdout.write("testing parallel and incremental icepatch2calc... ")
+sys.stdout.flush()
+for dirname in ["original", "updated"]:
+    expected = readSum(datadir, dirname)
+
+    icepatch2Calc(datadir, dirname, "-t 4")
+    if readSum(datadir, dirname) != expected:
+        print("failed!")
+        print("IcePatch2.sum computed with 4 threads differs for `%s'" % dirname)
+        sys.exit(1)
+
+    icepatch2Calc(datadir, dirname, "-r")
+    if readSum(datadir, dirname) != expected:
+        print("failed!")
+        print("IcePatch2.sum computed with reused checksums differs for `%s'" % dirname)
+        sys.exit(1)
+print("ok")
+
 IceGridAdmin.iceGridTest("application.xml")
 
 IceGridAdmin.cleanDbDir(datadir)
@@ -19,6 +19,34 @@ using namespace std;
 using namespace Test;
 using namespace IceGrid;
 
+#ifdef __linux
+//
+// Keep a processor busy for the given time to make sure the run queue
+// of the node isn't empty while the node samples its load.
+//
+class BusyThread : public IceUtil::Thread
+{
+public:
+
+    BusyThread(const IceUtil::Time& duration) :
+        _deadline(IceUtil::Time::now(IceUtil::Time::Monotonic) + duration)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        while(IceUtil::Time::now(IceUtil::Time::Monotonic) < _deadline)
+        {
+        }
+    }
+
+private:
+
+    const IceUtil::Time _deadline;
+};
+#endif
+
 void
 instantiateServer(const AdminPrx& admin, const string& templ, const string& node, const map<string, string>& params,
                   const string& application = string("Test"))
@@ -480,6 +508,57 @@ allTests(const Ice::CommunicatorPtr& comm)
     }
     cout << "ok" << endl;
 
+#ifdef __linux
+    cout << "testing load updates from the node... " << flush;
+    {
+        map<string, string> params;
+        params["replicaGroup"] = "LoadChanged";
+        params["id"] = "Server1";
+        instantiateServer(admin, "Server", "localnode", params);
+
+        //
+        // The replica group filter only returns the replica if the
+        // node load known by the registry changed since the previous
+        // resolution. The node samples its load every 100ms and pushes
+        // any change, the load must change between most resolutions
+        // even though the node session keep alive period is several
+        // seconds.
+        //
+        TestIntfPrx obj = TestIntfPrx::uncheckedCast(comm->stringToProxy("LoadChanged"));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_locatorCacheTimeout(0));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+        obj->getReplicaId();
+
+        vector<IceUtil::ThreadControl> threads;
+        for(int i = 0; i < 2; ++i)
+        {
+            threads.push_back((new BusyThread(IceUtil::Time::seconds(4)))->start());
+        }
+
+        int changes = 0;
+        for(int i = 0; i < 10; ++i)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(300));
+            try
+            {
+                test(obj->getReplicaId() == "Server1.ReplicatedAdapter");
+                ++changes;
+            }
+            catch(const Ice::NoEndpointException&)
+            {
+            }
+        }
+        test(changes >= 5);
+
+        for(vector<IceUtil::ThreadControl>::iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            p->join();
+        }
+        removeServer(admin, "Server1");
+    }
+    cout << "ok" << endl;
+#endif
+
     cout << "testing filters... " << flush;
     {
         map<string, string> params;
@@ -149,6 +149,44 @@ private:
     const string _exclude;
 };
 
+//
+// Only return the adapters if the load of their node, as known by the
+// registry, changed since the previous call. This allows the client to
+// check that the node pushes its load changes to the registry.
+//
+class LoadChangedReplicaGroupFilterI : public IceGrid::ReplicaGroupFilter, public IceUtil::Mutex
+{
+public:
+
+    LoadChangedReplicaGroupFilterI(const RegistryPluginFacadePtr& facade) : _facade(facade), _load(-1.0f)
+    {
+    }
+
+    virtual Ice::StringSeq
+    filter(const string&, const Ice::StringSeq& adapters, const Ice::ConnectionPtr&, const Ice::Context&)
+    {
+        if(adapters.empty())
+        {
+            return adapters;
+        }
+
+        float load = _facade->getNodeLoad(_facade->getAdapterNode(adapters[0])).avg1;
+
+        IceUtil::Mutex::Lock sync(*this);
+        if(load == _load)
+        {
+            return Ice::StringSeq();
+        }
+        _load = load;
+        return adapters;
+    }
+
+private:
+
+    const RegistryPluginFacadePtr _facade;
+    float _load;
+};
+
 }
 
 //
@@ -182,6 +220,8 @@ RegistryPluginI::initialize()
     facade->addReplicaGroupFilter("excludeServer", new ExcludeReplicaGroupFilterI(facade, "Server2"));
     facade->addReplicaGroupFilter("excludeServer", new ExcludeReplicaGroupFilterI(facade, "Server3"));
 
+    facade->addReplicaGroupFilter("loadChanged", new LoadChangedReplicaGroupFilterI(facade));
+
     facade->addTypeFilter("::Test::TestIntf2", new TypeFilterI(facade));
 }
 
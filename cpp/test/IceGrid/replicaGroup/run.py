@@ -30,4 +30,12 @@ IceGridAdmin.nreplicas=0
 
 IceGridAdmin.registryOptions += " --Ice.Plugin.RegistryPlugin=RegistryPlugin:createRegistryPlugin"
 
+#
+# Sample the node load every 100ms and push any load change to the
+# registry. The node only computes its load averages on Linux, other
+# platforms don't run the load sampling test.
+#
+if TestUtil.isLinux():
+    IceGridAdmin.nodeOptions += " --IceGrid.Node.LoadSampleInterval=100 --IceGrid.Node.LoadUpdateThreshold=0"
+
 IceGridAdmin.iceGridTest("application.xml", "--Ice.RetryIntervals=\"0 50 100 250\"", "icebox.exe='%s'" % TestUtil.getIceBox())
@@ -15,6 +15,8 @@
 #include <TestCommon.h>
 #include <Test.h>
 
+#include <fstream>
+
 using namespace std;
 using namespace Test;
 using namespace IceGrid;
@@ -247,6 +249,26 @@ createAdminSession(const Ice::LocatorPrx& locator, const string& replica)
 
 }
 
+int
+countFullSyncs(const string& logFile)
+{
+    //
+    // Count the whole databases received from the master, traced by
+    // the replica with IceGrid.Registry.Trace.Replica > 1.
+    //
+    ifstream is(logFile.c_str());
+    int count = 0;
+    string line;
+    while(getline(is, line))
+    {
+        if(line.find("received the whole") != string::npos)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
 void
 allTests(const Ice::CommunicatorPtr& comm)
 {
@@ -266,6 +288,7 @@ allTests(const Ice::CommunicatorPtr& comm)
     params["id"] = "Master";
     params["replicaName"] = "";
     params["port"] = "12050";
+    params["updateLogSize"] = "5";
     instantiateServer(admin, "IceGridRegistry", params);
     
     params.clear();
@@ -278,8 +301,12 @@ allTests(const Ice::CommunicatorPtr& comm)
     params["id"] = "Slave2";
     params["replicaName"] = "Slave2";
     params["port"] = "12052";
+    params["logFile"] = "${test.dir}/Slave2.log";
+    params["traceReplica"] = "2";
     instantiateServer(admin, "IceGridRegistry", params);
 
+    const string slave2Log = comm->getProperties()->getProperty("TestDir") + "/Slave2.log";
+
     Ice::LocatorPrx masterLocator = 
         Ice::LocatorPrx::uncheckedCast(comm->stringToProxy("RepTestIceGrid/Locator-Master:default -p 12050"));
     Ice::LocatorPrx slave1Locator = 
@@ -776,6 +803,130 @@ allTests(const Ice::CommunicatorPtr& comm)
     }
     cout << "ok" << endl;
 
+    //
+    // Incremental synchronization test:
+    //
+    // - the master keeps the last 5 updates of each database
+    // - shutdown slave2, make a few updates and restart slave2: the
+    //   master only replays the updates missed by slave2
+    // - shutdown slave2, make more updates than the master keeps and
+    //   restart slave2: the master sends the whole databases
+    //
+    cout << "testing incremental replica synchronization... " << flush;
+    {
+        ApplicationDescriptor app;
+        app.name = "TestApp";
+        app.description = "added application";
+
+        AdapterInfo adpt;
+        adpt.id = "TestAdpt";
+        adpt.proxy = comm->stringToProxy("dummy:tcp -p 12345 -h 127.0.0.1");
+
+        ObjectInfo obj;
+        obj.proxy = comm->stringToProxy("dummy:tcp -p 12345 -h 127.0.0.1");
+        obj.type = "::Hello";
+
+        Ice::LocatorRegistryPrx locatorRegistry = masterLocator->getRegistry();
+
+        //
+        // Updates missed by slave2 are still in the master log.
+        //
+        masterAdmin->addApplication(app);
+        locatorRegistry->setAdapterDirectProxy(adpt.id, adpt.proxy);
+        masterAdmin->addObjectWithType(obj.proxy, obj.type);
+
+        admin->startServer("Slave2");
+        slave2Admin = createAdminSession(slave2Locator, "Slave2");
+
+        test(slave2Admin->getApplicationInfo("TestApp").descriptor.description == "added application");
+        test(slave2Admin->getApplicationInfo("TestApp").revision ==
+             masterAdmin->getApplicationInfo("TestApp").revision);
+        test(slave2Admin->getAdapterInfo("TestAdpt")[0] == adpt);
+        test(slave2Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
+
+        slave2Admin->shutdown();
+        waitForServerState(admin, "Slave2", false);
+
+        app.description = "updated1 application";
+        masterAdmin->syncApplication(app);
+        masterAdmin->removeAdapter("TestAdpt");
+        obj.proxy = comm->stringToProxy("dummy:tcp -p 12346 -h 127.0.0.1");
+        masterAdmin->updateObject(obj.proxy);
+
+        int fullSyncs = countFullSyncs(slave2Log);
+        admin->startServer("Slave2");
+        slave2Admin = createAdminSession(slave2Locator, "Slave2");
+
+        //
+        // Slave2 only received the missed updates.
+        //
+        test(countFullSyncs(slave2Log) == fullSyncs);
+        test(slave2Admin->getApplicationInfo("TestApp").descriptor.description == "updated1 application");
+        test(slave2Admin->getApplicationInfo("TestApp").revision ==
+             masterAdmin->getApplicationInfo("TestApp").revision);
+        try
+        {
+            slave2Admin->getAdapterInfo("TestAdpt");
+            test(false);
+        }
+        catch(const AdapterNotExistException&)
+        {
+        }
+        test(slave2Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
+
+        slave2Admin->shutdown();
+        waitForServerState(admin, "Slave2", false);
+
+        //
+        // Updates missed by slave2 are no longer all in the master
+        // log, slave2 gets the whole databases.
+        //
+        for(int i = 0; i < 10; ++i)
+        {
+            ostringstream os;
+            os << "updated" << i + 2;
+            app.description = os.str() + " application";
+            masterAdmin->syncApplication(app);
+
+            adpt.proxy = comm->stringToProxy(os.str() + ":tcp -p 12345 -h 127.0.0.1");
+            locatorRegistry->setAdapterDirectProxy(adpt.id, adpt.proxy);
+
+            obj.type = "::Hello" + os.str();
+            masterAdmin->removeObject(obj.proxy->ice_getIdentity());
+            masterAdmin->addObjectWithType(obj.proxy, obj.type);
+        }
+
+        fullSyncs = countFullSyncs(slave2Log);
+        admin->startServer("Slave2");
+        slave2Admin = createAdminSession(slave2Locator, "Slave2");
+
+        //
+        // Slave2 received the whole application, adapter and object
+        // databases.
+        //
+        test(countFullSyncs(slave2Log) == fullSyncs + 3);
+        test(slave2Admin->getApplicationInfo("TestApp").descriptor.description == "updated11 application");
+        test(slave2Admin->getApplicationInfo("TestApp").revision ==
+             masterAdmin->getApplicationInfo("TestApp").revision);
+        test(slave2Admin->getAdapterInfo("TestAdpt")[0] == adpt);
+        test(slave2Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
+
+        //
+        // Slave1 stayed up and must have received all the updates.
+        //
+        test(slave1Admin->getApplicationInfo("TestApp").descriptor.description == "updated11 application");
+        test(slave1Admin->getAdapterInfo("TestAdpt")[0] == adpt);
+        test(slave1Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
+
+        masterAdmin->removeApplication("TestApp");
+        masterAdmin->removeAdapter("TestAdpt");
+        masterAdmin->removeObject(obj.proxy->ice_getIdentity());
+
+        slave2Admin->shutdown();
+        waitForServerState(admin, "Slave2", false);
+    }
+    cout << "ok" << endl;
+
     params.clear();
     params["id"] = "Node1";
     instantiateServer(admin, "IceGridNode", params);
@@ -25,5 +25,12 @@ TestUtil.addLdPath(os.getcwd())
 variables = ("properties-override='%s' icegridnode.exe='%s' icegridregistry.exe='%s'" % 
 			 (IceGridAdmin.iceGridNodePropertiesOverride(), TestUtil.getIceGridNode(), TestUtil.getIceGridRegistry()))
 
+slave2Log = os.path.join(os.getcwd(), "Slave2.log")
+if os.path.exists(slave2Log):
+    os.remove(slave2Log)
+
 IceGridAdmin.iceGridTest("application.xml", '--IceDir="%s" --TestDir="%s"' % (TestUtil.toplevel, os.getcwd()),
                          variables)
+
+if os.path.exists(slave2Log):
+    os.remove(slave2Log)
@@ -56,7 +56,9 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
     SinglePrx single = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
     for(int i = 0; i < 1000; ++i)
     {
-        single->event(i);
+        Ice::Context ctx;
+        ctx["parity"] = i % 2 == 0 ? "even" : "odd";
+        single->event(i, ctx);
     }
 
     return EXIT_SUCCESS;
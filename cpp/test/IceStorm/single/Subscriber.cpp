@@ -25,6 +25,7 @@ public:
     SingleI(const CommunicatorPtr& communicator, const string& name) :
         _communicator(communicator),
         _name(name),
+        _expected(name == "filtered" ? 500 : 1000),
         _count(0),
         _last(0)
     {
@@ -53,9 +54,18 @@ public:
             cerr << endl << "expected datagram to be received over udp";
             test(false);
         }
+        if(_name == "filtered")
+        {
+            Ice::Context::const_iterator p = current.ctx.find("parity");
+            if(i % 2 != 0 || p == current.ctx.end() || p->second != "even")
+            {
+                cerr << endl << "received filtered out event: " << i;
+                test(false);
+            }
+        }
         Lock sync(*this);
         ++_last;
-        if(++_count == 1000)
+        if(++_count == _expected)
         {
             notify();
         }
@@ -68,7 +78,7 @@ public:
         cout << "testing " << _name << " reliability... " << flush;
         bool datagram = _name == "datagram" || _name == "batch datagram";
         IceUtil::Time timeout = (datagram) ? IceUtil::Time::seconds(5) : IceUtil::Time::seconds(20);
-        while(_count < 1000)
+        while(_count < _expected)
         {
             if(!timedWait(timeout))
             {
@@ -97,6 +107,7 @@ private:
 
     CommunicatorPtr _communicator;
     const string _name;
+    const int _expected;
     int _count;
     int _last;
 };
@@ -173,6 +184,15 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
         subscriberIdentities.push_back(object->ice_getIdentity());
         topic->subscribeAndGetPublisher(qos, object);
     }
+    {
+        subscribers.push_back(new SingleI(communicator, "filtered"));
+        IceStorm::QoS qos;
+        qos["filter.operations"] = "event";
+        qos["filter.context.parity"] = "even";
+        Ice::ObjectPrx object = adapter->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+    }
     {
         // Use a separate adapter to ensure a separate connection is used for the subscriber
         // (otherwise, if multiple UDP subscribers use the same connection we might get high
@@ -124,6 +124,50 @@ public:
     }
 };
 
+//
+// A slow subscriber whose queue is bounded in IceStorm. Older events
+// are dropped so it can't receive all the events, but it must
+// receive the last one.
+//
+class BoundedEventI : public EventI
+{
+public:
+
+    BoundedEventI(const CommunicatorPtr& communicator, int total) :
+        EventI(communicator, total), _last(-1)
+    {
+    }
+
+    virtual void
+    pub(int counter, const Ice::Current&)
+    {
+        Lock sync(*this);
+
+        if(_last == _total - 1)
+        {
+            return;
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        ++_count;
+        _last = counter;
+        if(_last == _total - 1)
+        {
+            _communicator->shutdown();
+        }
+    }
+
+    int last() const
+    {
+        Lock sync(*this);
+        return _last;
+    }
+
+private:
+
+    int _last;
+};
+typedef IceUtil::Handle<BoundedEventI> BoundedEventIPtr;
+
 class ErraticEventI : public EventI
 {
 public:
@@ -209,6 +253,7 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
     opts.addOpt("", "events", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "qos", IceUtilInternal::Options::NeedArg, "", IceUtilInternal::Options::Repeat);
     opts.addOpt("", "slow");
+    opts.addOpt("", "bounded");
     opts.addOpt("", "erratic", IceUtilInternal::Options::NeedArg);
 
     try
@@ -248,6 +293,7 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
     }
 
     bool slow = opts.isSet("slow");
+    bool bounded = opts.isSet("bounded");
     bool erratic = false;
     int erraticNum = 0;
     s = opts.optArg("erratic");
@@ -294,6 +340,14 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
             subs.push_back(item);
         }
     }
+    else if(bounded)
+    {
+        Subscription item;
+        item.adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+        item.servant = new BoundedEventI(communicator, events);
+        item.qos = cmdLineQos;
+        subs.push_back(item);
+    }
     else if(slow)
     {
         Subscription item;
@@ -335,7 +389,12 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
         {
             p->obj = p->adapter->addWithUUID(p->servant);
 
-            IceStorm::QoS qos;
+            //
+            // Pass on the QoS other than the reliability, which is
+            // handled below.
+            //
+            IceStorm::QoS qos = p->qos;
+            qos.erase("reliability");
             string reliability = "";
             IceStorm::QoS::const_iterator q = p->qos.find("reliability");
             if(q != p->qos.end())
@@ -375,7 +434,21 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
         for(vector<Subscription>::const_iterator p = subs.begin(); p != subs.end(); ++p)
         {
             topic->unsubscribe(p->obj);
-            if(p->servant->count() != events)
+            BoundedEventIPtr bounded = BoundedEventIPtr::dynamicCast(p->servant);
+            if(bounded)
+            {
+                if(bounded->last() != events - 1)
+                {
+                    cerr << "expected last event " << events - 1 << " but got " << bounded->last() << endl;
+                    return EXIT_FAILURE;
+                }
+                if(bounded->count() >= events)
+                {
+                    cerr << "expected some of the " << events << " events to be dropped" << endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            else if(p->servant->count() != events)
             {
                 cerr << "expected " << events << " events but got " << p->servant->count() << " events." << endl;
                 return EXIT_FAILURE;
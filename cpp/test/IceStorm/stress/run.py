@@ -119,6 +119,12 @@ def runtest(type):
     doTest(server1, server2, ['--events 2 --slow ' + server1.reference(), '--events 20000 ' + server1.reference()], '--events 20000 --oneway')
     print("ok")
 
+    sys.stdout.write("Sending 20000 unordered events with bounded slow subscriber... ")
+    sys.stdout.flush()
+    doTest(server1, server2, ['--events 20000 --bounded --qos "maxQueuedEvents,100" ' + server1.reference(),
+                              '--events 20000 ' + server1.reference()], '--events 20000 --oneway')
+    print("ok")
+
     runAdmin("link TestIceStorm1/fed1 TestIceStorm2/fed1")
     sys.stdout.write("Sending 20000 unordered events with slow subscriber & link... ")
     sys.stdout.flush()
@@ -8,7 +8,7 @@
 #
 # **********************************************************************
 
-import os, sys, re
+import os, sys, re, time
 
 path = [ ".", "..", "../..", "../../..", "../../../.." ]
 head = os.path.dirname(sys.argv[0])
@@ -57,6 +57,7 @@ def runTest(cmd):
 sys.stdout.write("compiling slice files and checking headers... ")
 sys.stdout.flush()
 runTest("%s -Iiceslices -Islices slices/dir2/b.ice" % (slice2cpp))
+runTest("%s -j 2 --update -Iiceslices -Islices slices/dir2/b.ice" % (slice2cpp))
 runTest("%s -Iiceslices -I../headers/slices slices/dir2/b.ice" % (slice2cpp))
 runTest("%s -Iiceslices -Ilinktoslices slices/dir2/b.ice" % (slice2cpp))
 runTest("%s -Iiceslices -Ilinktoslices/../linktoslices slices/dir2/b.ice" % (slice2cpp))
@@ -131,3 +132,84 @@ if not re.search(re.escape('#include <Ice/Identity.h>'), f.read()):
 
 print("ok")
 clean()
+
+sys.stdout.write("testing parallel and incremental code generation... ")
+sys.stdout.flush()
+
+#
+# Generate several Slice files in parallel, A1.ice includes A0.ice.
+#
+os.system("mkdir -p tmp/update")
+sources = {
+    "A0.ice": "module A0 { interface I { void op(); }; };\n",
+    "A1.ice": "#include <A0.ice>\nmodule A1 { interface I extends A0::I { }; };\n",
+    "A2.ice": "module A2 { interface I { void op(); }; };\n",
+    "A3.ice": "module A3 { interface I { void op(); }; };\n",
+}
+for name, contents in sources.items():
+    f = open(os.path.join("tmp", "update", name), "w")
+    f.write(contents)
+    f.close()
+
+def generate():
+    if os.system("cd tmp/update && %s -j 4 --update -I. --depend-manifest deps.mk A0.ice A1.ice A2.ice A3.ice" %
+                 slice2cpp) != 0:
+        print("failed!")
+        sys.exit(1)
+
+def checkManifest():
+    f = open(os.path.join("tmp", "update", "deps.mk"))
+    manifest = f.read()
+    f.close()
+    for name in ["A0", "A2", "A3"]:
+        if not re.search(r'^%s\.h:\s*\\\s*%s\.ice\s*$' % (name, name), manifest, re.M):
+            print("failed!")
+            sys.exit(1)
+    if not re.search(r'^A1\.h:\s*\\\s*A1\.ice\s*\\\s*A0\.ice\s*$', manifest, re.M):
+        print("failed!")
+        sys.exit(1)
+
+def getTimes():
+    times = {}
+    for name in ["A0", "A1", "A2", "A3"]:
+        for ext in [".h", ".cpp"]:
+            times[name + ext] = os.stat(os.path.join("tmp", "update", name + ext)).st_mtime
+    return times
+
+generate()
+checkManifest()
+times = getTimes()
+
+#
+# Wait to ensure a rewritten file gets a different modification time.
+#
+time.sleep(2)
+
+#
+# Only A2.ice changed, the files generated for the other Slice files
+# must not be rewritten.
+#
+f = open(os.path.join("tmp", "update", "A2.ice"), "w")
+f.write("module A2 { interface I { void op(); void op2(); }; };\n")
+f.close()
+
+generate()
+checkManifest()
+newTimes = getTimes()
+for name in times:
+    if name.startswith("A2."):
+        if newTimes[name] == times[name]:
+            print("failed!")
+            sys.exit(1)
+    elif newTimes[name] != times[name]:
+        print("failed!")
+        sys.exit(1)
+
+f = open(os.path.join("tmp", "update", "A2.h"))
+if not re.search("op2", f.read()):
+    print("failed!")
+    sys.exit(1)
+f.close()
+
+print("ok")
+clean()
@@ -118,6 +118,9 @@ namespace IceInternal
              new Property(@"^Ice\.Default\.Timeout$", false, null),
              new Property(@"^Ice\.EventLog\.Source$", false, null),
              new Property(@"^Ice\.FactoryAssemblies$", false, null),
+             new Property(@"^Ice\.HostResolver\.CacheTimeout$", false, null),
+             new Property(@"^Ice\.HostResolver\.NegativeCacheTimeout$", false, null),
+             new Property(@"^Ice\.HostResolver\.Size$", false, null),
              new Property(@"^Ice\.HTTPProxyHost$", false, null),
              new Property(@"^Ice\.HTTPProxyPort$", false, null),
              new Property(@"^Ice\.ImplicitContext$", false, null),
@@ -125,6 +128,10 @@ namespace IceInternal
              new Property(@"^Ice\.IPv4$", false, null),
              new Property(@"^Ice\.IPv6$", false, null),
              new Property(@"^Ice\.LogFile$", false, null),
+             new Property(@"^Ice\.LogFile\.Async$", false, null),
+             new Property(@"^Ice\.LogFile\.Overflow$", false, null),
+             new Property(@"^Ice\.LogFile\.QueueSize$", false, null),
+             new Property(@"^Ice\.LogFile\.SizeMax$", false, null),
              new Property(@"^Ice\.LogStdErr\.Convert$", false, null),
              new Property(@"^Ice\.MessageSizeMax$", false, null),
              new Property(@"^Ice\.Nohup$", false, null),
@@ -142,6 +149,7 @@ namespace IceInternal
              new Property(@"^Ice\.PrintProcessId$", false, null),
              new Property(@"^Ice\.PrintStackTraces$", false, null),
              new Property(@"^Ice\.ProgramName$", false, null),
+             new Property(@"^Ice\.ReadAheadSize$", false, null),
              new Property(@"^Ice\.RetryIntervals$", false, null),
              new Property(@"^Ice\.ServerIdleTime$", false, null),
              new Property(@"^Ice\.SOCKSProxyHost$", false, null),
@@ -324,6 +332,10 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Port$", false, null),
              new Property(@"^IceDiscovery\.Interface$", false, null),
              new Property(@"^IceDiscovery\.DomainId$", false, null),
+             new Property(@"^IceDiscovery\.BatchSize$", false, null),
+             new Property(@"^IceDiscovery\.NegativeCacheTimeout$", false, null),
+             new Property(@"^IceDiscovery\.AdaptiveRetry$", false, null),
+             new Property(@"^IceDiscovery\.AdaptiveRetryMultiplier$", false, null),
              null
         };
 
@@ -416,6 +428,7 @@ namespace IceInternal
 
         public static Property[] IceBoxProps =
         {
+             new Property(@"^IceBox\.DependsOn\.[^\s]+$", false, null),
              new Property(@"^IceBox\.InheritProperties$", false, null),
              new Property(@"^IceBox\.InstanceName$", true, null),
              new Property(@"^IceBox\.LoadOrder$", false, null),
@@ -431,6 +444,8 @@ namespace IceInternal
              new Property(@"^IceBox\.ServiceManager\.ThreadPool\.SizeMax$", true, null),
              new Property(@"^IceBox\.ServiceManager\.ThreadPool\.SizeWarn$", true, null),
              new Property(@"^IceBox\.ServiceManager\.ThreadPool\.StackSize$", true, null),
+             new Property(@"^IceBox\.ServiceThreads$", false, null),
+             new Property(@"^IceBox\.Trace\.ServiceManager$", false, null),
              new Property(@"^IceBox\.Trace\.ServiceObserver$", false, null),
              new Property(@"^IceBox\.UseSharedCommunicator\.[^\s]+$", false, null),
              null
@@ -588,6 +603,8 @@ namespace IceInternal
              new Property(@"^IceGrid\.Node\.CollocateRegistry$", false, null),
              new Property(@"^IceGrid\.Node\.Data$", false, null),
              new Property(@"^IceGrid\.Node\.DisableOnFailure$", false, null),
+             new Property(@"^IceGrid\.Node\.LoadSampleInterval$", false, null),
+             new Property(@"^IceGrid\.Node\.LoadUpdateThreshold$", false, null),
              new Property(@"^IceGrid\.Node\.Name$", false, null),
              new Property(@"^IceGrid\.Node\.Output$", false, null),
              new Property(@"^IceGrid\.Node\.ProcessorSocketCount$", false, null),
@@ -802,6 +819,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier$", false, null),
              new Property(@"^IceGrid\.Registry\.ReplicaName$", false, null),
              new Property(@"^IceGrid\.Registry\.ReplicaSessionTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.ReplicaUpdateLogSize$", false, null),
              new Property(@"^IceGrid\.Registry\.RequireNodeCertCN$", false, null),
              new Property(@"^IceGrid\.Registry\.RequireReplicaCertCN$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.ACM\.Timeout$", false, null),
@@ -953,6 +971,7 @@ namespace IceInternal
              new Property(@"^IcePatch2\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IcePatch2\.MessageSizeMax$", false, null),
              new Property(@"^IcePatch2\.Directory$", false, null),
+             new Property(@"^IcePatch2\.FileCacheSize$", false, null),
              new Property(@"^IcePatch2\.InstanceName$", false, null),
              null
         };
@@ -960,7 +979,9 @@ namespace IceInternal
         public static Property[] IcePatch2ClientProps =
         {
              new Property(@"^IcePatch2Client\.ChunkSize$", false, null),
+             new Property(@"^IcePatch2Client\.DecompressThreads$", false, null),
              new Property(@"^IcePatch2Client\.Directory$", false, null),
+             new Property(@"^IcePatch2Client\.MaxInFlight$", false, null),
              new Property(@"^IcePatch2Client\.Proxy$", false, null),
              new Property(@"^IcePatch2Client\.Remove$", false, null),
              new Property(@"^IcePatch2Client\.Thorough$", false, null),
@@ -1190,6 +1211,7 @@ namespace IceInternal
              new Property(@"^Freeze\.DbEnv\.[^\s]+\.OldLogsAutoDelete$", false, null),
              new Property(@"^Freeze\.DbEnv\.[^\s]+\.PeriodicCheckpointMinSize$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.BtreeMinKey$", false, null),
+             new Property(@"^Freeze\.Evictor\.[^\s]+\.BulkReadSize$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.Checksum$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.MaxTxSize$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.PageSize$", false, null),
@@ -1197,8 +1219,11 @@ namespace IceInternal
              new Property(@"^Freeze\.Evictor\.[^\s]+\.RollbackOnUserException$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.SavePeriod$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.SaveSizeTrigger$", false, null),
+             new Property(@"^Freeze\.Evictor\.[^\s]+\.SaveThreads$", false, null),
              new Property(@"^Freeze\.Evictor\.[^\s]+\.StreamTimeout$", false, null),
+             new Property(@"^Freeze\.Evictor\.[^\s]+\.StreamThreads$", false, null),
              new Property(@"^Freeze\.Map\.[^\s]+\.BtreeMinKey$", false, null),
+             new Property(@"^Freeze\.Map\.[^\s]+\.BulkReadSize$", false, null),
              new Property(@"^Freeze\.Map\.[^\s]+\.Checksum$", false, null),
              new Property(@"^Freeze\.Map\.[^\s]+\.PageSize$", false, null),
              new Property(@"^Freeze\.Trace\.DbEnv$", false, null),
@@ -203,6 +203,19 @@ namespace IceDiscovery
             }
         }
 
+        public override void findObjectsAndAdaptersById(string domainId, Ice.Identity[] ids, string[] adapterIds,
+                                                        IceDiscovery.LookupReplyPrx reply, Ice.Current c)
+        {
+            foreach(Ice.Identity id in ids)
+            {
+                findObjectById(domainId, id, reply, c);
+            }
+            foreach(string adapterId in adapterIds)
+            {
+                findAdapterById(domainId, adapterId, reply, c);
+            }
+        }
+
         internal void findObject(Ice.AMD_Locator_findObjectById cb, Ice.Identity id)
         {
             lock(this)
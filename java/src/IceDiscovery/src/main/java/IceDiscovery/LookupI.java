@@ -237,6 +237,21 @@ class LookupI extends _LookupDisp
         }
     }
 
+    @Override
+    public void
+    findObjectsAndAdaptersById(String domainId, Ice.Identity[] ids, String[] adapterIds,
+                               IceDiscovery.LookupReplyPrx reply, Ice.Current c)
+    {
+        for(Ice.Identity id : ids)
+        {
+            findObjectById(domainId, id, reply, c);
+        }
+        for(String adapterId : adapterIds)
+        {
+            findAdapterById(domainId, adapterId, reply, c);
+        }
+    }
+
     synchronized void
     findObject(Ice.AMD_Locator_findObjectById cb, Ice.Identity id)
     {